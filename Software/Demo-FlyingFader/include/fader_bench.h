@@ -0,0 +1,22 @@
+/* Fader Bench Header */
+#ifndef FADER_BENCH_H
+#define FADER_BENCH_H
+
+/* Includes */
+#include <Arduino.h>
+
+/* Constants */
+// -----------------------------
+// How many axes fit one control tick
+// -----------------------------
+constexpr uint16_t FADER_BENCH_ROUNDS     = 1000;   // Ticks timed per measurement
+constexpr uint8_t  FADER_BENCH_BUDGET_PCT = 50;     // Of the tick, the rest is for WiFi, serial, the app
+constexpr uint8_t  FADER_BENCH_CHANNEL    = 15;     // Spare LEDC channel, no pin attached
+constexpr uint8_t  FADER_ADC1_WIPERS      = 8;      // ADC1 channels 0..7 (GPIO 32..39)
+
+/* Public Function Definitions */
+// Before faderBegin(): times each stage of a tick for 1..FADER_MAX_AXES axes on
+// synthetic data and prints the per-axis cost and the axis count that fits the budget
+void faderBenchRun();
+
+#endif // FADER_BENCH_H
@@ -0,0 +1,105 @@
+/* Fader Control Header */
+#ifndef FADER_CONTROL_H
+#define FADER_CONTROL_H
+
+/* Includes */
+#include <Arduino.h>
+#include "fader_pid.h"
+#include "fader_sense.h"
+#include "fader_touch.h"
+
+/* Constants */
+// -----------------------------
+// Motor drive, axis a uses LEDC channels 2a (A) and 2a + 1 (B)
+// -----------------------------
+constexpr uint32_t FADER_PWM_FREQ       = 20000;  // Above hearing, period well inside a tick
+constexpr uint8_t  FADER_PWM_BITS       = 10;
+constexpr int16_t  FADER_DUTY_MAX       = (1 << FADER_PWM_BITS) - 1;
+constexpr uint8_t  FADER_SENSE_TIMEOUT  = 10;     // Ticks without samples: sensor lost, motor off
+
+// -----------------------------
+// Control task, woken by a hardware timer, runs every axis per tick
+// -----------------------------
+constexpr uint32_t FADER_LOOP_HZ        = 1000;
+constexpr uint8_t  FADER_TIMER          = 0;      // Hardware timer group 0, timer 0
+constexpr uint8_t  FADER_TASK_PRIORITY  = 10;
+constexpr uint8_t  FADER_TASK_CORE      = 1;
+constexpr uint16_t FADER_TASK_STACK     = 3072;
+
+// -----------------------------
+// Loop tuning (1 kHz, 10-bit duty)
+// -----------------------------
+constexpr fader_pid_cfg FADER_PID_DEFAULTS = {
+  220,                  // kp: +700 duty at 20 % of the travel
+  2,                    // ki
+  3277,                 // kd: 0.8 duty per count/tick
+  4096,                 // kv: 1 duty per count/tick of target motion
+  320,                  // minDuty, the old MIN_SPEED 80/255
+  FADER_DUTY_MAX,
+  96,                   // deadband floor 0.15 %, raised to 3x the measured position noise
+  256,                  // settleBand
+  20,                   // settleTicks, 20 ms
+  300,                  // stallTicks, 300 ms ...
+  200,                  // ... with less travel than this
+};
+
+/* Typedefs */
+typedef struct fader_axis_cfg {
+  uint8_t        pwmAPin;       // Drives toward 0
+  uint8_t        pwmBPin;       // Drives toward FADER_POS_MAX
+  adc1_channel_t adcChannel;    // Wiper
+  uint8_t        touchPin;      // Touch tab or FADER_NO_TOUCH
+} fader_axis_cfg;
+
+// -----------------------------
+// Axes on this board
+// -----------------------------
+constexpr fader_axis_cfg FADER_AXES[] = {
+  { 32, 33, ADC1_CHANNEL_0, 4 },   // Wiper GPIO 36, touch T0
+};
+constexpr uint8_t FADER_AXIS_COUNT = sizeof(FADER_AXES) / sizeof(FADER_AXES[0]);
+static_assert(FADER_AXIS_COUNT <= FADER_MAX_AXES, "Two LEDC channels per axis");
+
+typedef struct fader_status {
+  fader_state state;
+  int32_t pos;
+  uint32_t posUs;               // esp_timer time of the tick that read pos
+  int32_t target;
+  int16_t duty;
+  uint16_t noise;               // Single ADC sample RMS, position counts
+  uint16_t posNoise;            // RMS of pos after decimation
+  uint16_t deadband;            // In use, from the noise
+  uint32_t senseFaults;
+  fader_metrics metrics;        // Settle/overshoot in ticks and position counts
+  // Touch to release: a hand on the knob switches the motor off, the fader becomes an input
+  bool touchReady;
+  bool touched;
+  uint32_t touches;
+  uint32_t lastReleaseUs;       // Touch interrupt to drive off
+  uint32_t maxReleaseUs;
+  uint16_t touchRaw;
+  uint16_t touchBaseline;
+} fader_status;
+
+typedef struct fader_loop_stats {
+  uint8_t  axes;
+  uint32_t ticks;
+  uint32_t missedTicks;         // Timer fired again before the task got to run
+  uint32_t emptyTicks;          // No new ADC samples for any axis, last positions reused
+  uint32_t lastTickUs;          // Work per tick, every axis: ADC, touch, PID, LEDC
+  uint32_t maxTickUs;
+} fader_loop_stats;
+
+/* Public Function Definitions */
+bool faderBegin(const fader_axis_cfg* axes = FADER_AXES, uint8_t count = FADER_AXIS_COUNT,
+                const fader_pid_cfg* cfg = &FADER_PID_DEFAULTS);
+void faderSetTarget(uint8_t axis, int32_t pos);   // Any task, any time, applied on the next untouched tick
+void faderTrack(uint8_t axis, int32_t pos);
+void faderRelease(uint8_t axis);
+void faderStatus(uint8_t axis, fader_status* out);
+void faderLoopStats(fader_loop_stats* out);
+
+// Ticks to ms
+constexpr uint32_t faderTicksToMs(uint32_t ticks) { return ticks * 1000UL / FADER_LOOP_HZ; }
+
+#endif // FADER_CONTROL_H
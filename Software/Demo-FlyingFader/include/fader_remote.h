@@ -0,0 +1,52 @@
+/* Fader Remote Header */
+#ifndef FADER_REMOTE_H
+#define FADER_REMOTE_H
+
+/* Includes */
+#include <Arduino.h>
+#include "fader_link.h"
+
+/* Constants */
+// -----------------------------
+// ESP-NOW remote control surface. Runs beside the control task, never inside it.
+// -----------------------------
+constexpr uint8_t  FADER_REMOTE_PRIORITY = 5;     // Below the control task, above loop()
+constexpr uint8_t  FADER_REMOTE_CORE     = 0;     // With the WiFi stack
+constexpr uint16_t FADER_REMOTE_STACK    = 3072;
+constexpr uint8_t  FADER_REMOTE_BROADCAST[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+/* Typedefs */
+enum fader_remote_mode : uint8_t {
+  FADER_REMOTE_OFF,       // Local control only
+  FADER_REMOTE_SEND,      // Motor released, the fader is an input streaming its position
+  FADER_REMOTE_MIRROR,    // Motor follows a remote fader's stream
+};
+
+typedef struct fader_remote_stats {
+  uint8_t  mode;          // fader_remote_mode
+  // Send
+  uint32_t sent;
+  uint32_t changes;
+  uint32_t heartbeats;
+  uint32_t skipped;       // Polls with a new position that compression or the rate limit held back
+  uint32_t sendFails;
+  // Mirror
+  uint32_t received;
+  uint32_t stale;         // Duplicate or overtaken
+  bool     linkUp;
+  // Glass to glass: wiper sample here to output change there, from echoes
+  uint32_t echoes;
+  uint32_t lastG2gUs;
+  uint32_t minG2gUs;
+  uint32_t avgG2gUs;
+  uint32_t maxG2gUs;
+  uint32_t overTarget;    // Echoes above FADER_LINK_TARGET_US
+} fader_remote_stats;
+
+/* Public Function Definitions */
+// Starts WiFi (station, unconnected) and ESP-NOW, streams to peerMac
+bool faderRemoteBegin(const uint8_t* peerMac = FADER_REMOTE_BROADCAST);
+void faderRemoteMode(fader_remote_mode mode, uint8_t axis = 0);
+void faderRemoteStats(fader_remote_stats* out);
+
+#endif // FADER_REMOTE_H
@@ -0,0 +1,28 @@
+/* Fader Sense Header */
+#ifndef FADER_SENSE_H
+#define FADER_SENSE_H
+
+/* Includes */
+#include <Arduino.h>
+#include <driver/adc.h>
+#include "fader_filter.h"
+#include "fader_pid.h"
+
+/* Constants */
+// -----------------------------
+// Wiper sampling (I2S built-in ADC DMA, owns ADC1 and I2S0 while running).
+// ADC1 only: ADC2 has no DMA and is taken by the radio. Every wiper is in one
+// pattern table, the DMA stream interleaves them tagged with their channel.
+// -----------------------------
+constexpr uint32_t FADER_ADC_RATE_HZ    = 80000;   // Shared by all axes
+constexpr uint16_t FADER_DMA_LEN        = 80;      // One buffer per 1 kHz tick
+constexpr uint8_t  FADER_DMA_BUFFERS    = 4;
+constexpr uint8_t  FADER_LOWPASS_SHIFT  = 1;       // After decimation, alpha 0.5
+
+/* Public Function Definitions */
+bool faderSenseBegin(const adc1_channel_t* channels, uint8_t count);
+// Decimate every sample that arrived since the last call into out[axis],
+// returns a mask of the axes that got a new reading
+uint32_t faderSenseRead(fader_sample* out);
+
+#endif // FADER_SENSE_H
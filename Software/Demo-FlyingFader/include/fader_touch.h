@@ -0,0 +1,35 @@
+/* Fader Touch Header */
+#ifndef FADER_TOUCH_H
+#define FADER_TOUCH_H
+
+/* Includes */
+#include <Arduino.h>
+#include "touch_track.h"
+#include "fader_pid.h"
+
+/* Constants */
+// -----------------------------
+// Capacitive touch on the fader knobs (ESP32 touch peripheral)
+// -----------------------------
+constexpr uint8_t  FADER_NO_TOUCH         = 0xFF;    // Axis without a touch tab
+constexpr uint16_t TOUCH_MEASURE_CYCLES   = 0x800;   // 256 us at 8 MHz ...
+constexpr uint16_t TOUCH_SLEEP_CYCLES     = 0x30;    // ... plus 320 us at 150 kHz: ~0.6 ms per reading
+constexpr uint16_t TOUCH_THRESHOLD_EVERY  = 100;     // Ticks between threshold register updates
+
+constexpr touch_track_cfg TOUCH_DEFAULTS = {
+  8,                    // touchPct
+  5,                    // releasePct
+  10,                   // baselineShift, ~1 s at 1 kHz
+  20,                   // releaseSamples, 20 ms
+};
+
+/* Public Function Definitions */
+// Each pad's threshold interrupt wakes wakeTask at once, drift and release run from
+// faderTouchPoll(). Returns a mask of the axes with working touch.
+uint32_t faderTouchBegin(TaskHandle_t wakeTask, const uint8_t* pins, uint8_t count);
+// Once per control tick and axis. *edgeUs is the interrupt time when it fired since the last poll, else 0.
+bool faderTouchPoll(uint8_t axis, uint32_t* edgeUs);
+bool faderTouchPending(uint8_t axis);   // Interrupt fired, not yet polled
+const touch_track* faderTouchState(uint8_t axis);
+
+#endif // FADER_TOUCH_H
@@ -0,0 +1,83 @@
+/* Fader Filter Driver */
+
+/* Includes */
+#include "fader_filter.h"
+
+/* Private Function Definitions */
+static uint32_t isqrt32(uint32_t v) {
+  uint32_t res = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > v) bit >>= 2;
+  while (bit) {
+    if (v >= res + bit) {
+      v -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return res;
+}
+
+static inline void resetBlock(fader_filter* f) {
+  f->sum = 0;
+  f->sumSq = 0;
+  f->lo = 0x0FFF;
+  f->hi = 0;
+  f->count = 0;
+}
+
+/* Public Function Definitions */
+void faderFilterInit(fader_filter* f, uint8_t lowpassShift) {
+  *f = fader_filter();
+  f->lowpassShift = lowpassShift;
+  resetBlock(f);
+}
+
+// FUNCTION: Decimate the block to a single 16-bit reading. The mean without the
+// highest and lowest sample shrugs off single spikes, n samples add log4(n) bits.
+bool faderFilterFinish(fader_filter* f, fader_sample* out) {
+  if (f->count < 3) return false;
+
+  // 1. Trimmed mean, 12 -> 16 bits, stretched so full scale is FADER_POS_MAX
+  uint64_t n = f->count - 2;
+  uint32_t sum = f->sum - f->lo - f->hi;
+  uint64_t sumSq = f->sumSq - (uint64_t)f->lo * f->lo - (uint64_t)f->hi * f->hi;
+  uint32_t mean16 = (sum << 4) / (uint32_t)n;
+  out->raw = (int32_t)(mean16 + (mean16 >> 12));
+  out->samples = f->count;
+
+  // 2. Spread of the same samples (ADC LSB^2), in position counts (x16)
+  uint64_t var = (n > 1) ? (sumSq * n - (uint64_t)sum * sum) / (n * (n - 1)) : 0;
+  uint32_t noise = isqrt32((uint32_t)(var < 0xFFFFFFULL ? var * 256 : 0xFFFFFFFFULL));
+  f->noiseQ4 = f->primed ? f->noiseQ4 + noise - (f->noiseQ4 >> 4) : noise << 4;
+  out->noise = (uint16_t)(f->noiseQ4 >> 4);
+  out->posNoise = (uint16_t)(out->noise / isqrt32((uint32_t)n));
+
+  // 3. Light low-pass for the loop's derivative term
+  if (!f->primed) f->accQ = out->raw << f->lowpassShift;
+  else            f->accQ += out->raw - (f->accQ >> f->lowpassShift);
+  out->pos = f->accQ >> f->lowpassShift;
+  f->primed = true;
+  resetBlock(f);
+  return true;
+}
+
+bool faderFilterBlock(fader_filter* f, const uint16_t* samples, size_t count, fader_sample* out) {
+  for (size_t i = 0; i < count; ++i) faderFilterAdd(f, samples[i]);
+  return faderFilterFinish(f, out);
+}
+
+uint32_t faderFilterDemux(fader_filter* filters, uint8_t axes, const uint8_t* chanToAxis,
+                          const uint16_t* samples, size_t count, fader_sample* out) {
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t axis = chanToAxis[samples[i] >> 12];
+    if (axis < axes) faderFilterAdd(&filters[axis], samples[i]);
+  }
+  uint32_t fresh = 0;
+  for (uint8_t a = 0; a < axes; ++a) {
+    if (faderFilterFinish(&filters[a], &out[a])) fresh |= 1UL << a;
+  }
+  return fresh;
+}
@@ -0,0 +1,58 @@
+/* Fader Filter Header */
+#ifndef FADER_FILTER_H
+#define FADER_FILTER_H
+
+/* Includes */
+#include <stdint.h>
+#include <stddef.h>
+
+/* Constants */
+constexpr uint8_t FADER_FILTER_NO_AXIS = 0xFF;
+
+/* Typedefs */
+// One decimated reading, positions 0..FADER_POS_MAX (16-bit)
+typedef struct fader_sample {
+  int32_t  pos;             // Decimated, then low-passed
+  int32_t  raw;             // Decimated only
+  uint16_t noise;           // RMS of the single ADC samples in the block, position counts
+  uint16_t posNoise;        // Expected RMS of pos: noise / sqrt(samples)
+  uint16_t samples;
+} fader_sample;
+
+typedef struct fader_filter {
+  uint8_t  lowpassShift;    // One-pole low-pass, alpha = 1 / 2^shift (0: off)
+  bool     primed;
+  int32_t  accQ;            // pos << lowpassShift
+  uint32_t noiseQ4;         // Smoothed noise, << 4
+  // Samples since the last finish
+  uint32_t sum;
+  uint64_t sumSq;
+  uint16_t lo;
+  uint16_t hi;
+  uint16_t count;
+} fader_filter;
+
+/* Public Function Definitions */
+void faderFilterInit(fader_filter* f, uint8_t lowpassShift);
+
+// One 12-bit ADC sample (upper nibble ignored, I2S ADC puts the channel there)
+inline void faderFilterAdd(fader_filter* f, uint16_t sample) {
+  uint32_t v = sample & 0x0FFF;
+  f->sum += v;
+  f->sumSq += v * v;
+  if (v < f->lo) f->lo = (uint16_t)v;
+  if (v > f->hi) f->hi = (uint16_t)v;
+  f->count++;
+}
+
+// Decimate what was added since the last call. False for too few samples to trim,
+// those are kept for the next call.
+bool faderFilterFinish(fader_filter* f, fader_sample* out);
+bool faderFilterBlock(fader_filter* f, const uint16_t* samples, size_t count, fader_sample* out);
+
+// Interleaved I2S ADC block: route each sample by its channel nibble (chanToAxis,
+// 16 entries) and finish every axis. Returns a mask of the axes with a new reading.
+uint32_t faderFilterDemux(fader_filter* filters, uint8_t axes, const uint8_t* chanToAxis,
+                          const uint16_t* samples, size_t count, fader_sample* out);
+
+#endif // FADER_FILTER_H
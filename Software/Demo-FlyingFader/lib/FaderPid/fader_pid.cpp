@@ -0,0 +1,153 @@
+/* Fader PID Driver */
+
+/* Includes */
+#include "fader_pid.h"
+
+/* Private Function Definitions */
+static inline int32_t absI(int32_t v) {
+  return (v < 0) ? -v : v;
+}
+
+static inline int32_t clampI(int32_t v, int32_t lo, int32_t hi) {
+  return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+static void finishMove(fader_bank* b, uint8_t a) {
+  fader_metrics& m = b->metrics[a];
+  b->state[a] = FADER_HOLD;
+  m.settled++;
+  m.lastSettleTicks = b->moveTicks[a];
+  if (b->moveTicks[a] > m.maxSettleTicks) m.maxSettleTicks = b->moveTicks[a];
+  m.lastOvershoot = b->overshoot[a];
+  if (b->overshoot[a] > m.maxOvershoot) m.maxOvershoot = b->overshoot[a];
+}
+
+/* Public Function Definitions */
+void faderBankInit(fader_bank* b, const fader_pid_cfg* cfg, uint8_t axes, const int32_t* pos) {
+  *b = fader_bank();
+  b->cfg = *cfg;
+  b->axes = (axes > FADER_MAX_AXES) ? FADER_MAX_AXES : axes;
+  for (uint8_t a = 0; a < b->axes; ++a) {
+    b->state[a] = FADER_IDLE;
+    b->target[a] = b->prevTarget[a] = b->prevPos[a] = b->stallRef[a] = pos[a];
+  }
+}
+
+// FUNCTION: New target, starts a measured move (settle time, overshoot)
+void faderPidSetTarget(fader_bank* b, uint8_t a, int32_t target) {
+  target = clampI(target, 0, FADER_POS_MAX);
+  b->target[a] = b->prevTarget[a] = target;
+  b->integQ12[a] = 0;
+  b->state[a] = FADER_MOVING;
+  b->dir[a] = (target >= b->prevPos[a]) ? 1 : -1;
+  b->moveTicks[a] = 0;
+  b->inBandTicks[a] = 0;
+  b->overshoot[a] = 0;
+  b->stallRef[a] = b->prevPos[a];
+  b->stallCount[a] = 0;
+  b->metrics[a].moves++;
+}
+
+// FUNCTION: Follow a target that changes every few ticks. A stalled fader stays off
+// until the target moves stallMove away from where it stalled, a stream that keeps
+// pointing into the obstacle does not restart it.
+void faderPidTrack(fader_bank* b, uint8_t a, int32_t target) {
+  b->target[a] = clampI(target, 0, FADER_POS_MAX);
+  if (b->state[a] == FADER_STALLED && absI(b->target[a] - b->stallTarget[a]) > b->cfg.stallMove) {
+    b->integQ12[a] = 0;
+    b->stallRef[a] = b->prevPos[a];
+    b->stallCount[a] = 0;
+    b->state[a] = FADER_IDLE;
+  }
+  if (b->state[a] == FADER_IDLE) {
+    b->prevTarget[a] = b->target[a];
+    b->state[a] = FADER_HOLD;
+  }
+}
+
+// FUNCTION: Hunting inside the noise only heats the motor, keep the deadband above it
+void faderPidSetNoise(fader_bank* b, uint8_t a, uint16_t posNoise) {
+  uint32_t band = 3UL * posNoise;
+  b->noiseBand[a] = (band > 0xFFFF) ? 0xFFFF : (uint16_t)band;
+}
+
+uint16_t faderPidDeadband(const fader_bank* b, uint8_t a) {
+  return (b->noiseBand[a] > b->cfg.deadband) ? b->noiseBand[a] : b->cfg.deadband;
+}
+
+void faderPidRelease(fader_bank* b, uint8_t a) {
+  b->state[a] = FADER_IDLE;
+  b->integQ12[a] = 0;
+  b->duty[a] = 0;
+}
+
+// FUNCTION: One control tick of one axis at a fixed rate
+int16_t faderPidStep(fader_bank* b, uint8_t a, int32_t pos) {
+  const fader_pid_cfg& c = b->cfg;
+  int32_t vel = pos - b->prevPos[a];
+  int32_t targetVel = b->target[a] - b->prevTarget[a];
+  b->prevPos[a] = pos;
+  b->prevTarget[a] = b->target[a];
+
+  if (b->state[a] == FADER_IDLE || b->state[a] == FADER_STALLED) {
+    b->duty[a] = 0;
+    return 0;
+  }
+
+  int32_t err = b->target[a] - pos;
+  int32_t absErr = absI(err);
+
+  // 1. Move metrics, overshoot is how far past the target the slider got
+  if (b->state[a] == FADER_MOVING) {
+    b->moveTicks[a]++;
+    int32_t past = -err * b->dir[a];
+    if (past > b->overshoot[a]) b->overshoot[a] = past;
+    if (absErr > c.settleBand) b->inBandTicks[a] = 0;
+    else if (++b->inBandTicks[a] >= c.settleTicks) finishMove(b, a);
+  }
+
+  // 2. Inside the deadband the motor is off, friction holds the slider
+  if (absErr <= faderPidDeadband(b, a)) {
+    b->integQ12[a] = 0;
+    b->stallRef[a] = pos;
+    b->stallCount[a] = 0;
+    b->duty[a] = 0;
+    return 0;
+  }
+
+  // 3. PID, derivative on the measurement, plus setpoint velocity feed-forward
+  int32_t outQ12 = c.kpQ12 * err + b->integQ12[a] - c.kdQ12 * vel + c.kvQ12 * targetVel;
+  int32_t duty = outQ12 / 4096;
+
+  // Output deadband: any drive starts at the breakaway duty
+  if (duty > 0)      duty += c.minDuty;
+  else if (duty < 0) duty -= c.minDuty;
+  else               duty = (err > 0) ? c.minDuty : -c.minDuty;
+  bool saturated = absI(duty) > c.maxDuty;
+  duty = clampI(duty, -c.maxDuty, c.maxDuty);
+
+  // Anti-windup: integrate only while unsaturated, or when it pulls out of saturation
+  if (!saturated || ((err > 0) != (duty > 0))) {
+    int32_t integLimit = (int32_t)c.maxDuty << 12;
+    b->integQ12[a] = clampI(b->integQ12[a] + c.kiQ12 * err, -integLimit, integLimit);
+  }
+
+  // 4. Stall: driving but not getting anywhere, motor off until the next target
+  if (absI(pos - b->stallRef[a]) >= c.stallMove) {
+    b->stallRef[a] = pos;
+    b->stallCount[a] = 0;
+  } else if (++b->stallCount[a] >= c.stallTicks) {
+    b->state[a] = FADER_STALLED;
+    b->stallTarget[a] = b->target[a];
+    b->metrics[a].stalls++;
+    b->integQ12[a] = 0;
+    duty = 0;
+  }
+
+  b->duty[a] = (int16_t)duty;
+  return b->duty[a];
+}
+
+void faderBankStep(fader_bank* b, const int32_t* pos) {
+  for (uint8_t a = 0; a < b->axes; ++a) faderPidStep(b, a, pos[a]);
+}
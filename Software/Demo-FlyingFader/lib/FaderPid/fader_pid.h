@@ -0,0 +1,83 @@
+/* Fader PID Header */
+#ifndef FADER_PID_H
+#define FADER_PID_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// Position is a fraction of the travel, 0..FADER_POS_MAX, whatever the ADC resolution
+// -----------------------------
+constexpr int32_t FADER_POS_MAX = 65535;
+constexpr uint8_t FADER_MAX_AXES = 8;       // LEDC has 16 channels, two per motor
+
+/* Typedefs */
+// Gains in duty per position count, Q12. Duty is signed, >0 drives toward FADER_POS_MAX.
+typedef struct fader_pid_cfg {
+  int32_t  kpQ12;
+  int32_t  kiQ12;           // Per tick
+  int32_t  kdQ12;           // On measured velocity (counts per tick), no setpoint kick
+  int32_t  kvQ12;           // Feed-forward on setpoint velocity, for streamed targets
+  int16_t  minDuty;         // Stiction: smallest duty that moves the slider
+  int16_t  maxDuty;
+  uint16_t deadband;        // Motor off within this of the target (floor, see faderPidSetNoise)
+  uint16_t settleBand;      // Move counts as settled within this ...
+  uint16_t settleTicks;     // ... for this many ticks
+  uint16_t stallTicks;      // Driving this long ...
+  uint16_t stallMove;       // ... with less travel than this: stalled
+} fader_pid_cfg;
+
+enum fader_state : uint8_t {
+  FADER_IDLE,               // Released, motor off
+  FADER_MOVING,
+  FADER_HOLD,               // Settled at the target
+  FADER_STALLED,            // Motor off until the next target, or a tracked one stallMove away
+};
+
+typedef struct fader_metrics {
+  uint32_t moves;
+  uint32_t settled;
+  uint32_t stalls;
+  uint32_t lastSettleTicks;
+  uint32_t maxSettleTicks;
+  int32_t  lastOvershoot;   // Counts past the target, in the direction of travel
+  int32_t  maxOvershoot;
+} fader_metrics;
+
+// Struct of arrays, index = axis: the per-tick loop walks each field linearly
+typedef struct fader_bank {
+  fader_pid_cfg cfg;        // Shared by every axis
+  uint8_t  axes;
+  // Hot, every tick
+  int32_t  target[FADER_MAX_AXES];
+  int32_t  prevTarget[FADER_MAX_AXES];
+  int32_t  prevPos[FADER_MAX_AXES];
+  int32_t  integQ12[FADER_MAX_AXES];
+  int16_t  duty[FADER_MAX_AXES];
+  uint16_t noiseBand[FADER_MAX_AXES];       // Deadband demanded by the sensor noise
+  uint8_t  state[FADER_MAX_AXES];           // fader_state
+  // Current move
+  int8_t   dir[FADER_MAX_AXES];
+  uint32_t moveTicks[FADER_MAX_AXES];
+  uint16_t inBandTicks[FADER_MAX_AXES];
+  int32_t  overshoot[FADER_MAX_AXES];
+  // Stall watch
+  int32_t  stallRef[FADER_MAX_AXES];
+  uint16_t stallCount[FADER_MAX_AXES];
+  int32_t  stallTarget[FADER_MAX_AXES];     // Target it stalled on, tracking re-arms away from it
+  // Cold
+  fader_metrics metrics[FADER_MAX_AXES];
+} fader_bank;
+
+/* Public Function Definitions */
+void     faderBankInit(fader_bank* b, const fader_pid_cfg* cfg, uint8_t axes, const int32_t* pos);
+void     faderBankStep(fader_bank* b, const int32_t* pos);   // Every axis, one tick, into b->duty
+void     faderPidSetTarget(fader_bank* b, uint8_t axis, int32_t target);   // Step, measured as a move
+void     faderPidTrack(fader_bank* b, uint8_t axis, int32_t target);       // Streamed, feeds its velocity forward
+void     faderPidRelease(fader_bank* b, uint8_t axis);
+void     faderPidSetNoise(fader_bank* b, uint8_t axis, uint16_t posNoise); // Deadband >= 3 sigma of the position
+uint16_t faderPidDeadband(const fader_bank* b, uint8_t axis);
+int16_t  faderPidStep(fader_bank* b, uint8_t axis, int32_t pos);          // One axis, one tick
+
+#endif // FADER_PID_H
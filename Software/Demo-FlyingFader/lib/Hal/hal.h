@@ -0,0 +1,205 @@
+/* HAL Header */
+#ifndef HAL_H
+#define HAL_H
+
+/* Includes */
+#include <stdint.h>
+#include <stddef.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
+
+/* Constants */
+// -----------------------------
+// Thin layer over the ESP32 Arduino core. On the board the short calls are inline
+// wrappers, the rest lives in hal_esp32.cpp. Off target (env:native) hal_native.cpp
+// fakes everything on a virtual clock that only moves when told to.
+// Every demo carries a copy, keep them identical.
+// -----------------------------
+constexpr uint8_t  HAL_PINS             = 40;
+constexpr uint8_t  HAL_PWM_CHANNELS     = 16;
+constexpr uint32_t HAL_WAIT_FOREVER     = 0xFFFFFFFF;
+constexpr uint8_t  HAL_RADIO_MAX_LEN    = 250;      // ESP-NOW payload limit
+constexpr uint8_t  HAL_PRINTF_MAX       = 192;      // halPrintf() line on the stack, longer is cut
+
+// Native only: fakes and the setup()/loop() runner
+constexpr uint8_t  HAL_FAKE_TIMERS      = 16;
+constexpr uint8_t  HAL_FAKE_TASKS       = 64;      // A simulated line runs one remote task per station
+constexpr uint32_t HAL_NATIVE_RUN_MS    = 10000;    // Simulated run time unless given on the command line
+constexpr uint32_t HAL_NATIVE_LOOP_US   = 1000;     // Clock step for a loop() that did not wait
+
+/* Typedefs */
+typedef void (*hal_timer_fn)(void* arg);
+typedef void (*hal_task_fn)(void* arg);
+typedef void (*hal_radio_rx_fn)(const uint8_t* mac, const uint8_t* data, int len);
+
+#ifdef ARDUINO
+typedef portMUX_TYPE       hal_lock;
+#define HAL_LOCK_INIT      portMUX_INITIALIZER_UNLOCKED
+typedef esp_timer_handle_t hal_timer;
+typedef TaskHandle_t       hal_task;
+typedef StaticTask_t       hal_task_tcb;
+typedef struct hal_queue {
+  QueueHandle_t handle;
+  StaticQueue_t buf;
+} hal_queue;
+#else
+typedef struct hal_lock { uint8_t depth; } hal_lock;
+#define HAL_LOCK_INIT      { 0 }
+typedef struct hal_fake_timer* hal_timer;
+typedef struct hal_fake_task*  hal_task;
+typedef struct hal_task_tcb { uint8_t unused; } hal_task_tcb;
+typedef struct hal_queue {
+  uint8_t* storage;
+  uint16_t itemSize;
+  uint16_t depth;
+  uint16_t head;
+  uint16_t count;
+} hal_queue;
+
+// Where a sent frame goes: the simulated channel. Unset, frames are dropped.
+typedef void (*hal_fake_radio_fn)(const uint8_t* dst, const uint8_t* data, int len);
+#endif
+
+// Task memory, never from the heap: control block and stack both belong to the caller.
+// Static ones take HAL_TASK_MEM(stackArray), ones inside a struct halTaskMemInit().
+typedef struct hal_task_mem {
+  hal_task_tcb tcb;
+  uint8_t* stack;
+  uint32_t stackBytes;
+} hal_task_mem;
+#define HAL_TASK_MEM(stack) { {}, (stack), sizeof(stack) }
+
+/* Public Function Definitions */
+// Time. A cycle is a CPU cycle on the board, a nanosecond of real time natively.
+uint32_t halMicros();
+uint32_t halMillis();
+uint32_t halCycles();
+uint32_t halCpuMHz();
+void     halDelayMs(uint32_t ms);
+
+// Locks: short critical sections, task or timer context. Static ones take HAL_LOCK_INIT,
+// ones inside a struct halLockInit().
+void halLockInit(hal_lock* lock);
+void halLock(hal_lock* lock);
+void halUnlock(hal_lock* lock);
+
+// GPIO
+void halPinOutput(uint8_t pin);
+void halPinInput(uint8_t pin, bool pullUp);
+void halPinWrite(uint8_t pin, bool high);
+bool halPinRead(uint8_t pin);
+
+// LEDC
+bool     halPwmSetup(uint8_t channel, uint32_t hz, uint8_t bits);
+void     halPwmAttach(uint8_t pin, uint8_t channel);
+void     halPwmWrite(uint8_t channel, uint32_t duty);
+uint32_t halPwmRead(uint8_t channel);
+
+// ADC, one-shot (pins the DMA drivers own are theirs)
+uint16_t halAdcRead(uint8_t pin);
+uint32_t halAdcReadMv(uint8_t pin);
+
+// Timers, callbacks run in the timer task
+bool halTimerCreate(hal_timer_fn fn, void* arg, const char* name, hal_timer* out);
+bool halTimerStartPeriodic(hal_timer timer, uint32_t periodUs);
+bool halTimerStartOnce(hal_timer timer, uint32_t delayUs);
+void halTimerStop(hal_timer timer);
+
+// ESP-NOW. The receive callback runs in the WiFi task.
+bool halRadioBegin(hal_radio_rx_fn rx);
+bool halRadioSend(const uint8_t* mac, const uint8_t* data, int len);   // Adds the peer on first use
+void halRadioMac(uint8_t* mac);
+
+// FreeRTOS. Natively tasks are recorded, never run: drive their work from the host.
+void     halTaskMemInit(hal_task_mem* mem, uint8_t* stack, uint32_t stackBytes);
+bool     halTaskStart(hal_task_fn fn, void* arg, const char* name, hal_task_mem* mem, uint8_t priority, int8_t core, hal_task* out);
+void     halTaskNotify(hal_task task);
+void     halTaskNotifyFromIsr(hal_task task);
+uint32_t halTaskWait(uint32_t timeoutMs);                               // Notifications taken, 0 on timeout
+bool     halQueueInit(hal_queue* q, void* storage, uint16_t itemSize, uint16_t depth);
+bool     halQueueSend(hal_queue* q, const void* item);                   // Never blocks, false when full
+bool     halQueueReceive(hal_queue* q, void* item);                      // Never blocks, false when empty
+
+// Console
+void halConsoleBegin(uint32_t baud);
+void halPrint(const char* s);
+void halPrintf(const char* fmt, ...);    // Formats on the stack, unlike Print::printf never allocates
+
+// Heap: malloc/calloc/realloc calls (new included) since boot. On the board they are
+// counted through the linker wraps in platformio.ini (-Wl,--wrap=malloc,...), natively
+// through glibc. Call halHeapMark() at the end of setup(), the runtime should not allocate.
+// The wraps miss FreeRTOS (pvPortMalloc) and heap_caps_*, where queues, tasks and the
+// WiFi stack allocate: the block count covers those, it is every allocator's blocks
+// held now against the mark (heap_caps_get_info() on the board).
+uint32_t halHeapAllocs();
+void     halHeapMark();
+uint32_t halHeapSinceMark();
+int32_t  halHeapBlocksSinceMark();
+
+#ifndef ARDUINO
+// Native fakes
+void     halFakeAdvanceUs(uint64_t us);          // Moves the clock, firing due timers in order
+uint64_t halFakeNowUs();
+void     halFakePinSet(uint8_t pin, bool high);   // Level an input reads
+void     halFakeAdcSet(uint8_t pin, uint16_t raw);
+void     halFakeSetMac(const uint8_t* mac);
+void     halFakeRadioSetTx(hal_fake_radio_fn fn);
+void     halFakeRadioRx(const uint8_t* mac, const uint8_t* data, int len);   // Into the receive callback
+uint32_t halFakeNotified(hal_task task);          // Notifications given so far
+void     halFakeStop();                           // Ends the setup()/loop() runner
+bool     halFakeStopped();
+#endif
+
+#ifdef ARDUINO
+// -----------------------------
+// Board: inline wrappers
+// -----------------------------
+inline uint32_t halMicros()                 { return (uint32_t)esp_timer_get_time(); }
+inline uint32_t halMillis()                 { return millis(); }
+inline uint32_t halCycles()                 { return ESP.getCycleCount(); }
+inline uint32_t halCpuMHz()                 { return ESP.getCpuFreqMHz(); }
+inline void     halDelayMs(uint32_t ms)     { vTaskDelay(pdMS_TO_TICKS(ms)); }
+
+inline void halLockInit(hal_lock* lock)     { portMUX_INITIALIZE(lock); }
+inline void halLock(hal_lock* lock)         { portENTER_CRITICAL(lock); }
+inline void halUnlock(hal_lock* lock)       { portEXIT_CRITICAL(lock); }
+
+inline void halPinOutput(uint8_t pin)                 { pinMode(pin, OUTPUT); }
+inline void halPinInput(uint8_t pin, bool pullUp)     { pinMode(pin, pullUp ? INPUT_PULLUP : INPUT); }
+inline void halPinWrite(uint8_t pin, bool high)       { digitalWrite(pin, high ? HIGH : LOW); }
+inline bool halPinRead(uint8_t pin)                   { return digitalRead(pin) == HIGH; }
+
+inline bool     halPwmSetup(uint8_t channel, uint32_t hz, uint8_t bits) { return ledcSetup(channel, hz, bits) != 0; }
+inline void     halPwmAttach(uint8_t pin, uint8_t channel)              { ledcAttachPin(pin, channel); }
+inline void     halPwmWrite(uint8_t channel, uint32_t duty)             { ledcWrite(channel, duty); }
+inline uint32_t halPwmRead(uint8_t channel)                             { return ledcRead(channel); }
+
+inline uint16_t halAdcRead(uint8_t pin)     { return analogRead(pin); }
+inline uint32_t halAdcReadMv(uint8_t pin)   { return analogReadMilliVolts(pin); }
+
+inline bool halTimerStartPeriodic(hal_timer timer, uint32_t periodUs) { return esp_timer_start_periodic(timer, periodUs) == ESP_OK; }
+inline bool halTimerStartOnce(hal_timer timer, uint32_t delayUs)      { return esp_timer_start_once(timer, delayUs) == ESP_OK; }
+inline void halTimerStop(hal_timer timer)                             { esp_timer_stop(timer); }
+
+inline void halTaskNotify(hal_task task)    { xTaskNotifyGive(task); }
+inline uint32_t halTaskWait(uint32_t timeoutMs) {
+  return ulTaskNotifyTake(pdTRUE, (timeoutMs == HAL_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+}
+inline bool halQueueSend(hal_queue* q, const void* item)    { return xQueueSend(q->handle, item, 0) == pdTRUE; }
+inline bool halQueueReceive(hal_queue* q, void* item)       { return xQueueReceive(q->handle, item, 0) == pdTRUE; }
+
+inline void halConsoleBegin(uint32_t baud)  { Serial.begin(baud); }
+inline void halPrint(const char* s)         { Serial.print(s); }
+#endif
+
+inline void halTaskMemInit(hal_task_mem* mem, uint8_t* stack, uint32_t stackBytes) {
+  mem->stack = stack;
+  mem->stackBytes = stackBytes;
+}
+
+#endif // HAL_H
@@ -0,0 +1,54 @@
+/* Touch Track Driver */
+
+/* Includes */
+#include "touch_track.h"
+
+/* Private Function Definitions */
+static void updateThresholds(touch_track* t) {
+  uint32_t base = t->baselineQ8 >> 8;
+  t->touchThreshold = (uint16_t)(base - base * t->cfg.touchPct / 100);
+  t->releaseThreshold = (uint16_t)(base - base * t->cfg.releasePct / 100);
+}
+
+/* Public Function Definitions */
+void touchTrackInit(touch_track* t, const touch_track_cfg* cfg) {
+  *t = touch_track();
+  t->cfg = *cfg;
+}
+
+// FUNCTION: One reading. The baseline only follows while untouched, so a hand
+// resting on the knob never becomes the new "untouched".
+bool touchTrackSample(touch_track* t, uint16_t raw) {
+  t->raw = raw;
+  if (!t->primed) {
+    t->baselineQ8 = (uint32_t)raw << 8;
+    t->primed = true;
+    updateThresholds(t);
+    return false;
+  }
+
+  if (!t->touched) {
+    if (raw < t->touchThreshold) {
+      t->touched = true;
+      t->aboveCount = 0;
+    } else {
+      int32_t diff = ((int32_t)raw << 8) - (int32_t)t->baselineQ8;
+      t->baselineQ8 += diff >> t->cfg.baselineShift;
+      updateThresholds(t);
+    }
+  } else if (raw >= t->releaseThreshold) {
+    if (++t->aboveCount >= t->cfg.releaseSamples) t->touched = false;
+  } else {
+    t->aboveCount = 0;
+  }
+  return t->touched;
+}
+
+void touchTrackForce(touch_track* t) {
+  t->touched = true;
+  t->aboveCount = 0;
+}
+
+uint16_t touchTrackBaseline(const touch_track* t) {
+  return (uint16_t)(t->baselineQ8 >> 8);
+}
@@ -0,0 +1,34 @@
+/* Touch Track Header */
+#ifndef TOUCH_TRACK_H
+#define TOUCH_TRACK_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Typedefs */
+// ESP32 touch pads read lower when touched
+typedef struct touch_track_cfg {
+  uint8_t  touchPct;        // Touched below baseline - touchPct % ...
+  uint8_t  releasePct;      // ... released above baseline - releasePct % (hysteresis)
+  uint8_t  baselineShift;   // Drift tracking, alpha = 1 / 2^shift, untouched samples only
+  uint16_t releaseSamples;  // Consecutive samples above release before letting go
+} touch_track_cfg;
+
+typedef struct touch_track {
+  touch_track_cfg cfg;
+  bool     primed;
+  bool     touched;
+  uint32_t baselineQ8;
+  uint16_t raw;
+  uint16_t touchThreshold;
+  uint16_t releaseThreshold;
+  uint16_t aboveCount;
+} touch_track;
+
+/* Public Function Definitions */
+void     touchTrackInit(touch_track* t, const touch_track_cfg* cfg);
+bool     touchTrackSample(touch_track* t, uint16_t raw);   // Returns touched
+void     touchTrackForce(touch_track* t);                  // Threshold interrupt saw it first
+uint16_t touchTrackBaseline(const touch_track* t);
+
+#endif // TOUCH_TRACK_H
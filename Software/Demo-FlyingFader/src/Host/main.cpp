@@ -0,0 +1,143 @@
+/* Fader Host Build
+ *
+ * Host build (pio run -e native): the fader's control path, wiper filter, PID bank and
+ * touch tracking, against the fakes in lib/Hal on the virtual clock. The slider is a
+ * small motor model fed from the two LEDC channels, its wiper a noisy 12-bit ADC.
+ *
+ *   fader_host            10 s simulated
+ *   fader_host <ms>       that long
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include "hal.h"
+#include "fader_pid.h"
+#include "fader_filter.h"
+#include "touch_track.h"
+
+/* Constants */
+constexpr uint32_t HOST_TICK_US       = 1000;    // Control loop, as FADER_LOOP_HZ
+constexpr uint16_t HOST_ADC_SAMPLES   = 80;      // Per tick, as FADER_DMA_LEN
+constexpr uint8_t  HOST_ADC_NOISE     = 6;       // LSB, peak
+constexpr uint32_t HOST_STEP_MS       = 600;     // New target this often
+constexpr uint32_t HOST_TOUCH_FROM_MS = 4200;    // A hand on the knob ...
+constexpr uint32_t HOST_TOUCH_TO_MS   = 5000;    // ... until here
+constexpr uint16_t HOST_TOUCH_IDLE    = 1000;    // Pad reading untouched
+constexpr uint16_t HOST_TOUCH_HELD    = 850;
+
+// Slider model, per tick: duty accelerates, friction and back-EMF slow it
+constexpr float PLANT_STICTION        = 260.0f;  // Duty that just moves it, below FADER minDuty
+constexpr float PLANT_INERTIA         = 64.0f;   // Duty per count/tick^2
+constexpr float PLANT_DAMPING         = 0.97f;   // Velocity kept per tick
+
+constexpr fader_pid_cfg HOST_PID = {
+  220, 2, 3277, 4096,   // As FADER_PID_DEFAULTS
+  320, 1023,
+  96, 256, 20, 300, 200,
+};
+
+constexpr touch_track_cfg HOST_TOUCH = { 8, 5, 10, 20 };   // As TOUCH_DEFAULTS
+
+/* Statics */
+static hal_timer tickTimer;
+static fader_bank bank;
+static fader_filter filter;
+static touch_track touch;
+static fader_sample sample;
+static int32_t positions[1];
+static uint16_t adcBlock[HOST_ADC_SAMPLES];
+static float plantPos = 10000.0f;
+static float plantVel = 0.0f;
+static uint32_t ticks = 0, touches = 0, cyclesMax = 0;
+static uint64_t cyclesSum = 0;
+
+/* Private Function Definitions */
+// FUNCTION: One tick of the slider under the duty the loop left on the channels
+static void plantStep() {
+  float duty = (float)halPwmRead(1) - (float)halPwmRead(0);
+  if (plantVel == 0.0f && duty < PLANT_STICTION && duty > -PLANT_STICTION) return;
+  float friction = (plantVel > 0.0f || (plantVel == 0.0f && duty > 0.0f)) ? PLANT_STICTION : -PLANT_STICTION;
+  float vel = (plantVel + (duty - friction) / PLANT_INERTIA) * PLANT_DAMPING;
+  if ((plantVel > 0.0f && vel < 0.0f) || (plantVel < 0.0f && vel > 0.0f)) vel = 0.0f;   // Friction stops, never reverses
+  plantVel = vel;
+  plantPos += vel;
+  if (plantPos < 0.0f)                  { plantPos = 0.0f; plantVel = 0.0f; }
+  if (plantPos > (float)FADER_POS_MAX)  { plantPos = (float)FADER_POS_MAX; plantVel = 0.0f; }
+}
+
+static void writeDuty(int16_t duty) {
+  halPwmWrite(0, (duty < 0) ? -duty : 0);
+  halPwmWrite(1, (duty > 0) ? duty : 0);
+}
+
+// FUNCTION: The control tick: sample, touch, PID, drive, as the fader task does it
+static void onTick(void* arg) {
+  plantStep();
+  uint16_t wiper = (uint16_t)plantPos >> 4;
+  for (uint16_t i = 0; i < HOST_ADC_SAMPLES; ++i) {
+    int32_t v = wiper + (rand() % (2 * HOST_ADC_NOISE + 1)) - HOST_ADC_NOISE;
+    adcBlock[i] = (uint16_t)((v < 0) ? 0 : (v > 4095) ? 4095 : v);
+  }
+
+  uint32_t t0 = halCycles();
+  if (faderFilterBlock(&filter, adcBlock, HOST_ADC_SAMPLES, &sample)) {
+    faderPidSetNoise(&bank, 0, sample.posNoise);
+    positions[0] = sample.pos;
+  }
+  uint32_t nowMs = halMillis();
+  bool held = nowMs >= HOST_TOUCH_FROM_MS && nowMs < HOST_TOUCH_TO_MS;
+  bool wasTouched = touch.touched;
+  if (touchTrackSample(&touch, held ? HOST_TOUCH_HELD : HOST_TOUCH_IDLE)) {
+    if (!wasTouched) touches++;
+    faderPidRelease(&bank, 0);
+  } else if (wasTouched) {
+    faderPidTrack(&bank, 0, positions[0]);
+  }
+  faderBankStep(&bank, positions);
+  writeDuty(bank.duty[0]);
+  uint32_t cycles = halCycles() - t0;
+
+  ticks++;
+  cyclesSum += cycles;
+  if (cycles > cyclesMax) cyclesMax = cycles;
+}
+
+static void printSummary() {
+  const fader_metrics& m = bank.metrics[0];
+  printf("%lu ms simulated, %lu ticks, %lu ns per tick (max %lu)\n", (unsigned long)halMillis(),
+         (unsigned long)ticks, (unsigned long)(ticks ? cyclesSum / ticks : 0), (unsigned long)cyclesMax);
+  printf("Moves: %lu, %lu settled, %lu stalls, settle %lu ms (max %lu), overshoot %ld (max %ld)\n",
+         (unsigned long)m.moves, (unsigned long)m.settled, (unsigned long)m.stalls,
+         (unsigned long)m.lastSettleTicks, (unsigned long)m.maxSettleTicks,
+         (long)m.lastOvershoot, (long)m.maxOvershoot);
+  printf("Wiper noise %u, deadband %u, touches %lu, baseline %u\n", sample.noise,
+         faderPidDeadband(&bank, 0), (unsigned long)touches, touchTrackBaseline(&touch));
+}
+
+/* Public Function Definitions */
+void setup() {
+  for (uint8_t ch = 0; ch < 2; ++ch) halPwmSetup(ch, 20000, 10);
+  writeDuty(0);
+  faderFilterInit(&filter, 1);
+  touchTrackInit(&touch, &HOST_TOUCH);
+  positions[0] = (int32_t)plantPos;
+  faderBankInit(&bank, &HOST_PID, 1, positions);
+  halTimerCreate(onTick, NULL, "fader", &tickTimer);
+  halTimerStartPeriodic(tickTimer, HOST_TICK_US);
+  atexit(printSummary);
+}
+
+// Steps between 20 % and 80 % of the travel, the hand takes over for a while
+void loop() {
+  static uint32_t lastStepMs = 0;
+  static bool high = false;
+  uint32_t nowMs = halMillis();
+
+  if (nowMs - lastStepMs >= HOST_STEP_MS) {
+    lastStepMs = nowMs;
+    high = !high;
+    if (!touch.touched) faderPidSetTarget(&bank, 0, high ? FADER_POS_MAX * 8 / 10 : FADER_POS_MAX * 2 / 10);
+  }
+  halDelayMs(10);
+}
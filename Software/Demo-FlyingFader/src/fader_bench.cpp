@@ -0,0 +1,86 @@
+/* Fader Bench */
+
+/* Includes */
+#include "hal.h"
+#include "fader_bench.h"
+#include "fader_control.h"
+
+/* Statics */
+static fader_bank bank;
+static fader_filter filters[FADER_MAX_AXES];
+static fader_sample samples[FADER_MAX_AXES];
+static int32_t positions[FADER_MAX_AXES];
+static uint16_t dmaBlock[FADER_DMA_LEN];
+static uint8_t chanToAxis[16];
+
+/* Private Function Definitions */
+// FUNCTION: Cycles per call of fn, averaged over FADER_BENCH_ROUNDS
+template <typename F>
+static uint32_t cyclesPerRound(F fn) {
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < FADER_BENCH_ROUNDS; ++i) fn(i);
+  return (ESP.getCycleCount() - start) / FADER_BENCH_ROUNDS;
+}
+
+// One tick's worth of interleaved wiper samples, a slow ramp with some noise
+static void fillBlock(uint8_t axes, uint16_t round) {
+  for (uint16_t i = 0; i < FADER_DMA_LEN; ++i) {
+    uint8_t a = i % axes;
+    uint16_t v = (uint16_t)((round * 4 + a * 300 + (i * 37) % 23) & 0x0FFF);
+    dmaBlock[i] = (uint16_t)(a << 12) | v;
+  }
+}
+
+/* Public Function Definitions */
+void faderBenchRun() {
+  uint32_t mhz = ESP.getCpuFreqMHz();
+  uint32_t budget = mhz * (1000000UL / FADER_LOOP_HZ) * FADER_BENCH_BUDGET_PCT / 100;
+  halPrintf("\n=== Fader bench: %lu MHz, %u Hz loop, budget %lu cycles per tick ===\n",
+            (unsigned long)mhz, (unsigned)FADER_LOOP_HZ, (unsigned long)budget);
+
+  // Fixed per-axis costs: one duty update is two LEDC writes, one touch poll a touchRead
+  ledcSetup(FADER_BENCH_CHANNEL, FADER_PWM_FREQ, FADER_PWM_BITS);
+  uint32_t ledc = cyclesPerRound([](uint16_t i) { ledcWrite(FADER_BENCH_CHANNEL, i & 0x3FF); });
+  ledcWrite(FADER_BENCH_CHANNEL, 0);
+  uint32_t touch = cyclesPerRound([](uint16_t i) { (void)touchRead(FADER_AXES[0].touchPin); });
+  halPrintf("ledcWrite %lu, touchRead %lu cycles\n", (unsigned long)ledc, (unsigned long)touch);
+
+  uint8_t fit = 0;
+  for (uint8_t axes = 1; axes <= FADER_MAX_AXES; ++axes) {
+    // Fresh state, every axis chasing a moving target so the whole PID path runs
+    for (uint8_t c = 0; c < 16; ++c) chanToAxis[c] = (c < axes) ? c : FADER_FILTER_NO_AXIS;
+    for (uint8_t a = 0; a < axes; ++a) {
+      faderFilterInit(&filters[a], FADER_LOWPASS_SHIFT);
+      positions[a] = a * 4000;
+    }
+    faderBankInit(&bank, &FADER_PID_DEFAULTS, axes, positions);
+    for (uint8_t a = 0; a < axes; ++a) faderPidSetTarget(&bank, a, FADER_POS_MAX - a * 4000);
+
+    // Demux and decimation, the block refill is timed too and taken back out
+    uint32_t fill = cyclesPerRound([axes](uint16_t i) { fillBlock(axes, i); });
+    uint32_t demux = cyclesPerRound([axes](uint16_t i) {
+      fillBlock(axes, i);
+      faderFilterDemux(filters, axes, chanToAxis, dmaBlock, FADER_DMA_LEN, samples);
+    }) - fill;
+    uint32_t pid = cyclesPerRound([axes](uint16_t i) {
+      for (uint8_t a = 0; a < axes; ++a) positions[a] += bank.duty[a] >> 4;
+      faderBankStep(&bank, positions);
+    });
+
+    uint32_t tick = demux + pid + axes * (2 * ledc + touch);
+    bool fits = tick <= budget;
+    if (fits) fit = axes;
+    halPrintf("%u axes: demux %lu + PID %lu + LEDC/touch %lu = %lu cycles (%lu us, %lu per axis)%s\n",
+              axes, (unsigned long)demux, (unsigned long)pid,
+              (unsigned long)(axes * (2 * ledc + touch)), (unsigned long)tick,
+              (unsigned long)(tick / mhz), (unsigned long)(tick / axes), fits ? "" : " OVER BUDGET");
+  }
+
+  // Compute is rarely the limit, the peripherals are
+  uint8_t maxAxes = fit;
+  if (maxAxes > FADER_MAX_AXES) maxAxes = FADER_MAX_AXES;
+  if (maxAxes > FADER_ADC1_WIPERS) maxAxes = FADER_ADC1_WIPERS;
+  halPrintf("Fit at %u Hz: %u axes by CPU, %u with %u LEDC pairs and %u ADC1 wipers, %lu samples per axis per tick\n",
+            (unsigned)FADER_LOOP_HZ, fit, maxAxes, FADER_MAX_AXES, FADER_ADC1_WIPERS,
+            (unsigned long)(FADER_ADC_RATE_HZ / FADER_LOOP_HZ / (maxAxes ? maxAxes : 1)));
+}
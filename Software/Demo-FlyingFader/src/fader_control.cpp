@@ -0,0 +1,245 @@
+/* Fader Control Driver */
+
+/* Includes */
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#include "fader_control.h"
+
+/* Typedefs */
+// Latest request per axis from another task, the control task applies it on its next tick
+enum fader_request : uint8_t {
+  FADER_REQ_NONE,
+  FADER_REQ_STEP,
+  FADER_REQ_TRACK,
+  FADER_REQ_RELEASE,
+};
+
+/* Statics */
+// Owned by the control task
+static fader_bank bank;
+static fader_sample samples[FADER_MAX_AXES];
+static int32_t positions[FADER_MAX_AXES];
+static int16_t written[FADER_MAX_AXES];
+static uint8_t emptyRun[FADER_MAX_AXES];
+static bool touched[FADER_MAX_AXES];
+static uint8_t axisCount = 0;
+
+static hw_timer_t* loopTimer = NULL;
+static TaskHandle_t faderTaskHandle = NULL;
+static StackType_t faderStack[FADER_TASK_STACK];
+static StaticTask_t faderTcb;
+
+static volatile uint32_t timerTicks = 0;   // Counted by the timer ISR, a wake without a new one came from touch
+
+static portMUX_TYPE faderMux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t request[FADER_MAX_AXES];
+static int32_t requestPos[FADER_MAX_AXES];
+static fader_status status[FADER_MAX_AXES];
+static fader_loop_stats loopStats;
+
+/* Private Function Definitions */
+static void IRAM_ATTR onLoopTimer() {
+  timerTicks++;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(faderTaskHandle, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+// A pulls toward 0, B toward FADER_POS_MAX, never both. Skipped when unchanged.
+static inline void writeDuty(uint8_t axis, int16_t duty) {
+  if (duty == written[axis]) return;
+  ledcWrite(2 * axis,     (duty < 0) ? -duty : 0);
+  ledcWrite(2 * axis + 1, (duty > 0) ? duty : 0);
+  written[axis] = duty;
+}
+
+// FUNCTION: One tick per timer interrupt, every axis: request, sample, touch, PID, drive.
+// A touch interrupt wakes it early to cut the drive, that wake polls the touched axes only:
+// no sampling or PID step off the tick, so velocity and move times stay in ticks.
+static void faderTask(void* parameter) {
+  uint8_t req[FADER_MAX_AXES];
+  int32_t reqPos[FADER_MAX_AXES];
+  uint32_t releaseUs[FADER_MAX_AXES];
+  uint32_t lost, newTouch, fresh;
+  uint32_t ticksSeen = 0;
+
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t fired = timerTicks - ticksSeen;
+    ticksSeen += fired;
+    bool tick = fired != 0;
+    uint32_t t0 = micros();
+    uint32_t tickUs = (uint32_t)esp_timer_get_time();
+
+    // 1. Take the latest requests. A touched axis leaves its request where it is,
+    // the newest one is applied on the first tick after the hand is gone.
+    portENTER_CRITICAL(&faderMux);
+    for (uint8_t a = 0; a < axisCount; ++a) {
+      req[a] = FADER_REQ_NONE;
+      if (!tick || touched[a]) continue;
+      req[a] = request[a];
+      reqPos[a] = requestPos[a];
+      request[a] = FADER_REQ_NONE;
+    }
+    portEXIT_CRITICAL(&faderMux);
+    for (uint8_t a = 0; a < axisCount; ++a) {
+      switch (req[a]) {
+        case FADER_REQ_STEP:    faderPidSetTarget(&bank, a, reqPos[a]); break;
+        case FADER_REQ_TRACK:   faderPidTrack(&bank, a, reqPos[a]);     break;
+        case FADER_REQ_RELEASE: faderPidRelease(&bank, a);              break;
+        default: break;
+      }
+    }
+
+    // 2. Decimate what the ADC DMA collected since the last tick. An axis without
+    // fresh samples for too long has lost its position: motor off.
+    fresh = tick ? faderSenseRead(samples) : 0;
+    lost = 0;
+    for (uint8_t a = 0; a < axisCount && tick; ++a) {
+      if (fresh & (1UL << a)) {
+        emptyRun[a] = 0;
+        faderPidSetNoise(&bank, a, samples[a].posNoise);
+      } else if (emptyRun[a] < FADER_SENSE_TIMEOUT) {
+        emptyRun[a]++;
+      } else if (bank.state[a] != FADER_IDLE) {
+        faderPidRelease(&bank, a);
+        lost |= 1UL << a;
+      }
+      positions[a] = samples[a].pos;
+    }
+
+    // 3. Touch: the user wins. Drive off at once, hold wherever they leave it.
+    newTouch = 0;
+    for (uint8_t a = 0; a < axisCount; ++a) {
+      if (!tick && !faderTouchPending(a)) continue;
+      uint32_t edgeUs;
+      bool nowTouched = faderTouchPoll(a, &edgeUs);
+      if (nowTouched) {
+        if (!touched[a]) {
+          writeDuty(a, 0);
+          releaseUs[a] = edgeUs ? (uint32_t)esp_timer_get_time() - edgeUs : 0;
+          newTouch |= 1UL << a;
+        }
+        faderPidRelease(&bank, a);   // Motor off while held, step 1 keeps its request
+      } else if (touched[a]) {
+        faderPidTrack(&bank, a, positions[a]);
+      }
+      touched[a] = nowTouched;
+    }
+
+    // 4. Control every axis, drive
+    if (tick) {
+      faderBankStep(&bank, positions);
+      for (uint8_t a = 0; a < axisCount; ++a) writeDuty(a, bank.duty[a]);
+    }
+    uint32_t us = micros() - t0;
+
+    // 5. Snapshot for faderStatus()
+    portENTER_CRITICAL(&faderMux);
+    for (uint8_t a = 0; a < axisCount; ++a) {
+      fader_status& st = status[a];
+      const touch_track* tt = faderTouchState(a);
+      st.state = (fader_state)bank.state[a];
+      st.pos = positions[a];
+      st.posUs = tickUs;
+      st.target = bank.target[a];
+      st.duty = bank.duty[a];
+      st.noise = samples[a].noise;
+      st.posNoise = samples[a].posNoise;
+      st.deadband = faderPidDeadband(&bank, a);
+      st.metrics = bank.metrics[a];
+      if (lost & (1UL << a)) st.senseFaults++;
+      st.touched = touched[a];
+      if (newTouch & (1UL << a)) {
+        st.touches++;
+        st.lastReleaseUs = releaseUs[a];
+        if (releaseUs[a] > st.maxReleaseUs) st.maxReleaseUs = releaseUs[a];
+      }
+      st.touchRaw = tt->raw;
+      st.touchBaseline = touchTrackBaseline(tt);
+    }
+    if (tick) {
+      loopStats.ticks++;
+      loopStats.missedTicks += fired - 1;
+      if (!fresh) loopStats.emptyTicks++;
+      loopStats.lastTickUs = us;
+      if (us > loopStats.maxTickUs) loopStats.maxTickUs = us;
+    }
+    portEXIT_CRITICAL(&faderMux);
+  }
+}
+
+static void postRequest(uint8_t axis, fader_request req, int32_t pos) {
+  if (axis >= axisCount) return;
+  portENTER_CRITICAL(&faderMux);
+  request[axis] = req;
+  requestPos[axis] = pos;
+  portEXIT_CRITICAL(&faderMux);
+}
+
+/* Public Function Definitions */
+bool faderBegin(const fader_axis_cfg* axes, uint8_t count, const fader_pid_cfg* cfg) {
+  if (faderTaskHandle) return true;
+  if (!count || count > FADER_MAX_AXES) return false;
+  axisCount = count;
+
+  // 1. Motors off
+  adc1_channel_t channels[FADER_MAX_AXES];
+  uint8_t touchPins[FADER_MAX_AXES];
+  for (uint8_t a = 0; a < count; ++a) {
+    ledcSetup(2 * a,     FADER_PWM_FREQ, FADER_PWM_BITS);
+    ledcSetup(2 * a + 1, FADER_PWM_FREQ, FADER_PWM_BITS);
+    ledcAttachPin(axes[a].pwmAPin, 2 * a);
+    ledcAttachPin(axes[a].pwmBPin, 2 * a + 1);
+    ledcWrite(2 * a, 0);
+    ledcWrite(2 * a + 1, 0);
+    channels[a] = axes[a].adcChannel;
+    touchPins[a] = axes[a].touchPin;
+  }
+
+  // 2. Wiper sampling, wait for a first reading of every axis to start from where the sliders are
+  if (!faderSenseBegin(channels, count)) return false;
+  uint32_t allAxes = (1UL << count) - 1;
+  uint32_t seen = 0;
+  uint32_t waitStart = millis();
+  while (seen != allAxes) {
+    seen |= faderSenseRead(samples);
+    if (millis() - waitStart > 100) return false;
+    delay(1);
+  }
+  for (uint8_t a = 0; a < count; ++a) positions[a] = samples[a].pos;
+  faderBankInit(&bank, cfg, count, positions);
+  loopStats.axes = count;
+
+  // 3. Control task, touch (runs without it), then the timer that paces it all
+  faderTaskHandle = xTaskCreateStaticPinnedToCore(faderTask, "Fader Task", FADER_TASK_STACK, NULL,
+                                                  FADER_TASK_PRIORITY, faderStack, &faderTcb, FADER_TASK_CORE);
+  if (!faderTaskHandle) return false;
+  uint32_t touchMask = faderTouchBegin(faderTaskHandle, touchPins, count);
+  for (uint8_t a = 0; a < count; ++a) status[a].touchReady = touchMask & (1UL << a);
+
+  loopTimer = timerBegin(FADER_TIMER, 80, true);   // 1 MHz
+  if (!loopTimer) return false;
+  timerAttachInterrupt(loopTimer, onLoopTimer, true);
+  timerAlarmWrite(loopTimer, 1000000UL / FADER_LOOP_HZ, true);
+  timerAlarmEnable(loopTimer);
+  return true;
+}
+
+void faderSetTarget(uint8_t axis, int32_t pos) { postRequest(axis, FADER_REQ_STEP, pos); }
+void faderTrack(uint8_t axis, int32_t pos)     { postRequest(axis, FADER_REQ_TRACK, pos); }
+void faderRelease(uint8_t axis)                { postRequest(axis, FADER_REQ_RELEASE, 0); }
+
+void faderStatus(uint8_t axis, fader_status* out) {
+  if (axis >= FADER_MAX_AXES) return;
+  portENTER_CRITICAL(&faderMux);
+  *out = status[axis];
+  portEXIT_CRITICAL(&faderMux);
+}
+
+void faderLoopStats(fader_loop_stats* out) {
+  portENTER_CRITICAL(&faderMux);
+  *out = loopStats;
+  portEXIT_CRITICAL(&faderMux);
+}
@@ -0,0 +1,162 @@
+/* Fader Remote Driver */
+
+/* Includes */
+#include <string.h>
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_timer.h>
+#include "fader_control.h"
+#include "fader_remote.h"
+
+/* Statics */
+static uint8_t peer[6];
+static TaskHandle_t remoteTaskHandle = NULL;
+static StackType_t remoteStack[FADER_REMOTE_STACK];
+static StaticTask_t remoteTcb;
+static volatile uint8_t mode = FADER_REMOTE_OFF;
+static volatile uint8_t remoteAxis = 0;
+
+// Remote task only
+static fader_link_tx tx;
+
+// WiFi task only
+static fader_link_rx rx;
+
+static portMUX_TYPE remoteMux = portMUX_INITIALIZER_UNLOCKED;
+static fader_remote_stats stats = {};
+static uint64_t sumG2gUs = 0;
+
+/* Private Function Definitions */
+static inline uint32_t nowUs() {
+  return (uint32_t)esp_timer_get_time();
+}
+
+static bool sendTo(const uint8_t* mac, const void* data, size_t len) {
+  if (!esp_now_is_peer_exist(mac)) {
+    esp_now_peer_info_t peerInfo = {};
+    memcpy(peerInfo.peer_addr, mac, 6);
+    peerInfo.channel = 0;
+    peerInfo.encrypt = false;
+    if (esp_now_add_peer(&peerInfo) != ESP_OK) return false;
+  }
+  return esp_now_send(mac, (const uint8_t*)data, len) == ESP_OK;
+}
+
+static uint16_t toLinkPos(int32_t pos) {
+  return (uint16_t)constrain(pos, 0L, (long)FADER_LINK_POS_MAX);
+}
+
+// FUNCTION: ESP-NOW receive callback (WiFi task). Mirror: the position goes straight
+// to the control task, echoes are sent from here so they don't wait on anything.
+static void onRecv(const uint8_t* mac, const uint8_t* data, int len) {
+  uint32_t rxUs = nowUs();
+
+  if (faderLinkIsEcho(data, len)) {
+    fader_link_echo echo;
+    memcpy(&echo, data, sizeof(echo));
+    uint32_t g2g = faderLinkGlassToGlassUs(&echo, rxUs);
+    portENTER_CRITICAL(&remoteMux);
+    stats.echoes++;
+    stats.lastG2gUs = g2g;
+    stats.minG2gUs = min(stats.minG2gUs, g2g);
+    stats.maxG2gUs = max(stats.maxG2gUs, g2g);
+    sumG2gUs += g2g;
+    if (g2g > FADER_LINK_TARGET_US) stats.overTarget++;
+    portEXIT_CRITICAL(&remoteMux);
+    return;
+  }
+  if (!faderLinkIsPos(data, len) || mode != FADER_REMOTE_MIRROR) return;
+
+  fader_link_pos pkt;
+  memcpy(&pkt, data, sizeof(pkt));
+  bool fresh = faderLinkRxAccept(&rx, pkt.seq, rxUs);
+  if (fresh) faderTrack(remoteAxis, pkt.pos);
+
+  portENTER_CRITICAL(&remoteMux);
+  if (fresh) stats.received++;
+  else       stats.stale++;
+  portEXIT_CRITICAL(&remoteMux);
+
+  // The motor acts on the next control tick: count a whole one
+  if (fresh && (pkt.flags & FADER_LINK_WANT_ECHO)) {
+    fader_link_echo echo = {};
+    echo.magic = FADER_LINK_MAGIC;
+    echo.op = FADER_LINK_OP_ECHO;
+    echo.seq = pkt.seq;
+    echo.axis = pkt.axis;
+    echo.pos = pkt.pos;
+    echo.sampledUs = pkt.sampledUs;
+    echo.sentUs = pkt.sentUs;
+    echo.rxToApplyUs = nowUs() - rxUs + 1000000UL / FADER_LOOP_HZ;
+    sendTo(mac, &echo, sizeof(echo));
+  }
+}
+
+// FUNCTION: Send mode, once per control tick: compress, rate limit, transmit
+static void remoteTask(void* parameter) {
+  fader_status st;
+  fader_link_pos pkt;
+
+  while (true) {
+    vTaskDelay(1);
+    if (mode != FADER_REMOTE_SEND) continue;
+
+    faderStatus(remoteAxis, &st);
+    uint16_t pos = toLinkPos(st.pos);
+    uint32_t now = nowUs();
+    uint8_t send = faderLinkTxDecide(&tx, pos, faderLinkStep(st.posNoise), now);
+    if (send == FADER_LINK_SKIP) {
+      if (pos != tx.lastPos) {
+        portENTER_CRITICAL(&remoteMux);
+        stats.skipped++;
+        portEXIT_CRITICAL(&remoteMux);
+      }
+      continue;
+    }
+
+    uint8_t flags = (st.touched ? FADER_LINK_TOUCHED : 0) |
+                    ((send == FADER_LINK_SEND_HEARTBEAT) ? FADER_LINK_HEARTBEAT : 0);
+    faderLinkTxStamp(&tx, &pkt, remoteAxis, pos, flags, st.posUs, now);
+    bool ok = sendTo(peer, &pkt, sizeof(pkt));
+
+    portENTER_CRITICAL(&remoteMux);
+    if (!ok) stats.sendFails++;
+    else if (send == FADER_LINK_SEND_HEARTBEAT) stats.heartbeats++;
+    else stats.changes++;
+    if (ok) stats.sent++;
+    portEXIT_CRITICAL(&remoteMux);
+  }
+}
+
+/* Public Function Definitions */
+bool faderRemoteBegin(const uint8_t* peerMac) {
+  if (remoteTaskHandle) return true;
+  memcpy(peer, peerMac, 6);
+  stats.minG2gUs = UINT32_MAX;
+
+  WiFi.mode(WIFI_STA);
+  WiFi.disconnect();
+  if (esp_now_init() != ESP_OK) return false;
+  esp_now_register_recv_cb(onRecv);
+
+  remoteTaskHandle = xTaskCreateStaticPinnedToCore(remoteTask, "Fader Remote", FADER_REMOTE_STACK, NULL,
+                                                   FADER_REMOTE_PRIORITY, remoteStack, &remoteTcb, FADER_REMOTE_CORE);
+  return remoteTaskHandle != NULL;
+}
+
+void faderRemoteMode(fader_remote_mode newMode, uint8_t axis) {
+  remoteAxis = axis;
+  mode = newMode;
+  if (newMode == FADER_REMOTE_SEND) faderRelease(axis);   // Free to move by hand
+}
+
+void faderRemoteStats(fader_remote_stats* out) {
+  uint32_t now = nowUs();
+  portENTER_CRITICAL(&remoteMux);
+  *out = stats;
+  if (!stats.echoes) out->minG2gUs = 0;
+  out->avgG2gUs = stats.echoes ? (uint32_t)(sumG2gUs / stats.echoes) : 0;
+  portEXIT_CRITICAL(&remoteMux);
+  out->mode = mode;
+  out->linkUp = mode == FADER_REMOTE_MIRROR && !faderLinkRxLost(&rx, now);
+}
@@ -0,0 +1,65 @@
+/* Fader Sense Driver */
+
+/* Includes */
+#include <string.h>
+#include <driver/i2s.h>
+#include "fader_sense.h"
+
+/* Statics */
+static fader_filter filters[FADER_MAX_AXES];
+static uint8_t chanToAxis[16];
+static uint8_t axisCount = 0;
+static uint16_t block[FADER_DMA_LEN * FADER_DMA_BUFFERS];
+
+/* Public Function Definitions */
+
+// FUNCTION: Start continuous sampling of every wiper
+bool faderSenseBegin(const adc1_channel_t* channels, uint8_t count) {
+  if (!count || count > FADER_MAX_AXES) return false;
+  axisCount = count;
+  memset(chanToAxis, FADER_FILTER_NO_AXIS, sizeof(chanToAxis));
+  for (uint8_t a = 0; a < count; ++a) {
+    faderFilterInit(&filters[a], FADER_LOWPASS_SHIFT);
+    chanToAxis[channels[a]] = a;
+  }
+
+  i2s_config_t cfg = {};
+  cfg.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+  cfg.sample_rate = FADER_ADC_RATE_HZ;
+  cfg.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  cfg.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  cfg.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  cfg.intr_alloc_flags = 0;
+  cfg.dma_buf_count = FADER_DMA_BUFFERS;
+  cfg.dma_buf_len = FADER_DMA_LEN;
+  cfg.use_apll = false;
+
+  if (i2s_driver_install(I2S_NUM_0, &cfg, 0, NULL) != ESP_OK) return false;
+  if (i2s_set_adc_mode(ADC_UNIT_1, channels[0]) != ESP_OK) return false;
+  for (uint8_t a = 0; a < count; ++a) adc1_config_channel_atten(channels[a], ADC_ATTEN_DB_11);
+  if (i2s_adc_enable(I2S_NUM_0) != ESP_OK) return false;
+  if (count == 1) return true;
+
+  // Enabling installs a one-channel pattern, replace it with every wiper
+  adc_digi_pattern_table_t pattern[FADER_MAX_AXES] = {};
+  for (uint8_t a = 0; a < count; ++a) {
+    pattern[a].atten = ADC_ATTEN_DB_11;
+    pattern[a].bit_width = ADC_WIDTH_BIT_12;
+    pattern[a].channel = channels[a];
+  }
+  adc_digi_config_t dig = {};
+  dig.conv_limit_en = false;
+  dig.adc1_pattern_len = count;
+  dig.adc1_pattern = pattern;
+  dig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  dig.format = ADC_DIGI_FORMAT_12BIT;
+  return adc_digi_controller_config(&dig) == ESP_OK;
+}
+
+// FUNCTION: Never waits. DMA hands over whole buffers, so a tick normally gets one;
+// timer drift against the ADC clock now and then gives zero or two.
+uint32_t faderSenseRead(fader_sample* out) {
+  size_t bytesRead = 0;
+  i2s_read(I2S_NUM_0, block, sizeof(block), &bytesRead, 0);   // Times out once drained
+  return faderFilterDemux(filters, axisCount, chanToAxis, block, bytesRead / sizeof(block[0]), out);
+}
@@ -0,0 +1,90 @@
+/* Fader Touch Driver */
+
+/* Includes */
+#include <esp_timer.h>
+#include <driver/touch_pad.h>
+#include "fader_touch.h"
+
+/* Statics */
+static touch_track tracks[FADER_MAX_AXES];   // Owned by the control task
+static uint8_t touchPins[FADER_MAX_AXES];
+static uint32_t readyMask = 0;
+static TaskHandle_t wakeHandle = NULL;
+static uint16_t pollCount[FADER_MAX_AXES];
+
+// Set by the interrupts, cleared by the poll
+static volatile bool edgeSeen[FADER_MAX_AXES];
+static volatile uint32_t edgeUs[FADER_MAX_AXES];
+
+/* Private Function Definitions */
+
+// FUNCTION: Fires on every reading below the threshold, only the first one counts
+static void IRAM_ATTR touchEdge(uint8_t axis) {
+  if (edgeSeen[axis] || tracks[axis].touched) return;
+  edgeUs[axis] = (uint32_t)esp_timer_get_time();
+  edgeSeen[axis] = true;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(wakeHandle, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+// touchAttachInterrupt() takes no argument, one handler per axis
+template <uint8_t Axis>
+static void IRAM_ATTR onTouch() { touchEdge(Axis); }
+
+static void (*const touchHandlers[FADER_MAX_AXES])() = {
+  onTouch<0>, onTouch<1>, onTouch<2>, onTouch<3>,
+  onTouch<4>, onTouch<5>, onTouch<6>, onTouch<7>,
+};
+
+/* Public Function Definitions */
+uint32_t faderTouchBegin(TaskHandle_t wakeTask, const uint8_t* pins, uint8_t count) {
+  wakeHandle = wakeTask;
+  touchSetCycles(TOUCH_MEASURE_CYCLES, TOUCH_SLEEP_CYCLES);
+
+  for (uint8_t a = 0; a < count && a < FADER_MAX_AXES; ++a) {
+    touchPins[a] = pins[a];
+    touchTrackInit(&tracks[a], &TOUCH_DEFAULTS);
+    if (pins[a] == FADER_NO_TOUCH || digitalPinToTouchChannel(pins[a]) < 0) continue;
+
+    // Prime the baseline untouched, the threshold follows it from then on
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < 16; ++i) {
+      sum += touchRead(pins[a]);
+      delay(1);
+    }
+    if (!sum) continue;
+    touchTrackSample(&tracks[a], (uint16_t)(sum / 16));
+    touchAttachInterrupt(pins[a], touchHandlers[a], tracks[a].touchThreshold);
+    readyMask |= 1UL << a;
+  }
+  return readyMask;
+}
+
+bool faderTouchPoll(uint8_t axis, uint32_t* edgeOut) {
+  *edgeOut = 0;
+  if (!(readyMask & (1UL << axis))) return false;
+  touch_track* t = &tracks[axis];
+
+  if (edgeSeen[axis]) {
+    *edgeOut = edgeUs[axis];
+    touchTrackForce(t);
+    edgeSeen[axis] = false;
+  }
+  bool touched = touchTrackSample(t, touchRead(touchPins[axis]));
+
+  // Keep the interrupt threshold on the drifting baseline
+  if (++pollCount[axis] >= TOUCH_THRESHOLD_EVERY) {
+    pollCount[axis] = 0;
+    touch_pad_set_thresh((touch_pad_t)digitalPinToTouchChannel(touchPins[axis]), t->touchThreshold);
+  }
+  return touched;
+}
+
+bool faderTouchPending(uint8_t axis) {
+  return axis < FADER_MAX_AXES && edgeSeen[axis];
+}
+
+const touch_track* faderTouchState(uint8_t axis) {
+  return &tracks[axis];
+}
@@ -5,32 +5,37 @@
 // Adapted for ESP32 WROOM
 
 #include <Arduino.h>
+#include "hal.h"
+#include "fader_control.h"
+#include "fader_bench.h"
+#include "fader_remote.h"
 
-// ESP32 GPIO pins for motor control
-const int pwmA = 32;  // motor pin A (PWM)
-const int pwmB = 33;  // motor pin B (PWM)
+#define RUN_BENCHMARK (0U)   // Measure how many axes fit the 1 kHz tick, then run the demo
+#define REMOTE_MODE   (FADER_REMOTE_OFF)   // SEND: input for another node, MIRROR: follow one, OFF: oscillate
 
-// PWM settings for ESP32 LEDC
-const int pwmFreq = 100;      // 100 Hz PWM frequency
-const int pwmChannelA = 0;    // LEDC channel 0 for motor A
-const int pwmChannelB = 1;    // LEDC channel 1 for motor B
-const int pwmResolution = 8;  // 8-bit resolution (0-255)
-
-const int fader = 26;  // ESP32 ADC pin (GPIO26) for fader position
-int fader_pos = 0;
-float filter_amt = 0.75;
-float speed = 1.0;
-
-// Oscillation settings
+// Oscillation settings (0-255 of the travel)
 const int position_high = 250;
 const int position_low = 10;
 int target_position = position_high;
 unsigned long last_switch_time = 0;
 const unsigned long switch_interval = 2000;  // 2 seconds in milliseconds
 
-// Forward declarations
-int calculateEasedSpeed(int distance);
-void go_to_position(int new_position);
+// Reporting
+unsigned long last_print = 0;
+const unsigned long print_interval = 100;
+unsigned long last_remote_print = 0;
+const unsigned long remote_print_interval = 1000;
+uint32_t reported_moves = 0;
+uint32_t reported_touches = 0;
+int last_touched_position = -1;
+
+static int32_t toFaderPos(int position) {
+  return (int32_t)position * FADER_POS_MAX / 255;
+}
+
+static int toPosition(int32_t faderPos) {
+  return (int)(faderPos * 255 / FADER_POS_MAX);
+}
 
 void setup() {
   Serial.begin(115200);  // ESP32 typically uses 115200 baud
@@ -38,25 +43,87 @@ void setup() {
   
   Serial.println("Motorized Fader - Oscillating Mode");
   Serial.println("Oscillating between position 250 and 10 every 2 seconds");
+
+#if RUN_BENCHMARK
+  faderBenchRun();
+#endif
   
-  // Configure LEDC PWM channels for ESP32
-  ledcSetup(pwmChannelA, pwmFreq, pwmResolution);
-  ledcSetup(pwmChannelB, pwmFreq, pwmResolution);
-  ledcAttachPin(pwmA, pwmChannelA);
-  ledcAttachPin(pwmB, pwmChannelB);
-  ledcWrite(pwmChannelA, 0);
-  ledcWrite(pwmChannelB, 0);
-  
-  // Configure ADC for fader reading
-  analogReadResolution(12);  // ESP32 has 12-bit ADC
-  analogSetAttenuation(ADC_11db);  // Full range: 0-3.3V
+  // Motor, wiper and the 1 kHz control loop
+  if (!faderBegin()) {
+    Serial.println("Failed to start fader control!");
+  }
+  faderSetTarget(0, toFaderPos(target_position));
+
+  // Remote control surface over ESP-NOW
+  if (REMOTE_MODE != FADER_REMOTE_OFF) {
+    if (faderRemoteBegin()) {
+      faderRemoteMode(REMOTE_MODE);
+      uint8_t mac[6];
+      halRadioMac(mac);
+      halPrintf("Remote %s, MAC %02X:%02X:%02X:%02X:%02X:%02X\n", (REMOTE_MODE == FADER_REMOTE_SEND) ? "SEND" : "MIRROR",
+                mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    } else {
+      Serial.println("Failed to start ESP-NOW!");
+    }
+  }
+
+  fader_status st;
+  faderStatus(0, &st);
+  Serial.println(st.touchReady ? "Touch the knob to take over the fader"
+                               : "No touch sensing, the motor will fight your hand");
   
   // Initialize timer
   last_switch_time = millis();
+  halHeapMark();    // loop() and the tasks run without the heap from here
 }
 
 void loop() {
   unsigned long current_time = millis();
+
+  fader_status st;
+  faderStatus(0, &st);
+
+  // Remote: the stream does the work, report the link
+  if (REMOTE_MODE != FADER_REMOTE_OFF) {
+    if (current_time - last_remote_print >= remote_print_interval) {
+      last_remote_print = current_time;
+      fader_remote_stats rs;
+      faderRemoteStats(&rs);
+      if (REMOTE_MODE == FADER_REMOTE_SEND) {
+        halPrintf("Send: pos %d, %lu sent (%lu changes, %lu heartbeats), %lu held back, %lu failed\n",
+                  toPosition(st.pos), (unsigned long)rs.sent, (unsigned long)rs.changes,
+                  (unsigned long)rs.heartbeats, (unsigned long)rs.skipped, (unsigned long)rs.sendFails);
+        halPrintf("Glass to glass %lu us (min %lu, avg %lu, max %lu), %lu of %lu over %lu us\n",
+                  (unsigned long)rs.lastG2gUs, (unsigned long)rs.minG2gUs, (unsigned long)rs.avgG2gUs,
+                  (unsigned long)rs.maxG2gUs, (unsigned long)rs.overTarget, (unsigned long)rs.echoes,
+                  (unsigned long)FADER_LINK_TARGET_US);
+      } else {
+        halPrintf("Mirror: link %s, pos %d, target %d, %lu received, %lu stale\n",
+                  rs.linkUp ? "up" : "LOST", toPosition(st.pos), toPosition(st.target),
+                  (unsigned long)rs.received, (unsigned long)rs.stale);
+      }
+    }
+    delay(10);
+    return;
+  }
+
+  // Touched: the fader is an input, stream its position and pause the oscillation
+  if (st.touched) {
+    if (st.touches != reported_touches) {
+      reported_touches = st.touches;
+      halPrintf("\n=== Touched, motor released %lu us after contact (max %lu) ===\n",
+                (unsigned long)st.lastReleaseUs, (unsigned long)st.maxReleaseUs);
+    }
+    int position = toPosition(st.pos);
+    if (position != last_touched_position) {
+      last_touched_position = position;
+      halPrintf("Input: %d\n", position);
+    }
+    last_switch_time = current_time;
+    delay(10);
+    return;
+  }
+  last_touched_position = -1;
   
   // Check if it's time to switch positions
   if (current_time - last_switch_time >= switch_interval) {
@@ -68,80 +135,40 @@ void loop() {
       target_position = position_high;
       Serial.println("\n=== Switching to position 250 ===");
     }
+    faderSetTarget(0, toFaderPos(target_position));
     last_switch_time = current_time;
   }
-  
-  // Move to target position (position updates are printed inside this function)
-  go_to_position(target_position);
-  
-  // Small delay to avoid flooding serial output when at target
-  delay(100);
-}
 
-// Easing function for smooth deceleration
-// Returns PWM value (0-255) based on distance to target
-int calculateEasedSpeed(int distance) {
-  // Minimum and maximum PWM values
-  const int MIN_SPEED = 80;   // Minimum speed to prevent stalling
-  const int MAX_SPEED = 255;  // Maximum speed
-  
-  // Distance thresholds for easing
-  const int FAST_ZONE = 80;   // Full speed when distance > 80
-  const int SLOW_ZONE = 15;   // Start easing at distance < 15
-  
-  if (distance > FAST_ZONE) {
-    // Far away - full speed
-    return MAX_SPEED;
-  } else if (distance > SLOW_ZONE) {
-    // Medium distance - linear interpolation
-    float ratio = (float)(distance - SLOW_ZONE) / (FAST_ZONE - SLOW_ZONE);
-    return MIN_SPEED + (int)(ratio * (MAX_SPEED - MIN_SPEED));
-  } else {
-    // Close to target - ease out using quadratic curve
-    float ratio = (float)distance / SLOW_ZONE;
-    ratio = ratio * ratio;  // Quadratic easing
-    return MIN_SPEED + (int)(ratio * (MAX_SPEED - MIN_SPEED));
+  // Print position updates while moving
+  if (st.state == FADER_MOVING && current_time - last_print > print_interval) {
+    halPrintf("Current position: %d (PWM: %d)\n", toPosition(st.pos), st.duty);
+    last_print = current_time;
   }
-}
 
-void go_to_position(int new_position) {
-  fader_pos = int(analogRead(fader) / 16);  // ESP32 12-bit ADC / 16 = 0-255 range
-  
-  static unsigned long last_print = 0;
-  
-  while (abs(fader_pos - new_position) > 4) {
-    int distance = abs(fader_pos - new_position);
-    int pwm_speed = calculateEasedSpeed(distance);
-    
-    if (fader_pos > new_position) {
-      // Move toward lower position
-      ledcWrite(pwmChannelA, pwm_speed);
-      ledcWrite(pwmChannelB, 0);
-    } else if (fader_pos < new_position) {
-      // Move toward higher position
-      ledcWrite(pwmChannelA, 0);
-      ledcWrite(pwmChannelB, pwm_speed);
-    }
-      
-    fader_pos = int(analogRead(fader) / 16);  // ESP32 12-bit ADC / 16 = 0-255 range
-    
-    // Print position updates while moving
-    if (millis() - last_print > 100) {
-      Serial.print("Current position: ");
-      Serial.print(fader_pos);
-      Serial.print(" (PWM: ");
-      Serial.print(pwm_speed);
-      Serial.println(")");
-      last_print = millis();
+  // Report every finished move once: settled or stalled
+  uint32_t finished = st.metrics.settled + st.metrics.stalls;
+  if (finished != reported_moves) {
+    reported_moves = finished;
+    if (st.state == FADER_STALLED) {
+      halPrintf("Current position: %d (STALLED, motor off)\n", toPosition(st.pos));
+    } else {
+      halPrintf("Current position: %d (SETTLED in %lu ms, overshoot %ld / %ld)\n",
+                toPosition(st.pos), (unsigned long)faderTicksToMs(st.metrics.lastSettleTicks),
+                (long)st.metrics.lastOvershoot, (long)FADER_POS_MAX);
     }
+    fader_loop_stats ls;
+    faderLoopStats(&ls);
+    halPrintf("Loop: %u axes, %lu ticks, %lu missed, %lu us per tick (max %lu), max settle %lu ms, max overshoot %ld\n",
+              ls.axes, (unsigned long)ls.ticks, (unsigned long)ls.missedTicks, (unsigned long)ls.lastTickUs,
+              (unsigned long)ls.maxTickUs, (unsigned long)faderTicksToMs(st.metrics.maxSettleTicks),
+              (long)st.metrics.maxOvershoot);
+    halPrintf("Sense: noise %u (per sample), %u (position), deadband %u, empty ticks %lu, faults %lu\n",
+              st.noise, st.posNoise, st.deadband, (unsigned long)ls.emptyTicks,
+              (unsigned long)st.senseFaults);
+    halPrintf("Heap: %lu allocations, %ld blocks held since setup()\n", (unsigned long)halHeapSinceMark(),
+              (long)halHeapBlocksSinceMark());
   }
-  
-  // Stop motors
-  ledcWrite(pwmChannelA, 0);
-  ledcWrite(pwmChannelB, 0);
-  
-  // Print final position when stopped
-  Serial.print("Current position: ");
-  Serial.print(fader_pos);
-  Serial.println(" (STOPPED)");
+
+  // The control task does the work, just don't spin
+  delay(10);
 }
@@ -0,0 +1,164 @@
+/* Fader Control Tests
+ *
+ * Native (pio test -e native): the PID bank on a noiseless slider model and the touch
+ * tracker on made-up pad readings. Same gains as the host build and the firmware.
+ */
+
+/* Includes */
+#include <unity.h>
+#include "fader_pid.h"
+#include "touch_track.h"
+
+/* Constants */
+constexpr fader_pid_cfg TEST_PID = {
+  220, 2, 3277, 4096,   // As FADER_PID_DEFAULTS
+  320, 1023,
+  96, 256, 20, 300, 200,
+};
+
+constexpr touch_track_cfg TEST_TOUCH = { 8, 5, 10, 20 };   // As TOUCH_DEFAULTS
+
+// Slider model, as the host build without the wiper noise
+constexpr float PLANT_STICTION = 260.0f;
+constexpr float PLANT_INERTIA  = 64.0f;
+constexpr float PLANT_DAMPING  = 0.97f;
+
+/* Statics */
+static fader_bank bank;
+static float plantPos, plantVel;
+static bool plantStuck;
+
+/* Private Function Definitions */
+static void plantStep(int16_t duty) {
+  if (plantStuck) return;
+  if (plantVel == 0.0f && duty < PLANT_STICTION && duty > -PLANT_STICTION) return;
+  float friction = (plantVel > 0.0f || (plantVel == 0.0f && duty > 0)) ? PLANT_STICTION : -PLANT_STICTION;
+  float vel = (plantVel + ((float)duty - friction) / PLANT_INERTIA) * PLANT_DAMPING;
+  if ((plantVel > 0.0f && vel < 0.0f) || (plantVel < 0.0f && vel > 0.0f)) vel = 0.0f;
+  plantVel = vel;
+  plantPos += vel;
+  if (plantPos < 0.0f)                 { plantPos = 0.0f; plantVel = 0.0f; }
+  if (plantPos > (float)FADER_POS_MAX) { plantPos = (float)FADER_POS_MAX; plantVel = 0.0f; }
+}
+
+// FUNCTION: Ticks until the axis leaves MOVING, or limit
+static uint32_t run(uint32_t limit) {
+  for (uint32_t t = 0; t < limit; ++t) {
+    int32_t pos = (int32_t)plantPos;
+    faderBankStep(&bank, &pos);
+    plantStep(bank.duty[0]);
+    if (bank.state[0] != FADER_MOVING) return t;
+  }
+  return limit;
+}
+
+// FUNCTION: Ticks of a tracked target, which never leaves HOLD on its own
+static void track(uint32_t ticks) {
+  for (uint32_t t = 0; t < ticks; ++t) {
+    int32_t pos = (int32_t)plantPos;
+    faderBankStep(&bank, &pos);
+    plantStep(bank.duty[0]);
+  }
+}
+
+/* Public Function Definitions */
+void setUp() {
+  plantPos = 10000.0f;
+  plantVel = 0.0f;
+  plantStuck = false;
+  int32_t pos = (int32_t)plantPos;
+  faderBankInit(&bank, &TEST_PID, 1, &pos);
+}
+
+void tearDown() { }
+
+void test_step_settles_at_target() {
+  faderPidSetTarget(&bank, 0, 50000);
+  uint32_t ticks = run(2000);
+  TEST_ASSERT_LESS_THAN(2000, ticks);
+  TEST_ASSERT_EQUAL(FADER_HOLD, bank.state[0]);
+  TEST_ASSERT_INT_WITHIN(TEST_PID.settleBand, 50000, (int32_t)plantPos);
+  TEST_ASSERT_EQUAL_UINT32(1, bank.metrics[0].moves);
+  TEST_ASSERT_EQUAL_UINT32(1, bank.metrics[0].settled);
+  TEST_ASSERT_GREATER_THAN(0, bank.metrics[0].lastSettleTicks);
+}
+
+void test_release_stops_motor() {
+  faderPidSetTarget(&bank, 0, 50000);
+  run(50);
+  TEST_ASSERT_NOT_EQUAL(0, bank.duty[0]);
+  faderPidRelease(&bank, 0);
+  int32_t pos = (int32_t)plantPos;
+  faderBankStep(&bank, &pos);
+  TEST_ASSERT_EQUAL(FADER_IDLE, bank.state[0]);
+  TEST_ASSERT_EQUAL(0, bank.duty[0]);
+}
+
+void test_stall_turns_motor_off() {
+  plantStuck = true;
+  faderPidSetTarget(&bank, 0, 50000);
+  run(TEST_PID.stallTicks * 2);
+  TEST_ASSERT_EQUAL(FADER_STALLED, bank.state[0]);
+  TEST_ASSERT_EQUAL(0, bank.duty[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, bank.metrics[0].stalls);
+}
+
+// Mirror mode only tracks: a stall there must not keep the follower off for good
+void test_tracking_rearms_after_stall() {
+  plantStuck = true;
+  faderPidTrack(&bank, 0, 50000);
+  track(TEST_PID.stallTicks * 2);
+  TEST_ASSERT_EQUAL(FADER_STALLED, bank.state[0]);
+
+  plantStuck = false;
+  faderPidTrack(&bank, 0, 50000 + TEST_PID.stallMove / 2);   // Still at the obstacle: stays off
+  track(1);
+  TEST_ASSERT_EQUAL(FADER_STALLED, bank.state[0]);
+  TEST_ASSERT_EQUAL(0, bank.duty[0]);
+
+  faderPidTrack(&bank, 0, 30000);                            // Moved on: follows again
+  track(2000);
+  TEST_ASSERT_EQUAL(FADER_HOLD, bank.state[0]);
+  TEST_ASSERT_INT_WITHIN(faderPidDeadband(&bank, 0), 30000, (int32_t)plantPos);
+  TEST_ASSERT_EQUAL_UINT32(1, bank.metrics[0].stalls);
+}
+
+void test_deadband_follows_noise() {
+  faderPidSetNoise(&bank, 0, 10);
+  TEST_ASSERT_EQUAL_UINT16(TEST_PID.deadband, faderPidDeadband(&bank, 0));   // Floor
+  faderPidSetNoise(&bank, 0, 100);
+  TEST_ASSERT_GREATER_OR_EQUAL(300, faderPidDeadband(&bank, 0));           // 3 sigma
+}
+
+void test_touch_hysteresis_and_release_count() {
+  touch_track t;
+  touchTrackInit(&t, &TEST_TOUCH);
+  TEST_ASSERT_FALSE(touchTrackSample(&t, 1000));   // Primes the baseline
+  TEST_ASSERT_FALSE(touchTrackSample(&t, 950));    // -5 %, not yet
+  TEST_ASSERT_TRUE(touchTrackSample(&t, 900));     // -10 %
+  TEST_ASSERT_TRUE(touchTrackSample(&t, 940));     // Between the thresholds: still held
+  for (uint16_t i = 1; i < TEST_TOUCH.releaseSamples; ++i) TEST_ASSERT_TRUE(touchTrackSample(&t, 1000));
+  TEST_ASSERT_FALSE(touchTrackSample(&t, 1000));
+}
+
+void test_touch_baseline_frozen_while_held() {
+  touch_track t;
+  touchTrackInit(&t, &TEST_TOUCH);
+  touchTrackSample(&t, 1000);
+  touchTrackForce(&t);
+  for (uint16_t i = 0; i < 2000; ++i) touchTrackSample(&t, 850);
+  TEST_ASSERT_EQUAL_UINT16(1000, touchTrackBaseline(&t));
+  TEST_ASSERT_TRUE(touchTrackSample(&t, 850));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_step_settles_at_target);
+  RUN_TEST(test_release_stops_motor);
+  RUN_TEST(test_stall_turns_motor_off);
+  RUN_TEST(test_tracking_rearms_after_stall);
+  RUN_TEST(test_deadband_follows_noise);
+  RUN_TEST(test_touch_hysteresis_and_release_count);
+  RUN_TEST(test_touch_baseline_frozen_while_held);
+  return UNITY_END();
+}
@@ -0,0 +1,84 @@
+/* Heater Control Header */
+#ifndef HEATER_CONTROL_H
+#define HEATER_CONTROL_H
+
+/* Includes */
+#include <Arduino.h>
+#include "heater_pid.h"
+#include "heater_dose.h"
+
+/* Constants */
+// -----------------------------
+// Temperature: K thermocouple on a MAX31855 (VSPI). ADC1 belongs to the sound
+// DMA and ADC2 to the radio, and a thermocouple reaches branding temperatures.
+// -----------------------------
+constexpr uint8_t  HEATER_TC_SCK          = 18;
+constexpr uint8_t  HEATER_TC_MISO         = 19;
+constexpr uint8_t  HEATER_TC_CS           = 5;
+constexpr uint32_t HEATER_TC_SPI_HZ       = 4000000;
+constexpr uint8_t  HEATER_SENSOR_FAULTS   = 3;      // Bad readings in a row: heater off
+
+// MAX31855 fault bits, plus one for a dead bus
+constexpr uint8_t  HEATER_TC_OPEN         = 0x01;
+constexpr uint8_t  HEATER_TC_SHORT_GND    = 0x02;
+constexpr uint8_t  HEATER_TC_SHORT_VCC    = 0x04;
+constexpr uint8_t  HEATER_TC_NO_SENSOR    = 0x08;
+
+// -----------------------------
+// Energy dosing: burst-fire in whole slots, own esp_timer
+// -----------------------------
+constexpr uint16_t HEATER_BURST_SLOT_MS   = 10;     // 10 LEDC periods at 1 kHz
+
+// -----------------------------
+// Control task, fixed rate (HEATER_SAMPLE_HZ, tuning in heater_pid.h)
+// -----------------------------
+constexpr uint8_t  HEATER_TASK_PRIORITY   = 4;
+constexpr uint8_t  HEATER_TASK_CORE       = 1;
+constexpr uint16_t HEATER_TASK_STACK      = 3072;
+
+/* Typedefs */
+enum heater_state : uint8_t {
+  HEATER_OFF,           // Not driving the PWM, still measuring
+  HEATER_HEATING,       // Outside the profile's band
+  HEATER_SOAK,          // In the band, waiting out soakMs
+  HEATER_READY,
+  HEATER_DOSE,          // Temperature loop paused, burst-firing a dose, then back to the profile
+  HEATER_FAULT,         // Sensor lost or safety trip while heating, off until the next profile
+};
+
+typedef struct heater_status {
+  heater_state state;
+  float    tempC;
+  float    internalC;       // MAX31855 cold junction
+  float    setpointC;       // Ramped
+  float    targetC;
+  float    duty;
+  uint8_t  sensorFault;     // HEATER_TC_* of the last bad reading
+  uint32_t sensorFaults;
+  uint32_t samples;
+  uint32_t timeToTempMs;    // Profile start to first inside the band, 0 until then
+  float    overshootC;      // Worst excursion above the target since the profile started
+  uint32_t lastSampleUs;    // Work per sample: SPI, PID, LEDC
+  // Energy dosing
+  uint32_t supplyMv;
+  uint32_t doses;
+  uint8_t  doseResult;      // heater_dose_result of the running or last dose, REJECTED or ABORTED (0 J) for one that never ran
+  float    doseJ;
+  float    doseTargetJ;
+  uint32_t doseMs;
+  uint32_t doseSlots;
+  uint32_t doseOnSlots;
+} heater_status;
+
+/* Public Function Definitions */
+bool heaterBegin(uint8_t pwmChannel, uint32_t pwmMax, const heater_pid_cfg* cfg = &HEATER_PID_DEFAULTS);
+void heaterSetProfile(const heater_profile* profile);   // Closed loop on, takes over the PWM channel
+void heaterStop();                                       // PWM 0, the channel is the caller's again
+bool heaterReady();
+bool heaterFaulted();                                    // Off until the next profile, no brand from it
+void heaterSetSupply(uint32_t (*supplyMv)());            // Measured heater supply, needed for dosing
+bool heaterDose(const heater_dose_cfg* cfg);             // Only while the loop owns the PWM and the supply is known
+bool heaterDosing();
+void heaterStatus(heater_status* out);
+
+#endif // HEATER_CONTROL_H
@@ -0,0 +1,64 @@
+/* Heater Safety Header */
+#ifndef HEATER_SAFETY_H
+#define HEATER_SAFETY_H
+
+/* Includes */
+#include <Arduino.h>
+
+/* Constants */
+// -----------------------------
+// Cutoff: the PWM pin is taken off the LEDC and driven low, so no ledcWrite()
+// from any mode reaches the element until heaterSafetyReset()
+// -----------------------------
+// NC cutout on the iron to GND, pulled up: open or unplugged trips. -1 not fitted, the
+// default: an unwired pin reads open and would keep the heater cut. 33 with it wired.
+constexpr int8_t   HEATER_SAFE_TRIP_PIN   = -1;
+constexpr float    HEATER_SAFE_MAX_C      = 320.0f; // Thermocouple over this: cut, whatever owns the PWM
+constexpr float    HEATER_SAFE_SETPOINT_C = 290.0f; // Highest setpoint taken, room for the overshoot under the cutoff
+constexpr float    HEATER_SAFE_RESET_C    = 280.0f; // Re-arm only below this
+// STALE and STUCK arm on the first good reading, in every mode: a board without the
+// thermocouple keeps MANUAL, AUDIO and FADER, one that loses it after that is cut.
+constexpr uint16_t HEATER_SAFE_STALE_MS   = 500;    // PWM on without a good reading this long: cut
+constexpr float    HEATER_SAFE_STUCK_DUTY = 0.95f;  // PWM this high ...
+constexpr uint32_t HEATER_SAFE_STUCK_MS   = 20000;  // ... this long ...
+constexpr float    HEATER_SAFE_STUCK_RISE = 10.0f;  // ... without this much rise: sensor off the iron or output stuck on
+
+// -----------------------------
+// Watchdog task: above WiFi, on the core the heater loop does not run on
+// -----------------------------
+constexpr uint8_t  HEATER_SAFE_PRIORITY   = configMAX_PRIORITIES - 1;
+constexpr uint8_t  HEATER_SAFE_CORE       = 0;
+constexpr uint16_t HEATER_SAFE_STACK      = 2048;
+constexpr uint8_t  HEATER_SAFE_PERIOD_MS  = 5;
+
+// Trip causes, latched until reset
+constexpr uint8_t  HEATER_TRIP_INPUT      = 0x01;   // Trip pin
+constexpr uint8_t  HEATER_TRIP_OVER_TEMP  = 0x02;
+constexpr uint8_t  HEATER_TRIP_STALE      = 0x04;
+constexpr uint8_t  HEATER_TRIP_STUCK      = 0x08;
+
+/* Typedefs */
+// Runs in the watchdog task once per trip, after the output is already cut
+typedef void (*heater_trip_fn)(uint8_t cause);
+
+typedef struct heater_safety_status {
+  bool     tripped;
+  uint8_t  cause;           // HEATER_TRIP_* since the last reset
+  uint32_t trips;
+  float    tempC;           // Last good reading
+  uint32_t sampleAgeMs;
+  float    duty;            // What the LEDC channel is set to, pin connected or not
+  uint32_t cutUs;           // Detection to pin low, last trip
+  uint32_t maxCutUs;
+  uint32_t notifyUs;        // Detection to onTrip called, last trip
+  uint32_t checks;
+} heater_safety_status;
+
+/* Public Function Definitions */
+bool heaterSafetyBegin(uint8_t pwmPin, uint8_t pwmChannel, uint32_t pwmMax, heater_trip_fn onTrip);
+void heaterSafetyFeed(bool valid, float tempC);   // Every thermocouple reading, over temperature cuts right here
+bool heaterSafetyTripped();
+bool heaterSafetyReset();                         // PWM 0 and reconnected, only once every cause has cleared
+void heaterSafetyStatus(heater_safety_status* out);
+
+#endif // HEATER_SAFETY_H
@@ -13,6 +13,9 @@
 constexpr uint8_t LED_PIN  = 2;
 constexpr uint8_t OUT1_PIN = 13;   // Primary servo output
 constexpr uint8_t OUT2_PIN = 14;   // Secondary (DS dual-servo use)
+constexpr uint8_t OUT3_PIN = 25;   // Station extras (mixed models)
+constexpr uint8_t OUT4_PIN = 26;
+constexpr uint8_t OUT5_PIN = 27;
 
 // -----------------------------
 // Servo timing constants
@@ -21,8 +24,28 @@ constexpr uint16_t SERVO_FRAME_MS   = 20;    // Typical RC servo frame
 constexpr uint16_t SERVO_NEUTRAL_US = 1500;  // Neutral for continuous
 constexpr uint16_t SERVO_MIN_US     = 500;   // Positional min pulse
 constexpr uint16_t SERVO_MAX_US     = 2500;  // Positional max pulse
+constexpr uint16_t SERVO_CLAMP_MIN_US = 400;   // Hard pulse limits
+constexpr uint16_t SERVO_CLAMP_MAX_US = 2700;
+
+// -----------------------------
+// LEDC backend (hardware 50 Hz pulses)
+// -----------------------------
+constexpr uint8_t  SERVO_LEDC_FIRST_CHANNEL = 8;   // Low-speed group, clear of channel 0/1 users
+constexpr uint8_t  SERVO_MAX_CHANNELS       = 6;
+constexpr uint8_t  SERVO_LEDC_BITS          = 16;  // 20 ms / 65536 = 0.31 us per count
+constexpr uint32_t SERVO_LEDC_FREQ_HZ       = 1000 / SERVO_FRAME_MS;
 
 /* Public Function Definitions */
+// Pulse width to LEDC duty, constant-folds for compile-time pulses
+constexpr uint32_t servoUsToDuty(uint16_t highUs) {
+  return ((uint32_t)highUs << SERVO_LEDC_BITS) / (SERVO_FRAME_MS * 1000U);
+}
+
+bool servoAttach(uint8_t pin);
+bool servoAttachSlot(uint8_t pin, uint8_t slot);   // Fixed channel: SERVO_LEDC_FIRST_CHANNEL + slot
+int  servoChannel(uint8_t pin);                    // LEDC channel, -1 if not attached
+void servoDetach(uint8_t pin);
+void servoWriteUs(uint8_t pin, uint16_t highUs);
 void servoOneFrameWriteUs(uint8_t pin, uint16_t highUs);
 
-#endif // SERVO_UTILS_H
\ No newline at end of file
+#endif // SERVO_UTILS_H
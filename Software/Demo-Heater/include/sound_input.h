@@ -0,0 +1,26 @@
+/* Sound Input Header */
+#ifndef SOUND_INPUT_H
+#define SOUND_INPUT_H
+
+/* Includes */
+#include <Arduino.h>
+#include <driver/adc.h>
+#include "sound_bands.h"
+
+/* Defines */
+
+// -----------------------------
+// Sampling (I2S built-in ADC DMA, owns ADC1 while running). The heater supply
+// rides along in the same pattern table, every other conversion.
+// -----------------------------
+constexpr adc1_channel_t SOUND_ADC_CHANNEL  = ADC1_CHANNEL_6;  // GPIO 34
+constexpr adc1_channel_t SUPPLY_ADC_CHANNEL = ADC1_CHANNEL_7;  // GPIO 35, heater supply divider
+constexpr uint32_t       SUPPLY_DIVIDER_X1000 = 5545;          // 100k / 22k: 12 V -> 2.16 V
+constexpr uint8_t        SOUND_DMA_BUFFERS  = 4;
+
+/* Public Function Definitions */
+bool soundInputBegin(const sound_tone* tones, uint8_t count);
+bool soundInputLatest(sound_bands_result* out);
+uint32_t soundInputSupplyMv();   // Heater supply, mean of the latest block, 0 until measured
+
+#endif // SOUND_INPUT_H
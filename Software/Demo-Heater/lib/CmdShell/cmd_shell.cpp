@@ -0,0 +1,103 @@
+/* Command Shell Driver */
+#ifdef ARDUINO
+
+/* Includes */
+#include <stdio.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "cmd_shell.h"
+
+/* Statics */
+static HardwareSerial* shellPort = NULL;
+static QueueHandle_t lineQueue = NULL;
+static StaticQueue_t lineQueueBuf;
+static uint8_t lineQueueStorage[SHELL_QUEUE_DEPTH * SHELL_LINE_MAX];
+
+// Owned by the UART event task
+static char rxLine[SHELL_LINE_MAX];
+static uint8_t rxLen = 0;
+static bool rxOverflow = false;
+
+// Owned by the polling task
+static char pollLine[SHELL_LINE_MAX];
+
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+static shell_stats stats;
+
+/* Private Function Definitions */
+static inline bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// FUNCTION: Runs in the UART driver's event task whenever bytes arrive,
+// drains them into the line buffer and queues every completed line
+static void onShellReceive() {
+  while (shellPort->available()) {
+    char c = (char)shellPort->read();
+    if (c != '\n') {
+      if (rxLen < SHELL_LINE_MAX - 1) rxLine[rxLen++] = c;
+      else rxOverflow = true;
+      continue;
+    }
+
+    rxLine[rxLen] = '\0';
+    bool queued = !rxOverflow && xQueueSend(lineQueue, rxLine, 0) == pdTRUE;
+    portENTER_CRITICAL(&statsMux);
+    if (rxOverflow)   stats.overflows++;
+    else if (!queued) stats.queueFull++;
+    else              stats.lines++;
+    portEXIT_CRITICAL(&statsMux);
+    rxLen = 0;
+    rxOverflow = false;
+  }
+}
+
+/* Public Function Definitions */
+bool shellBegin(HardwareSerial& port) {
+  if (!lineQueue) {
+    lineQueue = xQueueCreateStatic(SHELL_QUEUE_DEPTH, SHELL_LINE_MAX, lineQueueStorage, &lineQueueBuf);
+  }
+  if (!lineQueue) return false;
+  shellPort = &port;
+  port.onReceive(onShellReceive);
+  return true;
+}
+
+char* shellGetLine() {
+  if (!lineQueue || xQueueReceive(lineQueue, pollLine, 0) != pdTRUE) return NULL;
+
+  // Trim in place
+  char* start = pollLine;
+  while (isBlank(*start)) start++;
+  char* end = start + strlen(start);
+  while (end > start && isBlank(end[-1])) *--end = '\0';
+  return start;
+}
+
+// FUNCTION: Handle at most one pending line, never blocks.
+// Empty lines are ignored, unknown commands go to fallback (or get the help text).
+bool shellPoll(const shell_cmd* table, uint8_t count, shell_handler fallback) {
+  char* line = shellGetLine();
+  if (!line) return false;
+  if (!shellDispatch(line, table, count, fallback)) shellHelp(table, count);
+  return true;
+}
+
+void shellHelp(const shell_cmd* table, uint8_t count) {
+  if (!shellPort) return;
+  shellPort->print("Commands:\n");
+  char line[SHELL_LINE_MAX * 2];    // Print::printf() goes to the heap past 64 characters
+  for (uint8_t i = 0; i < count; ++i) {
+    snprintf(line, sizeof(line), "  %-6s %s\n", table[i].name, table[i].usage ? table[i].usage : "");
+    shellPort->print(line);
+  }
+}
+
+void shellStats(shell_stats* out) {
+  portENTER_CRITICAL(&statsMux);
+  *out = stats;
+  portEXIT_CRITICAL(&statsMux);
+}
+
+#endif // ARDUINO
@@ -0,0 +1,63 @@
+/* Command Shell Parsing */
+
+/* Includes */
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include "cmd_shell.h"
+
+/* Private Function Definitions */
+static inline bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/* Public Function Definitions */
+// FUNCTION: Tokenize a trimmed line and run its command. Empty lines count as handled.
+bool shellDispatch(char* line, const shell_cmd* table, uint8_t count, shell_handler fallback) {
+  char* argv[SHELL_MAX_ARGS];
+  int argc = shellTokenize(line, argv, SHELL_MAX_ARGS);
+  if (!argc) return true;
+
+  for (uint8_t i = 0; i < count; ++i) {
+    if (strcasecmp(argv[0], table[i].name) == 0) {
+      table[i].fn(argc, argv);
+      return true;
+    }
+  }
+  if (!fallback) return false;
+  fallback(argc, argv);
+  return true;
+}
+
+// FUNCTION: Split on blanks by writing terminators into the line, extra tokens stay
+// attached to the last argument
+int shellTokenize(char* line, char** argv, uint8_t maxArgs) {
+  int argc = 0;
+  char* p = line;
+  while (*p && argc < maxArgs) {
+    while (isBlank(*p)) p++;
+    if (!*p) break;
+    argv[argc++] = p;
+    if (argc == maxArgs) break;
+    while (*p && !isBlank(*p)) p++;
+    if (*p) *p++ = '\0';
+  }
+  return argc;
+}
+
+char* shellJoin(int argc, char** argv) {
+  if (argc <= 0) return NULL;
+  for (int i = 0; i + 1 < argc; ++i) {
+    argv[i][strlen(argv[i])] = ' ';
+  }
+  return argv[0];
+}
+
+bool shellParseInt(const char* s, long* out) {
+  if (!s || !*s) return false;
+  char* end;
+  long v = strtol(s, &end, 10);
+  if (*end) return false;
+  *out = v;
+  return true;
+}
@@ -0,0 +1,65 @@
+/* Fader Follow Driver */
+
+/* Includes */
+#include <string.h>
+#include "hal.h"
+#include "fader_follow.h"
+
+/* Statics */
+static fader_follow_fn followFn = NULL;
+static fader_link_rx rx;
+static hal_lock followMux = HAL_LOCK_INIT;
+static fader_follow_stats stats = {};
+
+/* Public Function Definitions */
+void faderFollowBegin(fader_follow_fn fn) {
+  followFn = fn;
+}
+
+// FUNCTION: Called from the ESP-NOW receive callback (WiFi task), returns false if it
+// isn't a fader position. The output changes here, the echo leaves right after.
+bool faderFollowOnRecv(const uint8_t* mac, const uint8_t* data, int len) {
+  if (!faderLinkIsPos(data, len)) return false;
+
+  uint32_t rxUs = halMicros();
+  fader_link_pos pkt;
+  memcpy(&pkt, data, sizeof(pkt));
+  bool fresh = faderLinkRxAccept(&rx, pkt.seq, rxUs);
+  if (fresh && followFn) followFn(pkt.axis, pkt.pos, pkt.flags);
+  uint32_t applyUs = halMicros() - rxUs;
+
+  bool echo = fresh && (pkt.flags & FADER_LINK_WANT_ECHO);
+  halLock(&followMux);
+  if (fresh) {
+    stats.received++;
+    stats.lastPos = pkt.pos;
+    stats.lastFlags = pkt.flags;
+    stats.lastApplyUs = applyUs;
+    if (applyUs > stats.maxApplyUs) stats.maxApplyUs = applyUs;
+  } else {
+    stats.stale++;
+  }
+  if (echo) stats.echoes++;
+  halUnlock(&followMux);
+
+  if (echo) {
+    fader_link_echo reply = {};
+    reply.magic = FADER_LINK_MAGIC;
+    reply.op = FADER_LINK_OP_ECHO;
+    reply.seq = pkt.seq;
+    reply.axis = pkt.axis;
+    reply.pos = pkt.pos;
+    reply.sampledUs = pkt.sampledUs;
+    reply.sentUs = pkt.sentUs;
+    reply.rxToApplyUs = applyUs;
+    halRadioSend(mac, (const uint8_t*)&reply, sizeof(reply));
+  }
+  return true;
+}
+
+void faderFollowStats(fader_follow_stats* out) {
+  halLock(&followMux);
+  *out = stats;
+  halUnlock(&followMux);
+  out->linkUp = !faderLinkRxLost(&rx, halMicros());
+}
@@ -0,0 +1,29 @@
+/* Fader Follow Header */
+#ifndef FADER_FOLLOW_H
+#define FADER_FOLLOW_H
+
+/* Includes */
+#include <stdint.h>
+#include "fader_link.h"
+
+/* Typedefs */
+// Runs in the ESP-NOW receive callback for every fresh position, keep it short
+typedef void (*fader_follow_fn)(uint8_t axis, uint16_t pos, uint8_t flags);
+
+typedef struct fader_follow_stats {
+  uint32_t received;
+  uint32_t stale;           // Duplicate or overtaken
+  uint32_t echoes;
+  uint16_t lastPos;
+  uint8_t  lastFlags;
+  bool     linkUp;
+  uint32_t lastApplyUs;     // Receive to output written
+  uint32_t maxApplyUs;
+} fader_follow_stats;
+
+/* Public Function Definitions */
+void faderFollowBegin(fader_follow_fn fn);
+bool faderFollowOnRecv(const uint8_t* mac, const uint8_t* data, int len);   // ESP-NOW receive callback
+void faderFollowStats(fader_follow_stats* out);
+
+#endif // FADER_FOLLOW_H
@@ -0,0 +1,146 @@
+/* Fader Link Header */
+#ifndef FADER_LINK_H
+#define FADER_LINK_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// ESP-NOW fader stream, Demo-FlyingFader -> followers (Chef heater PWM, another fader).
+// Shared by both projects, keep the copies identical.
+// -----------------------------
+constexpr uint8_t  FADER_LINK_MAGIC        = 0xA6;    // First byte, not LINK_MAGIC, never a printable struct_message
+constexpr uint16_t FADER_LINK_POS_MAX      = 65535;   // Same scale as FADER_POS_MAX
+constexpr uint16_t FADER_LINK_MIN_STEP     = 64;      // Smallest change worth a packet, 0.1 % ...
+constexpr uint8_t  FADER_LINK_NOISE_STEPS  = 3;       // ... or 3 sigma of the position noise
+constexpr uint32_t FADER_LINK_MIN_GAP_US   = 2000;    // Rate limit, 500 packets/s at most
+constexpr uint32_t FADER_LINK_HEARTBEAT_US = 100000;  // Resend the last value when idle: repairs lost packets
+constexpr uint32_t FADER_LINK_LOST_US      = 350000;  // Follower: no packet for this long, stream lost
+constexpr uint8_t  FADER_LINK_ECHO_EVERY   = 8;       // Ask every Nth packet for a latency echo
+constexpr uint32_t FADER_LINK_TARGET_US    = 10000;   // Glass-to-glass goal
+
+// Packet flags
+constexpr uint8_t FADER_LINK_TOUCHED       = 0x01;    // Hand on the knob
+constexpr uint8_t FADER_LINK_WANT_ECHO     = 0x02;
+constexpr uint8_t FADER_LINK_HEARTBEAT     = 0x04;    // Unchanged value, resent
+
+/* Typedefs */
+enum fader_link_op : uint8_t {
+  FADER_LINK_OP_POS  = 0,
+  FADER_LINK_OP_ECHO = 0x80,
+};
+
+typedef struct __attribute__((packed)) fader_link_pos {
+  uint8_t  magic;
+  uint8_t  op;          // FADER_LINK_OP_POS
+  uint16_t seq;
+  uint8_t  axis;
+  uint8_t  flags;       // FADER_LINK_*
+  uint16_t pos;         // 0..FADER_LINK_POS_MAX
+  uint32_t sampledUs;   // Sender clock: the control tick that read the wiper
+  uint32_t sentUs;      // Sender clock: handed to the radio
+} fader_link_pos;
+
+typedef struct __attribute__((packed)) fader_link_echo {
+  uint8_t  magic;
+  uint8_t  op;          // FADER_LINK_OP_ECHO
+  uint16_t seq;
+  uint8_t  axis;
+  uint8_t  reserved;
+  uint16_t pos;         // As applied
+  uint32_t sampledUs;   // Copied from the packet being answered
+  uint32_t sentUs;
+  uint32_t rxToApplyUs; // Follower: receive to output change (upper bound)
+} fader_link_echo;
+
+// Sender: what went out last
+typedef struct fader_link_tx {
+  bool     primed;
+  uint16_t lastPos;
+  uint32_t lastUs;
+  uint16_t seq;
+  uint8_t  sinceEcho;
+} fader_link_tx;
+
+// Follower: what came in last
+typedef struct fader_link_rx {
+  bool     primed;
+  uint16_t lastSeq;
+  uint32_t lastUs;
+} fader_link_rx;
+
+enum fader_link_send : uint8_t {
+  FADER_LINK_SKIP = 0,
+  FADER_LINK_SEND_CHANGE,
+  FADER_LINK_SEND_HEARTBEAT,
+};
+
+/* Public Function Definitions */
+inline bool faderLinkIsPos(const uint8_t* data, int len) {
+  return len == (int)sizeof(fader_link_pos) && data[0] == FADER_LINK_MAGIC && data[1] == FADER_LINK_OP_POS;
+}
+
+inline bool faderLinkIsEcho(const uint8_t* data, int len) {
+  return len == (int)sizeof(fader_link_echo) && data[0] == FADER_LINK_MAGIC && data[1] == FADER_LINK_OP_ECHO;
+}
+
+// Change threshold: noise must not keep the radio busy, a real move must
+inline uint16_t faderLinkStep(uint16_t posNoise) {
+  uint32_t step = (uint32_t)posNoise * FADER_LINK_NOISE_STEPS;
+  return (step > FADER_LINK_MIN_STEP) ? (uint16_t)step : FADER_LINK_MIN_STEP;
+}
+
+// FUNCTION: Delta/threshold compression with a rate limit. A change past step goes out
+// at once unless the last packet left less than FADER_LINK_MIN_GAP_US ago, then on a
+// later call; smaller changes and silence ride on the heartbeat.
+inline uint8_t faderLinkTxDecide(const fader_link_tx* tx, uint16_t pos, uint16_t step, uint32_t nowUs) {
+  if (!tx->primed) return FADER_LINK_SEND_CHANGE;
+  uint32_t elapsed = nowUs - tx->lastUs;
+  uint16_t delta = (pos > tx->lastPos) ? pos - tx->lastPos : tx->lastPos - pos;
+  if (delta >= step && elapsed >= FADER_LINK_MIN_GAP_US) return FADER_LINK_SEND_CHANGE;
+  if (elapsed >= FADER_LINK_HEARTBEAT_US) return FADER_LINK_SEND_HEARTBEAT;
+  return FADER_LINK_SKIP;
+}
+
+// Fills the packet and records it as sent
+inline void faderLinkTxStamp(fader_link_tx* tx, fader_link_pos* pkt, uint8_t axis, uint16_t pos,
+                             uint8_t flags, uint32_t sampledUs, uint32_t nowUs) {
+  if (++tx->sinceEcho >= FADER_LINK_ECHO_EVERY) {
+    tx->sinceEcho = 0;
+    flags |= FADER_LINK_WANT_ECHO;
+  }
+  pkt->magic = FADER_LINK_MAGIC;
+  pkt->op = FADER_LINK_OP_POS;
+  pkt->seq = ++tx->seq;
+  pkt->axis = axis;
+  pkt->flags = flags;
+  pkt->pos = pos;
+  pkt->sampledUs = sampledUs;
+  pkt->sentUs = nowUs;
+  tx->primed = true;
+  tx->lastPos = pos;
+  tx->lastUs = nowUs;
+}
+
+// FUNCTION: Drops duplicates and packets overtaken by a newer one (seq wraps)
+inline bool faderLinkRxAccept(fader_link_rx* rx, uint16_t seq, uint32_t nowUs) {
+  bool lost = !rx->primed || nowUs - rx->lastUs >= FADER_LINK_LOST_US;   // Sender restarted, any seq goes
+  if (!lost && (int16_t)(seq - rx->lastSeq) <= 0) return false;
+  rx->primed = true;
+  rx->lastSeq = seq;
+  rx->lastUs = nowUs;
+  return true;
+}
+
+inline bool faderLinkRxLost(const fader_link_rx* rx, uint32_t nowUs) {
+  return !rx->primed || nowUs - rx->lastUs >= FADER_LINK_LOST_US;
+}
+
+// FUNCTION: Sender side, from an echo: wiper sample to follower output.
+// Sample to send on the sender's clock, half the round trip for the air, the follower's own part.
+inline uint32_t faderLinkGlassToGlassUs(const fader_link_echo* echo, uint32_t nowUs) {
+  return (echo->sentUs - echo->sampledUs) + (nowUs - echo->sentUs) / 2 + echo->rxToApplyUs;
+}
+
+#endif // FADER_LINK_H
@@ -0,0 +1,257 @@
+/* HAL Native Fakes */
+#ifndef ARDUINO
+
+/* Includes */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include "hal.h"
+
+/* Typedefs */
+struct hal_fake_timer {
+  bool used;
+  bool armed;
+  uint32_t periodUs;        // 0: one-shot
+  uint64_t dueUs;
+  hal_timer_fn fn;
+  void* arg;
+  const char* name;
+};
+
+struct hal_fake_task {
+  hal_task_fn fn;
+  void* arg;
+  const char* name;
+  uint32_t notified;
+};
+
+/* Statics */
+static uint64_t clockUs = 0;
+static bool stopped = false;
+static hal_fake_timer timers[HAL_FAKE_TIMERS];
+static hal_fake_task tasks[HAL_FAKE_TASKS];
+static uint8_t taskCount = 0;
+
+static bool pinLevel[HAL_PINS];
+static uint16_t adcRaw[HAL_PINS];
+static uint32_t pwmDuty[HAL_PWM_CHANNELS];
+
+static uint32_t heapAllocs = 0;
+static uint32_t heapMark = 0;
+static int32_t heapBlocks = 0;
+static int32_t heapMarkBlocks = 0;
+
+static hal_radio_rx_fn radioRx = NULL;
+static hal_fake_radio_fn radioTx = NULL;
+static uint8_t radioMac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+/* Private Function Definitions */
+// FUNCTION: Earliest armed timer due by untilUs, NULL if none
+static hal_fake_timer* nextDue(uint64_t untilUs) {
+  hal_fake_timer* next = NULL;
+  for (uint8_t i = 0; i < HAL_FAKE_TIMERS; ++i) {
+    hal_fake_timer* t = &timers[i];
+    if (t->armed && t->dueUs <= untilUs && (!next || t->dueUs < next->dueUs)) next = t;
+  }
+  return next;
+}
+
+// FUNCTION: glibc's allocator, counted. The program's definitions win over libc's
+// for every caller, the C++ runtime's operator new included.
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void  __libc_free(void* p);
+
+void* malloc(size_t size) noexcept {
+  heapAllocs++;
+  void* p = __libc_malloc(size);
+  if (p) heapBlocks++;
+  return p;
+}
+
+void* calloc(size_t n, size_t size) noexcept {
+  heapAllocs++;
+  void* p = __libc_calloc(n, size);
+  if (p) heapBlocks++;
+  return p;
+}
+
+void* realloc(void* p, size_t size) noexcept {
+  heapAllocs++;
+  void* q = __libc_realloc(p, size);
+  if (!p && q)              heapBlocks++;
+  else if (p && !size)      heapBlocks--;   // realloc(p, 0) frees
+  return q;
+}
+
+void free(void* p) noexcept {
+  if (p) heapBlocks--;
+  __libc_free(p);
+}
+}
+#endif
+
+/* Public Function Definitions */
+uint32_t halMicros()                { return (uint32_t)clockUs; }
+uint32_t halMillis()                { return (uint32_t)(clockUs / 1000); }
+uint32_t halCpuMHz()                { return 1000; }
+void     halDelayMs(uint32_t ms)    { halFakeAdvanceUs((uint64_t)ms * 1000); }
+
+uint32_t halCycles() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+// Single threaded: a lock only has to nest correctly
+void halLockInit(hal_lock* lock)    { lock->depth = 0; }
+void halLock(hal_lock* lock)        { lock->depth++; }
+void halUnlock(hal_lock* lock)      { lock->depth--; }
+
+void halPinOutput(uint8_t pin)                { }
+void halPinInput(uint8_t pin, bool pullUp)    { if (pin < HAL_PINS) pinLevel[pin] = pullUp; }
+void halPinWrite(uint8_t pin, bool high)      { if (pin < HAL_PINS) pinLevel[pin] = high; }
+bool halPinRead(uint8_t pin)                  { return pin < HAL_PINS && pinLevel[pin]; }
+
+bool     halPwmSetup(uint8_t channel, uint32_t hz, uint8_t bits) { return channel < HAL_PWM_CHANNELS && bits <= 20; }
+void     halPwmAttach(uint8_t pin, uint8_t channel)              { }
+void     halPwmWrite(uint8_t channel, uint32_t duty)             { if (channel < HAL_PWM_CHANNELS) pwmDuty[channel] = duty; }
+uint32_t halPwmRead(uint8_t channel)                             { return (channel < HAL_PWM_CHANNELS) ? pwmDuty[channel] : 0; }
+
+uint16_t halAdcRead(uint8_t pin)    { return (pin < HAL_PINS) ? adcRaw[pin] : 0; }
+uint32_t halAdcReadMv(uint8_t pin)  { return (uint32_t)halAdcRead(pin) * 3300 / 4095; }
+
+bool halTimerCreate(hal_timer_fn fn, void* arg, const char* name, hal_timer* out) {
+  for (uint8_t i = 0; i < HAL_FAKE_TIMERS; ++i) {
+    if (timers[i].used) continue;
+    timers[i] = { true, false, 0, 0, fn, arg, name };
+    *out = &timers[i];
+    return true;
+  }
+  return false;
+}
+
+bool halTimerStartPeriodic(hal_timer timer, uint32_t periodUs) {
+  if (timer->armed || !periodUs) return false;
+  timer->armed = true;
+  timer->periodUs = periodUs;
+  timer->dueUs = clockUs + periodUs;
+  return true;
+}
+
+bool halTimerStartOnce(hal_timer timer, uint32_t delayUs) {
+  if (timer->armed) return false;
+  timer->armed = true;
+  timer->periodUs = 0;
+  timer->dueUs = clockUs + delayUs;
+  return true;
+}
+
+void halTimerStop(hal_timer timer) {
+  timer->armed = false;
+}
+
+bool halRadioBegin(hal_radio_rx_fn rx) {
+  radioRx = rx;
+  return true;
+}
+
+bool halRadioSend(const uint8_t* mac, const uint8_t* data, int len) {
+  if (len <= 0 || len > HAL_RADIO_MAX_LEN) return false;
+  if (radioTx) radioTx(mac, data, len);
+  return true;
+}
+
+void halRadioMac(uint8_t* mac) {
+  memcpy(mac, radioMac, 6);
+}
+
+bool halTaskStart(hal_task_fn fn, void* arg, const char* name, hal_task_mem* mem, uint8_t priority, int8_t core, hal_task* out) {
+  if (taskCount >= HAL_FAKE_TASKS) return false;
+  tasks[taskCount] = { fn, arg, name, 0 };
+  *out = &tasks[taskCount++];
+  return true;
+}
+
+void halTaskNotify(hal_task task)           { task->notified++; }
+void halTaskNotifyFromIsr(hal_task task)    { task->notified++; }
+
+// FUNCTION: Nothing to wait for without a scheduler, the timeout just passes
+uint32_t halTaskWait(uint32_t timeoutMs) {
+  if (timeoutMs != HAL_WAIT_FOREVER) halFakeAdvanceUs((uint64_t)timeoutMs * 1000);
+  return 0;
+}
+
+bool halQueueInit(hal_queue* q, void* storage, uint16_t itemSize, uint16_t depth) {
+  *q = { (uint8_t*)storage, itemSize, depth, 0, 0 };
+  return storage && itemSize && depth;
+}
+
+bool halQueueSend(hal_queue* q, const void* item) {
+  if (q->count >= q->depth) return false;
+  uint16_t tail = (q->head + q->count) % q->depth;
+  memcpy(q->storage + (size_t)tail * q->itemSize, item, q->itemSize);
+  q->count++;
+  return true;
+}
+
+bool halQueueReceive(hal_queue* q, void* item) {
+  if (!q->count) return false;
+  memcpy(item, q->storage + (size_t)q->head * q->itemSize, q->itemSize);
+  q->head = (q->head + 1) % q->depth;
+  q->count--;
+  return true;
+}
+
+void halConsoleBegin(uint32_t baud) { }
+void halPrint(const char* s)         { fputs(s, stdout); }
+
+void halPrintf(const char* fmt, ...) {
+  char line[HAL_PRINTF_MAX];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+  fputs(line, stdout);
+}
+
+uint32_t halHeapAllocs()            { return heapAllocs; }
+uint32_t halHeapSinceMark()         { return heapAllocs - heapMark; }
+int32_t  halHeapBlocksSinceMark()   { return heapBlocks - heapMarkBlocks; }
+
+void halHeapMark() {
+  heapMark = heapAllocs;
+  heapMarkBlocks = heapBlocks;
+}
+
+// FUNCTION: Step through every timer due on the way, each sees the clock at its own deadline
+void halFakeAdvanceUs(uint64_t us) {
+  uint64_t untilUs = clockUs + us;
+  hal_fake_timer* t;
+  while ((t = nextDue(untilUs)) != NULL) {
+    clockUs = t->dueUs;
+    if (t->periodUs) t->dueUs += t->periodUs;
+    else             t->armed = false;
+    t->fn(t->arg);
+  }
+  clockUs = untilUs;
+}
+
+uint64_t halFakeNowUs()                         { return clockUs; }
+void     halFakePinSet(uint8_t pin, bool high)  { if (pin < HAL_PINS) pinLevel[pin] = high; }
+void     halFakeAdcSet(uint8_t pin, uint16_t raw) { if (pin < HAL_PINS) adcRaw[pin] = raw; }
+void     halFakeSetMac(const uint8_t* mac)      { memcpy(radioMac, mac, 6); }
+void     halFakeRadioSetTx(hal_fake_radio_fn fn) { radioTx = fn; }
+uint32_t halFakeNotified(hal_task task)         { return task->notified; }
+void     halFakeStop()                          { stopped = true; }
+bool     halFakeStopped()                       { return stopped; }
+
+void halFakeRadioRx(const uint8_t* mac, const uint8_t* data, int len) {
+  if (radioRx) radioRx(mac, data, len);
+}
+
+#endif // ARDUINO
@@ -0,0 +1,62 @@
+/* Heater Dose */
+
+/* Includes */
+#include "heater_dose.h"
+
+/* Public Function Definitions */
+void heaterDoseStart(heater_dose* d, const heater_dose_cfg* cfg) {
+  *d = heater_dose();
+  d->cfg = *cfg;
+  if (d->cfg.density <= 0.0f || d->cfg.density > 1.0f) d->cfg.density = 1.0f;
+  d->result = HEATER_DOSE_RUNNING;
+}
+
+float heaterDoseSlot(heater_dose* d, float supplyV, float slotS) {
+  if (d->result != HEATER_DOSE_RUNNING) return 0.0f;
+
+  if (supplyV <= 0.0f) {
+    d->result = HEATER_DOSE_NO_SUPPLY;
+    d->duty = 0.0f;
+    return 0.0f;
+  }
+
+  // 1. Book the slot that just ended
+  float fullJ = supplyV * supplyV / d->cfg.elementOhm * slotS;
+  d->deliveredJ += d->duty * fullJ;
+  d->elapsedS += (d->slots > 0) ? slotS : 0.0f;
+
+  // 2. Done?
+  float missingJ = d->cfg.targetJ - d->deliveredJ;
+  if (missingJ <= 0.0f) {
+    d->result = HEATER_DOSE_DONE;
+    d->duty = 0.0f;
+    return 0.0f;
+  }
+  if (d->elapsedS * 1000.0f >= (float)d->cfg.timeoutMs) {
+    d->result = HEATER_DOSE_TIMEOUT;
+    d->duty = 0.0f;
+    return 0.0f;
+  }
+
+  // 3. Next slot: on or off by the burst density, the last one on only as long as needed
+  d->slots++;
+  d->sigma += d->cfg.density;
+  if (d->sigma >= 1.0f) {
+    d->sigma -= 1.0f;
+    d->onSlots++;
+    d->duty = (missingJ < fullJ) ? missingJ / fullJ : 1.0f;
+  } else {
+    d->duty = 0.0f;
+  }
+  return d->duty;
+}
+
+void heaterDoseAbort(heater_dose* d) {
+  if (d->result == HEATER_DOSE_RUNNING) d->result = HEATER_DOSE_ABORTED;
+  d->duty = 0.0f;
+}
+
+const char* heaterDoseName(uint8_t result) {
+  static const char* const names[] = { "running", "done", "timed out", "aborted", "no supply", "rejected" };
+  return (result < sizeof(names) / sizeof(names[0])) ? names[result] : "?";
+}
@@ -0,0 +1,46 @@
+/* Heater Dose Header */
+#ifndef HEATER_DOSE_H
+#define HEATER_DOSE_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Typedefs */
+// Brand by delivered energy, not by time: the same Joules whatever the supply does
+typedef struct heater_dose_cfg {
+  float    targetJ;         // Energy into the element
+  float    elementOhm;      // P = V^2 / R while on
+  float    density;         // Burst-fire: fraction of slots on, 1 = shortest dose
+  uint32_t timeoutMs;       // Give up, whatever got delivered
+} heater_dose_cfg;
+
+enum heater_dose_result : uint8_t {
+  HEATER_DOSE_RUNNING = 0,
+  HEATER_DOSE_DONE,
+  HEATER_DOSE_TIMEOUT,
+  HEATER_DOSE_ABORTED,
+  HEATER_DOSE_NO_SUPPLY,    // Supply reading lost, delivered energy unknown from here
+  HEATER_DOSE_REJECTED,     // Never started: heater off, faulted or dosing already
+};
+
+typedef struct heater_dose {
+  heater_dose_cfg cfg;
+  float    deliveredJ;
+  float    elapsedS;
+  float    sigma;           // Burst distribution, first-order sigma-delta
+  float    duty;            // Of the slot running now
+  uint32_t slots;
+  uint32_t onSlots;
+  uint8_t  result;          // heater_dose_result
+} heater_dose;
+
+/* Public Function Definitions */
+void  heaterDoseStart(heater_dose* d, const heater_dose_cfg* cfg);
+// At every slot boundary: books the slot that ended (slotS long, at supplyV) and returns
+// the duty of the next one. Whole slots on or off; the last one on is cut to what is
+// still missing. The first call after start books nothing, slotS is the nominal slot.
+float heaterDoseSlot(heater_dose* d, float supplyV, float slotS);
+void  heaterDoseAbort(heater_dose* d);
+const char* heaterDoseName(uint8_t result);
+
+#endif // HEATER_DOSE_H
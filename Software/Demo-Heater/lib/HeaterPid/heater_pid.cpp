@@ -0,0 +1,80 @@
+/* Heater PID */
+
+/* Includes */
+#include "heater_pid.h"
+
+/* Private Function Definitions */
+static inline float clampf(float v, float lo, float hi) {
+  return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+/* Public Function Definitions */
+void heaterPidInit(heater_pid* p, const heater_pid_cfg* cfg, float dtS) {
+  *p = heater_pid();
+  p->cfg = *cfg;
+  p->dtS = dtS;
+  p->target = cfg->ambientC;
+  p->setpoint = cfg->ambientC;
+}
+
+void heaterPidSetTarget(heater_pid* p, float targetC, float rampCPerS, float tempC) {
+  p->target = targetC;
+  p->rampCPerS = rampCPerS;
+  // A ramp starts where the heater is, not where the last one ended
+  if (rampCPerS > 0.0f) p->setpoint = tempC;
+}
+
+void heaterPidReset(heater_pid* p) {
+  p->primed = false;
+  p->integ = 0.0f;
+  p->dFilt = 0.0f;
+  p->duty = 0.0f;
+}
+
+// FUNCTION: Feed-forward carries the steady state, P and D shape the approach, the
+// integrator only trims the last degrees. Far below the setpoint P saturates: full
+// power; D on the measured rise backs off before the sensor lag turns into overshoot.
+float heaterPidStep(heater_pid* p, float tempC) {
+  const heater_pid_cfg& c = p->cfg;
+  float dt = p->dtS;
+
+  // 1. Setpoint ramp
+  float prevSp = p->setpoint;
+  if (p->rampCPerS > 0.0f) {
+    float stepC = p->rampCPerS * dt;
+    if (p->setpoint < p->target) p->setpoint = (p->target - p->setpoint > stepC) ? p->setpoint + stepC : p->target;
+    else                         p->setpoint = (p->setpoint - p->target > stepC) ? p->setpoint - stepC : p->target;
+  } else {
+    p->setpoint = p->target;
+  }
+  p->spRate = (p->rampCPerS > 0.0f) ? (p->setpoint - prevSp) / dt : 0.0f;
+
+  // 2. Filtered rate of rise
+  if (!p->primed) {
+    p->prevTemp = tempC;
+    p->dFilt = 0.0f;
+    p->primed = true;
+  }
+  float rate = (tempC - p->prevTemp) / dt;
+  p->prevTemp = tempC;
+  p->dFilt += (rate - p->dFilt) * dt / (c.dFilterS + dt);
+
+  // 3. Terms
+  float err = p->setpoint - tempC;
+  p->ff = c.kff * (p->setpoint - c.ambientC) + c.kffRate * p->spRate;
+  if (p->ff < 0.0f) p->ff = 0.0f;
+  p->p = c.kp * err;
+  p->d = -c.kd * p->dFilt;
+  float u = p->ff + p->p + p->integ + p->d;
+
+  // 4. Anti-windup: integrate inside the band, and never further into saturation
+  bool inBand = err < c.iBandC && err > -c.iBandC;
+  bool pushHigh = u >= c.maxDuty && err > 0.0f;
+  bool pushLow = u <= 0.0f && err < 0.0f;
+  if (inBand && !pushHigh && !pushLow) {
+    p->integ = clampf(p->integ + c.ki * err * dt, -c.integMax, c.integMax);
+  }
+
+  p->duty = clampf(p->ff + p->p + p->integ + p->d, 0.0f, c.maxDuty);
+  return p->duty;
+}
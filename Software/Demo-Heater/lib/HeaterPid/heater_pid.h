@@ -0,0 +1,75 @@
+/* Heater PID Header */
+#ifndef HEATER_PID_H
+#define HEATER_PID_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Typedefs */
+// Duty is a fraction 0..maxDuty, temperatures in degrees C, time in seconds
+typedef struct heater_pid_cfg {
+  float kp;             // Duty per C of error
+  float ki;             // Duty per C*s
+  float kd;             // Duty per C/s, on the measurement: brakes the rise, no setpoint kick
+  float kff;            // Feed-forward, steady-state duty per C above ambient (losses) ...
+  float kffRate;        // ... plus duty per C/s of setpoint ramp (heat capacity)
+  float dFilterS;       // Derivative low-pass time constant
+  float iBandC;         // Integrate only this close to the setpoint, full power outside it
+  float integMax;       // Integrator trims the feed-forward by at most this much duty
+  float maxDuty;
+  float ambientC;
+} heater_pid_cfg;
+
+/* Constants */
+// -----------------------------
+// Loop tuning, duty 0..1. Shared by the firmware and the host simulator.
+// -----------------------------
+constexpr uint8_t HEATER_SAMPLE_HZ = 10;     // The MAX31855 converts in 100 ms
+
+constexpr heater_pid_cfg HEATER_PID_DEFAULTS = {
+  0.08f,                // kp: full power 12 C below the setpoint
+  0.004f,               // ki
+  0.15f,                // kd: brake at ~7 C/s of rise
+  0.0025f,              // kff: 50 % holds 200 C over ambient
+  0.02f,                // kffRate
+  0.5f,                 // dFilterS
+  8.0f,                 // iBandC
+  0.15f,                // integMax
+  1.0f,                 // maxDuty
+  22.0f,                // ambientC
+};
+
+/* Typedefs */
+// A setpoint, how to get there, and when it counts as reached
+typedef struct heater_profile {
+  float    setpointC;
+  float    rampCPerS;   // 0: step, as fast as the heater goes
+  float    bandC;       // At temperature within +-bandC ...
+  uint32_t soakMs;      // ... for this long: ready
+} heater_profile;
+
+typedef struct heater_pid {
+  heater_pid_cfg cfg;
+  float dtS;
+  bool  primed;
+  float target;         // Where the profile ends
+  float rampCPerS;
+  float setpoint;       // Ramped toward target
+  float spRate;         // C/s, this step
+  float prevTemp;
+  float dFilt;          // Filtered dT/dt
+  float integ;
+  float duty;
+  // Last step, for tuning
+  float ff;
+  float p;
+  float d;
+} heater_pid;
+
+/* Public Function Definitions */
+void  heaterPidInit(heater_pid* p, const heater_pid_cfg* cfg, float dtS);
+void  heaterPidSetTarget(heater_pid* p, float targetC, float rampCPerS, float tempC);   // Ramp starts at tempC
+void  heaterPidReset(heater_pid* p);     // Forget history, duty 0
+float heaterPidStep(heater_pid* p, float tempC);   // One sample, returns the duty
+
+#endif // HEATER_PID_H
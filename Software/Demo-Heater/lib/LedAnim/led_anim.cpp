@@ -0,0 +1,106 @@
+/* LED Animation Engine Driver */
+
+/* Includes */
+#include "hal.h"
+#include "led_anim.h"
+#include "led_output.h"
+
+/* Statics */
+static hal_timer animTimer = NULL;
+static uint8_t statusLedPin = 0;
+static uint32_t frameCount = 0;
+
+// Written by the application, read by the frame timer (32-bit, single writer)
+static volatile uint32_t targetQ16 = 0;
+static volatile uint32_t stageColor = 0;    // 0x00RRGGBB
+static volatile bool errorActive = false;
+
+// Owned by the frame timer
+static uint32_t currentQ16 = 0;
+static uint16_t ditherAcc = 0;
+static uint8_t frameBuf[GAUGE_FRAME_SIZE];
+
+/* Private Function Definitions */
+static inline uint32_t msToFrames(uint16_t ms) {
+  return ((uint32_t)ms * LED_ANIM_FPS) / 1000U;
+}
+
+// FUNCTION: Frame timer, compose and hand off to the RMT output
+static void onFrame(void* arg) {
+  bool statusOn = ledAnimCompose(frameCount++, frameBuf);
+  ledOutputShow(frameBuf);
+  halPinWrite(statusLedPin, statusOn);
+}
+
+/* Public Function Definitions */
+bool ledAnimBegin(uint8_t neopixelPin, uint8_t statusPin) {
+  statusLedPin = statusPin;
+  halPinOutput(statusLedPin);
+  if (!ledOutputBegin(neopixelPin, GAUGE_PIXELS)) return false;
+  if (!halTimerCreate(onFrame, NULL, "led_anim", &animTimer)) return false;
+  return halTimerStartPeriodic(animTimer, 1000000UL / LED_ANIM_FPS);
+}
+
+void ledAnimSetGauge(uint16_t levelQ16) {
+  targetQ16 = levelQ16;
+}
+
+void ledAnimSetStageColor(uint8_t r, uint8_t g, uint8_t b) {
+  stageColor = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+void ledAnimSetError(bool error) {
+  errorActive = error;
+}
+
+// Returns the status LED state for this frame
+bool ledAnimCompose(uint32_t frame, uint8_t* grb) {
+  // 1. Ease towards the target level
+  const int32_t target = (int32_t)targetQ16;
+  int32_t delta = ((target - (int32_t)currentQ16) * LED_ANIM_EASE_Q8) / 256;
+  if (delta == 0 && target != (int32_t)currentQ16) delta = (target > (int32_t)currentQ16) ? 1 : -1;
+  currentQ16 = (uint32_t)((int32_t)currentQ16 + delta);
+
+  // 2. Position in 1/256 steps, temporal dithering between neighbouring steps
+  const uint32_t posQ8 = (currentQ16 * (GAUGE_STEPS - 1) * 256U + 0x7FFF) / 0xFFFF;
+  int step = (int)(posQ8 >> 8);
+  ditherAcc += posQ8 & 0xFF;
+  if (ditherAcc >= 256) {
+    ditherAcc -= 256;
+    if (step < GAUGE_STEPS - 1) step++;
+  }
+
+  // 3. Gauge layer
+  const uint8_t* gauge = gaugeFrame(step);
+  for (uint16_t i = 0; i < GAUGE_FRAME_SIZE; ++i) grb[i] = gauge[i];
+
+  // 4. Stage layer: dim stage color behind the unlit pixels
+  const uint32_t color = stageColor;
+  if (color) {
+    const uint8_t g = (uint8_t)((((color >> 8) & 0xFF) * LED_ANIM_BG_LEVEL) >> 8);
+    const uint8_t r = (uint8_t)((((color >> 16) & 0xFF) * LED_ANIM_BG_LEVEL) >> 8);
+    const uint8_t b = (uint8_t)(((color & 0xFF) * LED_ANIM_BG_LEVEL) >> 8);
+    for (uint16_t i = step + 1; i < GAUGE_PIXELS; ++i) {
+      grb[i * 3 + 0] = g;
+      grb[i * 3 + 1] = r;
+      grb[i * 3 + 2] = b;
+    }
+  }
+
+  // 5. Error layer: whole strip flashes red, status blinks fast
+  if (errorActive) {
+    const uint32_t half = msToFrames(LED_ANIM_ERROR_MS / 2);
+    const bool on = ((frame / half) & 1U) == 0;
+    if (on) {
+      for (uint16_t i = 0; i < GAUGE_PIXELS; ++i) {
+        grb[i * 3 + 0] = 0;
+        grb[i * 3 + 1] = 255;
+        grb[i * 3 + 2] = 0;
+      }
+    }
+    return on;
+  }
+
+  // 6. Status layer: heartbeat
+  return ((frame / msToFrames(LED_ANIM_STATUS_MS / 2)) & 1U) == 0;
+}
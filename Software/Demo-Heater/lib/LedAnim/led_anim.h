@@ -0,0 +1,32 @@
+/* LED Animation Engine Header */
+#ifndef LED_ANIM_H
+#define LED_ANIM_H
+
+/* Includes */
+#include <stdint.h>
+#include "led_gauge.h"
+
+/* Constants */
+// -----------------------------
+// Frame timing
+// -----------------------------
+constexpr uint16_t LED_ANIM_FPS       = 100;   // Frames per second, own esp_timer
+constexpr uint16_t LED_ANIM_STATUS_MS = 1000;  // Status LED blink period, healthy
+constexpr uint16_t LED_ANIM_ERROR_MS  = 200;   // Status LED and strip flash period, error
+
+// -----------------------------
+// Look
+// -----------------------------
+constexpr uint8_t LED_ANIM_EASE_Q8  = 40;   // Fraction of the remaining distance per frame (/256)
+constexpr uint8_t LED_ANIM_BG_LEVEL = 24;   // Stage color brightness on unlit pixels (/256)
+
+/* Public Function Definitions */
+bool ledAnimBegin(uint8_t neopixelPin, uint8_t statusPin);
+void ledAnimSetGauge(uint16_t levelQ16);                      // 0 = empty, 0xFFFF = full
+void ledAnimSetStageColor(uint8_t r, uint8_t g, uint8_t b);   // Background of unlit pixels, 0,0,0 = none
+void ledAnimSetError(bool error);                             // Flash the strip, fast status blink
+
+// Renders one frame into grb (GAUGE_FRAME_SIZE bytes), advancing the animation state
+bool ledAnimCompose(uint32_t frame, uint8_t* grb);
+
+#endif // LED_ANIM_H
@@ -0,0 +1,92 @@
+/* LED Gauge Header */
+#ifndef LED_GAUGE_H
+#define LED_GAUGE_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// Gauge geometry (16-pixel NEO_GRB stick)
+// -----------------------------
+constexpr uint16_t GAUGE_PIXELS     = 16;
+constexpr uint16_t GAUGE_STEPS      = GAUGE_PIXELS;       // step 0..GAUGE_PIXELS-1
+constexpr uint16_t GAUGE_FRAME_SIZE = GAUGE_PIXELS * 3;   // bytes, wire order G,R,B
+
+/* Typedefs */
+typedef struct gauge_frame {
+  uint8_t bytes[GAUGE_FRAME_SIZE];
+} gauge_frame;
+
+typedef struct gauge_table {
+  gauge_frame frames[GAUGE_STEPS];
+} gauge_table;
+
+/* Private Function Definitions */
+namespace gauge_detail {
+
+// x^0.2 by Newton iteration on y^5 = x, x in [0, 1]
+constexpr double fifthRoot(double x) {
+  if (x <= 0.0) return 0.0;
+  double y = 1.0;
+  for (int i = 0; i < 40; ++i) {
+    double y4 = y * y * y * y;
+    y = (4.0 * y + x / y4) / 5.0;
+  }
+  return y;
+}
+
+// Gamma 2.2 = x^2 * x^0.2
+constexpr double gamma22(double x) {
+  return x * x * fifthRoot(x);
+}
+
+constexpr uint8_t lerp8(uint8_t a, uint8_t b, float t) {
+  return static_cast<uint8_t>(a + (b - a) * t);
+}
+
+// Same segments as the original float gradient: green->yellow->orange->red
+constexpr void pixelColor(uint16_t i, uint8_t& r, uint8_t& g, uint8_t& b) {
+  float ratio = (float)i / (GAUGE_PIXELS - 1);
+  if (ratio < 0.15f) {
+    float t = ratio / 0.15f;
+    r = lerp8(0, 255, t);   g = lerp8(255, 255, t); b = 0;
+  } else if (ratio < 0.35f) {
+    float t = (ratio - 0.15f) / 0.20f;
+    r = lerp8(255, 255, t); g = lerp8(255, 120, t); b = 0;
+  } else {
+    float t = (ratio - 0.35f) / 0.65f;
+    r = lerp8(255, 255, t); g = lerp8(120, 0, t);   b = 0;
+  }
+}
+
+constexpr gauge_table buildTable() {
+  gauge_table table = {};
+  for (uint16_t step = 0; step < GAUGE_STEPS; ++step) {
+    float progress = (float)step / (GAUGE_PIXELS - 1);
+    float brightness = (float)gamma22(progress) * 0.9f + 0.1f;
+    for (uint16_t i = 0; i <= step; ++i) {
+      uint8_t r = 0, g = 0, b = 0;
+      pixelColor(i, r, g, b);
+      table.frames[step].bytes[i * 3 + 0] = static_cast<uint8_t>(g * brightness);
+      table.frames[step].bytes[i * 3 + 1] = static_cast<uint8_t>(r * brightness);
+      table.frames[step].bytes[i * 3 + 2] = static_cast<uint8_t>(b * brightness);
+    }
+  }
+  return table;
+}
+
+} // namespace gauge_detail
+
+/* Constants */
+// Gamma-corrected gauge frames, generated at compile time (flash, 768 bytes)
+constexpr gauge_table GAUGE_TABLE = gauge_detail::buildTable();
+
+/* Public Function Definitions */
+inline const uint8_t* gaugeFrame(int step) {
+  if (step < 0) step = 0;
+  if (step >= GAUGE_STEPS) step = GAUGE_STEPS - 1;
+  return GAUGE_TABLE.frames[step].bytes;
+}
+
+#endif // LED_GAUGE_H
@@ -0,0 +1,118 @@
+/* LED Output Driver */
+#ifdef ARDUINO
+
+/* Includes */
+#include <string.h>
+#include <driver/rmt.h>
+#include <esp_timer.h>
+#include "led_output.h"
+
+/* Defines */
+// 40 MHz RMT clock (APB / 2): 25 ns per tick
+#define LED_RMT_CLK_DIV     (2)
+#define LED_T0H_TICKS       (16)    // 0.40 us
+#define LED_T0L_TICKS       (34)    // 0.85 us
+#define LED_T1H_TICKS       (32)    // 0.80 us
+#define LED_T1L_TICKS       (18)    // 0.45 us
+#define LED_TICKS_PER_US    (40)
+
+/* Statics */
+static const rmt_channel_t ledChannel = (rmt_channel_t)LED_OUTPUT_CHANNEL;
+static uint16_t ledPixels = 0;
+
+// Double-buffered encoded frames: one on the wire, one being filled
+static rmt_item32_t itemBuf[2][LED_OUTPUT_MAX_PIXELS * 24];
+static uint8_t lastFrame[LED_OUTPUT_MAX_PIXELS * 3];
+static uint8_t frontBuf = 0;
+static bool pending = false;
+
+static volatile bool txBusy = false;
+static volatile int64_t txStartUs = 0;
+static volatile uint32_t lastFrameUs = 0;
+
+static uint32_t framesSent = 0;
+static uint32_t framesSkipped = 0;
+static uint32_t framesDropped = 0;
+
+/* Private Function Definitions */
+static void IRAM_ATTR onTxEnd(rmt_channel_t channel, void* arg) {
+  if (channel != ledChannel) return;
+  lastFrameUs = (uint32_t)(esp_timer_get_time() - txStartUs);
+  txBusy = false;
+}
+
+static void encodeFrame(const uint8_t* grb, rmt_item32_t* items) {
+  rmt_item32_t bit0 = {};
+  rmt_item32_t bit1 = {};
+  bit0.level0 = 1; bit0.duration0 = LED_T0H_TICKS; bit0.level1 = 0; bit0.duration1 = LED_T0L_TICKS;
+  bit1.level0 = 1; bit1.duration0 = LED_T1H_TICKS; bit1.level1 = 0; bit1.duration1 = LED_T1L_TICKS;
+
+  const uint16_t bytes = ledPixels * 3;
+  for (uint16_t i = 0; i < bytes; ++i) {
+    uint8_t v = grb[i];
+    for (uint8_t mask = 0x80; mask; mask >>= 1) {
+      *items++ = (v & mask) ? bit1 : bit0;
+    }
+  }
+  // Stretch the last low phase into the latch gap
+  (items - 1)->duration1 = LED_OUTPUT_RESET_US * LED_TICKS_PER_US;
+}
+
+static void kick() {
+  if (!pending || txBusy) return;
+  frontBuf ^= 1;
+  pending = false;
+  txBusy = true;
+  txStartUs = esp_timer_get_time();
+  framesSent++;
+  rmt_write_items(ledChannel, itemBuf[frontBuf], ledPixels * 24, false);
+}
+
+/* Public Function Definitions */
+bool ledOutputBegin(uint8_t pin, uint16_t numPixels) {
+  if (numPixels > LED_OUTPUT_MAX_PIXELS) numPixels = LED_OUTPUT_MAX_PIXELS;
+  ledPixels = numPixels;
+
+  rmt_config_t cfg = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pin, ledChannel);
+  cfg.clk_div = LED_RMT_CLK_DIV;
+  if (rmt_config(&cfg) != ESP_OK) return false;
+  if (rmt_driver_install(ledChannel, 0, 0) != ESP_OK) return false;
+  rmt_register_tx_end_callback(onTxEnd, NULL);
+
+  // Blank the chain once so the wire matches lastFrame
+  memset(lastFrame, 0, sizeof(lastFrame));
+  encodeFrame(lastFrame, itemBuf[frontBuf ^ 1]);
+  pending = true;
+  kick();
+  return true;
+}
+
+// Only call from one task: the back buffer and pending flag are not locked
+bool ledOutputShow(const uint8_t* grb) {
+  const uint16_t bytes = ledPixels * 3;
+  if (memcmp(grb, lastFrame, bytes) == 0) {
+    framesSkipped++;
+    kick();
+    return false;
+  }
+  memcpy(lastFrame, grb, bytes);
+
+  if (pending) framesDropped++;   // Back buffer never made it out
+  encodeFrame(grb, itemBuf[frontBuf ^ 1]);
+  pending = true;
+  kick();
+  return true;
+}
+
+void ledOutputService() {
+  kick();
+}
+
+void ledOutputStats(led_output_stats* out) {
+  out->framesSent = framesSent;
+  out->framesSkipped = framesSkipped;
+  out->framesDropped = framesDropped;
+  out->lastFrameUs = lastFrameUs;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,34 @@
+/* LED Output Header */
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// WS2812 chain on the RMT peripheral
+// -----------------------------
+constexpr uint16_t LED_OUTPUT_MAX_PIXELS = 16;
+constexpr uint8_t  LED_OUTPUT_CHANNEL    = 0;     // RMT channel
+constexpr uint16_t LED_OUTPUT_RESET_US   = 60;    // Latch gap after a frame
+
+/* Typedefs */
+typedef struct led_output_stats {
+  uint32_t framesSent;     // Frames handed to the RMT
+  uint32_t framesSkipped;  // Identical to the last frame, not retransmitted
+  uint32_t framesDropped;  // Replaced by a newer frame before they went out
+  uint32_t lastFrameUs;    // Wire time of the last completed frame
+} led_output_stats;
+
+/* Public Function Definitions */
+bool ledOutputBegin(uint8_t pin, uint16_t numPixels);
+bool ledOutputShow(const uint8_t* grb);   // numPixels * 3 bytes, wire order; false if skipped
+void ledOutputService();                  // Start a frame left pending by a busy transmitter
+void ledOutputStats(led_output_stats* out);
+
+#ifndef ARDUINO
+const uint8_t* ledOutputFakeFrame();      // Native: the frame last put on the wire
+#endif
+
+#endif // LED_OUTPUT_H
@@ -0,0 +1,44 @@
+/* LED Output Native Fake */
+#ifndef ARDUINO
+
+/* Includes */
+#include <string.h>
+#include "led_output.h"
+
+/* Statics */
+static uint16_t ledPixels = 0;
+static uint8_t lastFrame[LED_OUTPUT_MAX_PIXELS * 3];
+static led_output_stats stats = {};
+
+/* Public Function Definitions */
+bool ledOutputBegin(uint8_t pin, uint16_t numPixels) {
+  ledPixels = (numPixels > LED_OUTPUT_MAX_PIXELS) ? LED_OUTPUT_MAX_PIXELS : numPixels;
+  memset(lastFrame, 0, sizeof(lastFrame));
+  stats = {};
+  return true;
+}
+
+// FUNCTION: Same skip rule as the RMT driver, the wire is never busy
+bool ledOutputShow(const uint8_t* grb) {
+  const uint16_t bytes = ledPixels * 3;
+  if (memcmp(grb, lastFrame, bytes) == 0) {
+    stats.framesSkipped++;
+    return false;
+  }
+  memcpy(lastFrame, grb, bytes);
+  stats.framesSent++;
+  stats.lastFrameUs = bytes * 8 * 125 / 100 + LED_OUTPUT_RESET_US;   // 1.25 us per bit
+  return true;
+}
+
+void ledOutputService() { }
+
+void ledOutputStats(led_output_stats* out) {
+  *out = stats;
+}
+
+const uint8_t* ledOutputFakeFrame() {
+  return lastFrame;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,57 @@
+/* Micro Bench Header */
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// Cycle counts per call of the hot kernels, on the board (CPU cycles) and natively
+// (ns, see halCycles()). Results print as JSON, one result per line, so a serial
+// capture is a results file as it stands.
+// -----------------------------
+constexpr uint8_t  BENCH_MAX_RESULTS    = 32;
+constexpr uint8_t  BENCH_NAME_MAX       = 32;
+#ifdef ARDUINO
+constexpr uint8_t  BENCH_REPEATS        = 5;      // Best of, shrugs off interrupts and cache misses
+#else
+constexpr uint8_t  BENCH_REPEATS        = 50;     // ... and a desktop scheduler and clock scaling
+#endif
+constexpr uint8_t  BENCH_TOLERANCE_PCT  = 10;     // Slower than the baseline by more fails
+
+/* Typedefs */
+typedef void (*bench_fn)(uint32_t i);
+
+typedef struct bench_result {
+  char name[BENCH_NAME_MAX];
+  uint32_t cycles;          // Per call, call overhead taken out
+  uint32_t calls;           // Per repeat
+} bench_result;
+
+typedef struct bench_suite {
+  const char* name;
+  uint32_t mhz;
+  uint32_t overhead;        // Cycles of an empty call, measured once
+  bench_result results[BENCH_MAX_RESULTS];
+  uint8_t count;
+} bench_suite;
+
+/* Public Function Definitions */
+void     benchInit(bench_suite* s, const char* name);
+uint32_t benchRun(bench_suite* s, const char* name, bench_fn fn, uint32_t calls);   // Cycles per call
+void     benchAdd(bench_suite* s, const char* name, uint32_t cycles, uint32_t calls);   // A derived figure
+const bench_result* benchFind(const bench_suite* s, const char* name);
+void     benchPrintJson(const bench_suite* s);                                         // On the console
+
+// Compares every result with the baseline's of the same name, prints the table and
+// returns how many got slower than tolerancePct allows
+uint8_t  benchCompare(const bench_suite* now, const bench_suite* base, uint8_t tolerancePct);
+
+#ifndef ARDUINO
+// Native: results files (micro_bench_native.cpp)
+bool     benchWriteJson(const bench_suite* s, const char* path);
+bool     benchLoadJson(bench_suite* s, const char* path);      // Any text holding result lines
+#endif
+
+#endif // MICRO_BENCH_H
@@ -0,0 +1,34 @@
+/* Print Queue Header */
+#ifndef PRINT_QUEUE_H
+#define PRINT_QUEUE_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// Any task formats into the queue and moves on, one print task owns the console.
+// A full queue drops the line rather than stalling the caller's loop.
+// Shared with Demo-Servo, keep the copies identical.
+// -----------------------------
+constexpr uint8_t  PRINT_LINE_MAX       = 128;     // Including the terminator, longer lines are cut
+constexpr uint8_t  PRINT_QUEUE_DEPTH    = 10;
+constexpr uint16_t PRINT_TASK_STACK     = 4096;
+constexpr uint8_t  PRINT_TASK_PRIORITY  = 1;
+
+/* Typedefs */
+typedef struct print_queue_stats {
+  uint32_t lines;
+  uint32_t dropped;         // Queue full, or not started
+  uint32_t truncated;
+} print_queue_stats;
+
+/* Public Function Definitions */
+bool    printQueueInit();                   // Queue only, lines wait for printQueueService()
+bool    printQueueBegin(int8_t core);       // Queue and the print task
+void    enqueuePrint(const char* fmt, ...);
+uint8_t printQueueService();                // Print every waiting line, returns the count
+void    printQueueFlush();                  // Drop every waiting line
+void    printQueueStats(print_queue_stats* out);
+
+#endif // PRINT_QUEUE_H
@@ -0,0 +1,200 @@
+/* Sound Band Analyzer Driver */
+
+/* Includes */
+#include <math.h>
+#include <string.h>
+#include "sound_bands.h"
+
+/* Statics */
+// Tables are built once in soundBandsInit(), the per-block path is integer only
+static int16_t hannQ15[SOUND_BLOCK_SIZE];
+static int16_t twCosQ15[SOUND_BLOCK_SIZE / 2];
+static int16_t twSinQ15[SOUND_BLOCK_SIZE / 2];
+
+static int32_t         toneCoeffQ14[SOUND_MAX_TONES];
+static sound_tone_role toneRole[SOUND_MAX_TONES];
+static uint8_t         toneCount = 0;
+
+static uint8_t binMachine[SOUND_BLOCK_SIZE / 2];  // 1: bin belongs to a machine tone
+
+static int16_t workRe[SOUND_BLOCK_SIZE];
+#if SOUND_BANDS_FFT
+static int16_t workIm[SOUND_BLOCK_SIZE];
+#endif
+
+/* Private Function Definitions */
+static inline int16_t toQ15(float v) {
+  float s = v * 32768.0f;
+  if (s > 32767.0f)  s = 32767.0f;
+  if (s < -32768.0f) s = -32768.0f;
+  return static_cast<int16_t>(lroundf(s));
+}
+
+static inline uint16_t freqToBin(uint16_t freqHz) {
+  return static_cast<uint16_t>((static_cast<uint32_t>(freqHz) * SOUND_BLOCK_SIZE + SOUND_SAMPLE_RATE_HZ / 2) / SOUND_SAMPLE_RATE_HZ);
+}
+
+static inline uint16_t clampLevel(uint32_t v) {
+  return (v > 0xFFFF) ? 0xFFFF : static_cast<uint16_t>(v);
+}
+
+/* Public Function Definitions */
+
+// -----------------------------
+// Kernels
+// -----------------------------
+int32_t goertzelCoeffQ14(uint16_t freqHz, uint32_t sampleRateHz) {
+  float w = 2.0f * (float)M_PI * freqHz / sampleRateHz;
+  return static_cast<int32_t>(lroundf(2.0f * cosf(w) * 16384.0f));
+}
+
+// Squared DFT magnitude of x at the coefficient's frequency
+uint64_t goertzelPower(const int16_t* x, uint16_t n, int32_t coeffQ14) {
+  int32_t s1 = 0;
+  int32_t s2 = 0;
+  for (uint16_t i = 0; i < n; ++i) {
+    int32_t s0 = x[i] + static_cast<int32_t>((static_cast<int64_t>(coeffQ14) * s1) >> 14) - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+  int64_t p = static_cast<int64_t>(s1) * s1 + static_cast<int64_t>(s2) * s2
+            - ((static_cast<int64_t>(coeffQ14) * s1) >> 14) * s2;
+  return (p > 0) ? static_cast<uint64_t>(p) : 0;
+}
+
+// In-place complex FFT, Q15, scaled by 1/2 per stage (output = DFT / n).
+// log2n must not exceed SOUND_BLOCK_LOG2 (twiddle table size).
+void fftRadix2Q15(int16_t* re, int16_t* im, uint8_t log2n) {
+  const uint16_t n = 1U << log2n;
+
+  // Bit-reversal permutation
+  for (uint16_t i = 1, j = 0; i < n; ++i) {
+    uint16_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+
+  // Butterflies
+  for (uint16_t len = 2; len <= n; len <<= 1) {
+    const uint16_t half = len >> 1;
+    const uint16_t stride = SOUND_BLOCK_SIZE / len;
+    for (uint16_t i = 0; i < n; i += len) {
+      for (uint16_t k = 0; k < half; ++k) {
+        const int32_t wr = twCosQ15[k * stride];
+        const int32_t wi = -twSinQ15[k * stride];
+        const uint16_t a = i + k;
+        const uint16_t b = a + half;
+        const int32_t tr = (re[b] * wr - im[b] * wi) >> 15;
+        const int32_t ti = (re[b] * wi + im[b] * wr) >> 15;
+        const int32_t ar = re[a];
+        const int32_t ai = im[a];
+        re[b] = static_cast<int16_t>((ar - tr) >> 1);
+        im[b] = static_cast<int16_t>((ai - ti) >> 1);
+        re[a] = static_cast<int16_t>((ar + tr) >> 1);
+        im[a] = static_cast<int16_t>((ai + ti) >> 1);
+      }
+    }
+  }
+}
+
+uint32_t isqrt64(uint64_t v) {
+  uint64_t res = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > v) bit >>= 2;
+  while (bit) {
+    if (v >= res + bit) {
+      v -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint32_t>(res);
+}
+
+// -----------------------------
+// Analyzer
+// -----------------------------
+void soundBandsInit(const sound_tone* tones, uint8_t count) {
+  for (uint16_t i = 0; i < SOUND_BLOCK_SIZE; ++i) {
+    hannQ15[i] = toQ15(0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / SOUND_BLOCK_SIZE));
+  }
+  for (uint16_t k = 0; k < SOUND_BLOCK_SIZE / 2; ++k) {
+    float w = 2.0f * (float)M_PI * k / SOUND_BLOCK_SIZE;
+    twCosQ15[k] = toQ15(cosf(w));
+    twSinQ15[k] = toQ15(sinf(w));
+  }
+
+  if (count > SOUND_MAX_TONES) count = SOUND_MAX_TONES;
+  toneCount = count;
+  memset(binMachine, 0, sizeof(binMachine));
+  for (uint8_t t = 0; t < count; ++t) {
+    toneCoeffQ14[t] = goertzelCoeffQ14(tones[t].freqHz, SOUND_SAMPLE_RATE_HZ);
+    toneRole[t] = tones[t].role;
+    if (tones[t].role == TONE_MACHINE) {
+      // Hann main lobe spans +-1 bin around the tone
+      uint16_t bin = freqToBin(tones[t].freqHz);
+      for (int16_t b = (int16_t)bin - 1; b <= (int16_t)bin + 1; ++b) {
+        if (b >= 0 && b < (int16_t)(SOUND_BLOCK_SIZE / 2)) binMachine[b] = 1;
+      }
+    }
+  }
+}
+
+// raw: ADC words (low 12 bits are the sample), n up to SOUND_BLOCK_SIZE. A short block
+// (the DMA handing over less) is zero-padded for the FFT.
+void soundBandsProcess(const uint16_t* raw, uint16_t n, sound_bands_result* out) {
+  if (n > SOUND_BLOCK_SIZE) n = SOUND_BLOCK_SIZE;
+
+  // 1. Remove sensor bias
+  uint32_t sum = 0;
+  for (uint16_t i = 0; i < n; ++i) sum += raw[i] & 0x0FFF;
+  const int32_t mean = n ? static_cast<int32_t>(sum / n) : 0;
+  out->dcLevel = static_cast<uint16_t>(mean);
+
+  // 2. Window, scaled x8 to use the Q15 headroom (12-bit -> +-16384)
+  for (uint16_t i = 0; i < n; ++i) {
+    int32_t s = (static_cast<int32_t>(raw[i] & 0x0FFF) - mean) << 3;
+    workRe[i] = static_cast<int16_t>((s * hannQ15[i]) >> 15);
+  }
+
+#if SOUND_BANDS_FFT
+  for (uint16_t i = n; i < SOUND_BLOCK_SIZE; ++i) workRe[i] = 0;
+
+  // 3. Spectrum, output is DFT / N
+  memset(workIm, 0, sizeof(workIm));
+  fftRadix2Q15(workRe, workIm, SOUND_BLOCK_LOG2);
+
+  const uint16_t loBin = freqToBin(SOUND_BAND_LO_HZ);
+  const uint16_t hiBin = freqToBin(SOUND_BAND_HI_HZ);
+  uint64_t trigger = 0;
+  uint64_t machine = 0;
+  for (uint16_t k = 1; k < SOUND_BLOCK_SIZE / 2; ++k) {
+    uint32_t p = static_cast<uint32_t>(workRe[k] * workRe[k]) + static_cast<uint32_t>(workIm[k] * workIm[k]);
+    if (binMachine[k])                    machine += p;
+    else if (k >= loBin && k <= hiBin)    trigger += p;
+  }
+
+  // 4. Amplitude: |X/N| = 2A for a x8-scaled Hann-windowed tone, Hann ENBW = 1.5 bins
+  out->triggerLevel = clampLevel(isqrt64(trigger * 2 / 3) >> 1);
+  out->machineLevel = clampLevel(isqrt64(machine * 2 / 3) >> 1);
+#else
+  // 3. Goertzel bank over the configured tones
+  uint64_t trigger = 0;
+  uint64_t machine = 0;
+  for (uint8_t t = 0; t < toneCount; ++t) {
+    uint64_t p = goertzelPower(workRe, n, toneCoeffQ14[t]);
+    if (toneRole[t] == TONE_MACHINE) machine += p;
+    else                             trigger += p;
+  }
+
+  // 4. Amplitude: |X| = 2NA for a x8-scaled Hann-windowed tone
+  out->triggerLevel = clampLevel(isqrt64(trigger) >> (SOUND_BLOCK_LOG2 + 1));
+  out->machineLevel = clampLevel(isqrt64(machine) >> (SOUND_BLOCK_LOG2 + 1));
+#endif
+}
@@ -0,0 +1,59 @@
+/* Sound Band Analyzer Header */
+#ifndef SOUND_BANDS_H
+#define SOUND_BANDS_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Defines */
+
+// -----------------------------
+// Analyzer selection
+// 0: Goertzel bank over the configured tones
+// 1: Radix-2 FFT, band energy between SOUND_BAND_LO_HZ..SOUND_BAND_HI_HZ
+// Set from platformio.ini build_flags (-DSOUND_BANDS_FFT=1) so the library sees it
+// -----------------------------
+#ifndef SOUND_BANDS_FFT
+#define SOUND_BANDS_FFT       (0U)
+#endif
+
+// -----------------------------
+// Block configuration
+// -----------------------------
+constexpr uint32_t SOUND_SAMPLE_RATE_HZ = 8000;  // ADC sample rate
+constexpr uint8_t  SOUND_BLOCK_LOG2     = 7;
+constexpr uint16_t SOUND_BLOCK_SIZE     = 1U << SOUND_BLOCK_LOG2;  // 128 samples = 16 ms
+constexpr uint8_t  SOUND_MAX_TONES      = 8;
+constexpr uint16_t SOUND_BAND_LO_HZ     = 300;   // FFT trigger band (voice)
+constexpr uint16_t SOUND_BAND_HI_HZ     = 3000;
+
+/* Typedefs */
+// What a configured tone contributes to
+enum sound_tone_role : uint8_t {
+  TONE_TRIGGER,   // Counts towards the trigger level
+  TONE_MACHINE,   // Machine's own noise (servo/fader/heater PWM), rejected
+};
+
+typedef struct sound_tone {
+  uint16_t freqHz;
+  sound_tone_role role;
+} sound_tone;
+
+typedef struct sound_bands_result {
+  uint16_t triggerLevel;  // Trigger band amplitude, ADC counts (machine noise removed)
+  uint16_t machineLevel;  // Machine tone amplitude, ADC counts
+  uint16_t dcLevel;       // Block mean (sensor bias), ADC counts
+  uint32_t cycles;        // CPU cycles spent analyzing the block (filled by caller)
+} sound_bands_result;
+
+/* Public Function Definitions */
+void soundBandsInit(const sound_tone* tones, uint8_t count);
+void soundBandsProcess(const uint16_t* raw, uint16_t n, sound_bands_result* out);
+
+// Kernels (fixed-point, no allocation)
+int32_t  goertzelCoeffQ14(uint16_t freqHz, uint32_t sampleRateHz);
+uint64_t goertzelPower(const int16_t* x, uint16_t n, int32_t coeffQ14);
+void     fftRadix2Q15(int16_t* re, int16_t* im, uint8_t log2n);
+uint32_t isqrt64(uint64_t v);
+
+#endif // SOUND_BANDS_H
@@ -0,0 +1,34 @@
+/* Sound Gauge Driver */
+
+/* Includes */
+#include "sound_gauge.h"
+
+/* Public Function Definitions */
+void soundGaugeInit(sound_gauge* g) {
+  *g = sound_gauge();
+}
+
+// FUNCTION: One sound tick: smooth the input, charge or drain the gauge, follow it
+// with the PWM duty (0..pwmMax)
+void soundGaugeStep(sound_gauge* g, uint16_t triggerLevel, int pwmMax) {
+  g->smooth = g->smooth * (1 - SOUND_GAUGE_ALPHA) + triggerLevel * SOUND_GAUGE_ALPHA;
+
+  // Between quiet and active still charges, at half the slow rate
+  float level = g->level;
+  if (g->smooth < SOUND_GAUGE_QUIET)        level -= SOUND_GAUGE_DRAIN;
+  else if (g->smooth >= SOUND_GAUGE_LOUD)   level += SOUND_GAUGE_CHARGE_FAST;
+  else if (g->smooth >= SOUND_GAUGE_ACTIVE) level += SOUND_GAUGE_CHARGE_SLOW;
+  else                                      level += SOUND_GAUGE_CHARGE_SLOW * 0.5f;
+  if (level < 0.0f) level = 0.0f;
+  if (level > 1.0f) level = 1.0f;
+  g->level = level;
+
+  int pwm = (int)(level * pwmMax);
+  if (pwm < 0)      pwm = 0;
+  if (pwm > pwmMax) pwm = pwmMax;
+  g->pwm = g->pwm * (1 - SOUND_GAUGE_PWM_ALPHA) + pwm * SOUND_GAUGE_PWM_ALPHA;
+}
+
+uint16_t soundGaugeQ16(const sound_gauge* g) {
+  return (uint16_t)(g->level * 0xFFFF);
+}
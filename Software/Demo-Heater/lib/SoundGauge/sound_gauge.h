@@ -0,0 +1,34 @@
+/* Sound Gauge Header */
+#ifndef SOUND_GAUGE_H
+#define SOUND_GAUGE_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// Gauge that builds up as the user yells and drains when quiet, one step per
+// sound tick. Levels are trigger band amplitudes in ADC counts.
+// -----------------------------
+constexpr float    SOUND_GAUGE_ALPHA        = 0.4f;    // Input smoothing
+constexpr uint16_t SOUND_GAUGE_QUIET        = 40;      // Below this is considered quiet
+constexpr uint16_t SOUND_GAUGE_ACTIVE       = 80;      // Above this actively charges the gauge
+constexpr uint16_t SOUND_GAUGE_LOUD         = 200;     // Very loud sounds charge faster
+constexpr float    SOUND_GAUGE_CHARGE_SLOW  = 0.03f;   // Per step, moderate sounds
+constexpr float    SOUND_GAUGE_CHARGE_FAST  = 0.06f;   // Per step, loud sounds
+constexpr float    SOUND_GAUGE_DRAIN        = 0.002f;  // Per step when quiet
+constexpr float    SOUND_GAUGE_PWM_ALPHA    = 0.1f;    // Lower values make the PWM smoother
+
+/* Typedefs */
+typedef struct sound_gauge {
+  float smooth;           // Smoothed trigger level, ADC counts
+  float level;            // 0.0 empty .. 1.0 full
+  int pwm;                // AUDIO mode duty, smoothed
+} sound_gauge;
+
+/* Public Function Definitions */
+void     soundGaugeInit(sound_gauge* g);
+void     soundGaugeStep(sound_gauge* g, uint16_t triggerLevel, int pwmMax);
+uint16_t soundGaugeQ16(const sound_gauge* g);                  // For ledAnimSetGauge()
+
+#endif // SOUND_GAUGE_H
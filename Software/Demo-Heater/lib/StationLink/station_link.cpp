@@ -0,0 +1,169 @@
+/* Station Link Driver */
+
+/* Includes */
+#include <string.h>
+#include "hal.h"
+#include "station_link.h"
+
+/* Private Function Definitions */
+static station_pending* findPending(station_link* l, uint16_t seq) {
+  for (uint8_t i = 0; i < LINK_MAX_PENDING; ++i) {
+    if (l->pending[i].used && l->pending[i].cmd.seq == seq) return &l->pending[i];
+  }
+  return NULL;
+}
+
+// Stamp a send, under the link lock
+static void markSent(station_pending* p) {
+  p->cmd.sentUs = halMicros();
+  p->lastSentMs = halMillis();
+  p->tries++;
+}
+
+static bool sendCmd(const uint8_t* mac, const link_cmd* cmd) {
+  return halRadioSend(mac, (const uint8_t*)cmd, sizeof(*cmd));
+}
+
+/* Public Function Definitions */
+void stationInit(station_link* l) {
+  *l = station_link();
+  halLockInit(&l->lock);
+  l->stats.minRttUs = UINT32_MAX;
+}
+
+uint16_t stationSend(station_link* l, const uint8_t* mac, uint8_t op, uint8_t servos, int16_t arg,
+                     station_done_cb cb, void* cbArg) {
+  station_pending* p = NULL;
+  link_cmd cmd;
+  halLock(&l->lock);
+  for (uint8_t i = 0; i < LINK_MAX_PENDING && !p; ++i) {
+    if (!l->pending[i].used) p = &l->pending[i];
+  }
+  if (p) {
+    if (++l->nextSeq == 0) l->nextSeq = 1;
+    *p = station_pending();
+    p->used = true;
+    memcpy(p->mac, mac, 6);
+    p->cmd.magic = LINK_MAGIC;
+    p->cmd.op = op;
+    p->cmd.seq = l->nextSeq;
+    p->cmd.servos = servos;
+    p->cmd.arg = arg;
+    p->cb = cb;
+    p->cbArg = cbArg;
+    p->firstSentUs = halMicros();
+    markSent(p);
+    cmd = p->cmd;
+    l->stats.sent++;
+  }
+  halUnlock(&l->lock);
+  if (!p) return 0;
+
+  if (!sendCmd(mac, &cmd)) {
+    halLock(&l->lock);
+    p->used = false;
+    halUnlock(&l->lock);
+    return 0;
+  }
+  return cmd.seq;
+}
+
+bool stationBusy(station_link* l, uint16_t seq) {
+  halLock(&l->lock);
+  bool busy = findPending(l, seq) != NULL;
+  halUnlock(&l->lock);
+  return busy;
+}
+
+// FUNCTION: Called from the ESP-NOW receive callback (WiFi task), returns false if
+// it isn't a link report. RTT comes from the echoed send time, so resends count too.
+bool stationOnRecv(station_link* l, const uint8_t* mac, const uint8_t* data, int len) {
+  if (!linkIsReport(data, len)) return false;
+
+  link_report report;
+  memcpy(&report, data, sizeof(report));
+  uint32_t now = halMicros();
+  station_done_cb doneCb = NULL;
+  void* doneArg = NULL;
+  uint8_t doneStatus = LINK_OK;
+
+  halLock(&l->lock);
+  station_pending* p = findPending(l, report.seq);
+  if (p && report.op == LINK_OP_ACK && !p->acked) {
+    uint32_t rtt = now - report.sentUs;
+    uint32_t start = rtt / 2 + report.rxToStartUs;
+    p->acked = true;
+    if (p->status == LINK_OK) p->status = report.status;
+    p->waiting = linkOpMoves(p->cmd.op) ? (uint8_t)(report.servos & ~p->doneEarly) : 0;
+    l->stats.acks++;
+    l->stats.lastRttUs = rtt;
+    if (rtt < l->stats.minRttUs) l->stats.minRttUs = rtt;
+    if (rtt > l->stats.maxRttUs) l->stats.maxRttUs = rtt;
+    l->sumRttUs += rtt;
+    l->stats.lastStartUs = start;
+    if (start > l->stats.maxStartUs) l->stats.maxStartUs = start;
+    l->sumStartUs += start;
+  } else if (p && report.op == LINK_OP_DONE) {
+    if (p->acked) p->waiting &= ~report.servos;
+    else          p->doneEarly |= report.servos;
+    if (report.status != LINK_OK && p->status == LINK_OK) p->status = report.status;
+    l->stats.dones++;
+    l->stats.lastDoneUs = now - p->firstSentUs;
+  }
+  if (p && p->acked && !p->waiting) {
+    doneCb = p->cb;
+    doneArg = p->cbArg;
+    doneStatus = p->status;
+    p->used = false;
+  }
+  halUnlock(&l->lock);
+
+  if (doneCb) doneCb(report.seq, doneStatus, doneArg);
+  return true;
+}
+
+void stationPoll(station_link* l) {
+  uint32_t nowMs = halMillis();
+  for (uint8_t i = 0; i < LINK_MAX_PENDING; ++i) {
+    station_pending* p = &l->pending[i];
+    bool resend = false;
+    uint8_t mac[6];
+    link_cmd cmd;
+    station_done_cb doneCb = NULL;
+    void* doneArg = NULL;
+    uint16_t seq = 0;
+
+    halLock(&l->lock);
+    if (p->used) {
+      seq = p->cmd.seq;
+      bool ackLate = !p->acked && nowMs - p->lastSentMs >= LINK_ACK_TIMEOUT_MS;
+      bool doneLate = p->acked && nowMs - p->lastSentMs >= LINK_DONE_TIMEOUT_MS;
+      if (ackLate && p->tries < LINK_MAX_TRIES) {
+        resend = true;
+        markSent(p);
+        memcpy(mac, p->mac, 6);
+        cmd = p->cmd;
+        l->stats.resends++;
+      } else if (ackLate || doneLate) {
+        doneCb = p->cb;
+        doneArg = p->cbArg;
+        p->used = false;
+        l->stats.timeouts++;
+      }
+    }
+    halUnlock(&l->lock);
+
+    // Same seq, the station runs it once and answers again
+    if (resend) sendCmd(mac, &cmd);
+    if (doneCb) doneCb(seq, LINK_TIMEOUT, doneArg);
+  }
+}
+
+void stationStats(station_link* l, station_stats* out) {
+  halLock(&l->lock);
+  *out = l->stats;
+  if (!l->stats.acks) out->minRttUs = 0;
+  out->avgRttUs = l->stats.acks ? (uint32_t)(l->sumRttUs / l->stats.acks) : 0;
+  out->avgStartUs = l->stats.acks ? (uint32_t)(l->sumStartUs / l->stats.acks) : 0;
+  halUnlock(&l->lock);
+}
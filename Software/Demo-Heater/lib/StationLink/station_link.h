@@ -0,0 +1,73 @@
+/* Station Link Header */
+#ifndef STATION_LINK_H
+#define STATION_LINK_H
+
+/* Includes */
+#include <stdint.h>
+#include <stddef.h>
+#include "hal.h"
+#include "servo_link.h"
+
+/* Constants */
+// -----------------------------
+// Chef side of the servo link: send, resend until ACKed, wait for every DONE
+// -----------------------------
+constexpr uint8_t LINK_TIMEOUT = 0xFF;  // Callback status: no ACK after every try, or DONE overdue
+
+/* Typedefs */
+// Runs once per command: in the ESP-NOW receive callback when the last DONE (or the
+// ACK of an op that doesn't move) arrives, in stationPoll() on timeout
+typedef void (*station_done_cb)(uint16_t seq, uint8_t status, void* arg);
+
+typedef struct station_stats {
+  uint32_t sent;
+  uint32_t resends;
+  uint32_t acks;
+  uint32_t dones;
+  uint32_t timeouts;
+  uint32_t lastRttUs;
+  uint32_t minRttUs;
+  uint32_t maxRttUs;
+  uint32_t avgRttUs;
+  uint32_t lastStartUs;     // Send to first pulse change: RTT/2 + the station's receive-to-start
+  uint32_t maxStartUs;
+  uint32_t avgStartUs;
+  uint32_t lastDoneUs;      // Send to the last DONE
+} station_stats;
+
+typedef struct station_pending {
+  bool used;
+  bool acked;
+  uint8_t mac[6];
+  uint8_t tries;
+  uint8_t waiting;          // Servos still owing a DONE
+  uint8_t doneEarly;        // DONEs that beat the ACK (lost or late), taken off when it arrives
+  uint8_t status;
+  uint32_t firstSentUs;
+  uint32_t lastSentMs;
+  link_cmd cmd;
+  station_done_cb cb;
+  void* cbArg;
+} station_pending;
+
+// One Chef's commands in flight, shared by loop() and the ESP-NOW receive callback
+typedef struct station_link {
+  station_pending pending[LINK_MAX_PENDING];
+  uint16_t nextSeq;
+  hal_lock lock;
+  station_stats stats;
+  uint64_t sumRttUs;
+  uint64_t sumStartUs;
+} station_link;
+
+/* Public Function Definitions */
+void stationInit(station_link* l);
+// Returns the command's seq, 0 if too many are in flight or the send failed
+uint16_t stationSend(station_link* l, const uint8_t* mac, uint8_t op, uint8_t servos, int16_t arg,
+                     station_done_cb cb = NULL, void* cbArg = NULL);
+bool stationBusy(station_link* l, uint16_t seq);
+bool stationOnRecv(station_link* l, const uint8_t* mac, const uint8_t* data, int len);   // ESP-NOW receive callback
+void stationPoll(station_link* l);   // Resends and timeouts, call every frame
+void stationStats(station_link* l, station_stats* out);
+
+#endif // STATION_LINK_H
@@ -0,0 +1,68 @@
+/* Thermal Plant */
+
+/* Includes */
+#include <math.h>
+#include "thermal_plant.h"
+
+/* Private Function Definitions */
+// xorshift32, reproducible runs
+static inline uint32_t nextRandom(uint32_t* s) {
+  uint32_t x = *s;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *s = x;
+  return x;
+}
+
+// Approximately normal, sum of four uniforms, unit variance
+static float gaussian(uint32_t* s) {
+  float sum = 0.0f;
+  for (uint8_t i = 0; i < 4; ++i) sum += (float)(nextRandom(s) >> 8) / 16777216.0f;
+  return (sum - 2.0f) * 1.7320508f;
+}
+
+/* Public Function Definitions */
+void thermalPlantInit(thermal_plant* p, const thermal_plant_cfg* cfg, float dtS, float startC) {
+  p->cfg = *cfg;
+  p->dtS = dtS;
+  p->elementC = startC;
+  p->plateC = startC;
+  p->sensorC = startC;
+  p->energyJ = 0.0f;
+  p->rng = cfg->seed ? cfg->seed : 1;
+  p->delaySteps = (uint32_t)(cfg->deadTimeS / dtS + 0.5f);
+  if (p->delaySteps >= THERMAL_PLANT_MAX_DELAY) p->delaySteps = THERMAL_PLANT_MAX_DELAY - 1;
+  p->delayIdx = 0;
+  for (uint32_t i = 0; i < THERMAL_PLANT_MAX_DELAY; ++i) p->delay[i] = startC;
+}
+
+// FUNCTION: Explicit Euler, fine while dtS is well below the smallest time constant
+void thermalPlantStep(thermal_plant* p, float duty, float supply) {
+  const thermal_plant_cfg& c = p->cfg;
+  float dt = p->dtS;
+  float powerW = c.powerW * duty * supply * supply;   // Resistive: P ~ V^2
+  p->energyJ += powerW * dt;
+
+  if (c.plateJPerC > 0.0f) {
+    float flowW = c.couplingWPerC * (p->elementC - p->plateC);
+    p->elementC += (powerW - flowW) / c.elementJPerC * dt;
+    p->plateC += (flowW - c.lossWPerC * (p->plateC - c.ambientC)) / c.plateJPerC * dt;
+  } else {
+    p->elementC += (powerW - c.lossWPerC * (p->elementC - c.ambientC)) / c.elementJPerC * dt;
+    p->plateC = p->elementC;
+  }
+
+  // Dead time, then the sensor's own lag
+  p->delay[p->delayIdx] = p->plateC;
+  uint32_t out = (p->delayIdx + THERMAL_PLANT_MAX_DELAY - p->delaySteps) % THERMAL_PLANT_MAX_DELAY;
+  p->delayIdx = (p->delayIdx + 1) % THERMAL_PLANT_MAX_DELAY;
+  if (c.sensorTauS > 0.0f) p->sensorC += (p->delay[out] - p->sensorC) * dt / (c.sensorTauS + dt);
+  else                     p->sensorC = p->delay[out];
+}
+
+float thermalPlantRead(thermal_plant* p) {
+  float v = p->sensorC + p->cfg.noiseC * gaussian(&p->rng);
+  if (p->cfg.quantC > 0.0f) v = floorf(v / p->cfg.quantC + 0.5f) * p->cfg.quantC;
+  return v;
+}
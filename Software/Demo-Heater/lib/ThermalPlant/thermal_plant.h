@@ -0,0 +1,50 @@
+/* Thermal Plant Header */
+#ifndef THERMAL_PLANT_H
+#define THERMAL_PLANT_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// Host model of the heater, for tuning without burning bread
+// -----------------------------
+constexpr uint32_t THERMAL_PLANT_MAX_DELAY = 4096;   // Dead-time line, integration steps
+
+/* Typedefs */
+// Element -> plate -> ambient, the thermocouple sits on the plate behind a dead time
+// and its own lag. plateJPerC 0 makes it first order: the element is the plate.
+typedef struct thermal_plant_cfg {
+  float    ambientC;
+  float    powerW;          // Full duty at nominal supply
+  float    elementJPerC;    // Heat capacity of the element
+  float    plateJPerC;      // Heat capacity of the plate/iron, 0: first order
+  float    couplingWPerC;   // Element to plate
+  float    lossWPerC;       // Plate (or element) to ambient
+  float    deadTimeS;       // Transport lag to the sensor
+  float    sensorTauS;      // Sensor first-order lag
+  float    noiseC;          // Sensor noise, RMS
+  float    quantC;          // Sensor resolution, 0.25 on the MAX31855
+  uint32_t seed;
+} thermal_plant_cfg;
+
+typedef struct thermal_plant {
+  thermal_plant_cfg cfg;
+  float    dtS;             // Integration step
+  float    elementC;
+  float    plateC;          // What the bread sees
+  float    sensorC;         // Lagged, before noise
+  float    energyJ;         // Delivered since init
+  uint32_t rng;
+  uint32_t delaySteps;
+  uint32_t delayIdx;
+  float    delay[THERMAL_PLANT_MAX_DELAY];
+} thermal_plant;
+
+/* Public Function Definitions */
+void  thermalPlantInit(thermal_plant* p, const thermal_plant_cfg* cfg, float dtS, float startC);
+// One integration step. duty 0..1 as the LEDC puts it out, supply scales the voltage (1 = nominal).
+void  thermalPlantStep(thermal_plant* p, float duty, float supply);
+float thermalPlantRead(thermal_plant* p);   // Sensor reading: lag, dead time, noise, resolution
+
+#endif // THERMAL_PLANT_H
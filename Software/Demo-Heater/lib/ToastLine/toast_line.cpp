@@ -0,0 +1,176 @@
+/* Toast Line Driver */
+
+/* Includes */
+#include <string.h>
+#include "toast_line.h"
+
+/* Private Function Definitions */
+// FUNCTION: Link callback, the receive callback or stationPoll(). The stage never
+// changes with commands in flight, so a slot's DONE always belongs to this stage.
+static void onCmdDone(uint16_t seq, uint8_t status, void* arg) {
+  toast_ticket* ticket = (toast_ticket*)arg;
+  toast_line* t = ticket->line;
+  halLock(&t->lock);
+  t->done |= ticket->bit;
+  if (status != LINK_OK) t->failed++;
+  halUnlock(&t->lock);
+}
+
+static void enterStage(toast_line* t, uint8_t stage, uint32_t nowMs) {
+  t->stats.stageMs[t->stage] += nowMs - t->stageStartMs;
+  t->stage = stage;
+  t->stageStartMs = nowMs;
+  t->phaseStartMs = nowMs;
+  t->unsent = 0;
+  t->sent = 0;
+  const toast_stage_cfg& s = t->stages[stage];
+  for (uint8_t i = 0; i < TOAST_STAGE_CMDS; ++i) {
+    if (s.cmds[i].servos) t->unsent |= 1 << i;
+  }
+  halLock(&t->lock);
+  t->done = 0;
+  t->failed = 0;
+  halUnlock(&t->lock);
+  t->phase = s.button ? TOAST_IDLE : s.brandFirst ? TOAST_BRAND : TOAST_SEND;
+}
+
+// FUNCTION: Next stage, a slice is out when the line gets back to a button
+static void nextStage(toast_line* t, uint32_t nowMs) {
+  uint8_t next = (t->stage + 1) % TOAST_STAGE_COUNT;
+  if (t->stages[next].button && !t->stages[t->stage].button) {
+    uint32_t cycleMs = nowMs - t->sliceStartMs;
+    t->stats.slices++;
+    t->stats.lastCycleMs = cycleMs;
+    if (cycleMs > t->stats.maxCycleMs) t->stats.maxCycleMs = cycleMs;
+    t->stats.sumCycleMs += cycleMs;
+  }
+  enterStage(t, next, nowMs);
+}
+
+// FUNCTION: Everything not on the link yet, true when all of it is
+static bool sendCmds(toast_line* t) {
+  const toast_stage_cfg& s = t->stages[t->stage];
+  for (uint8_t i = 0; i < TOAST_STAGE_CMDS; ++i) {
+    uint8_t bit = 1 << i;
+    if (!(t->unsent & bit)) continue;
+    const toast_cmd& c = s.cmds[i];
+    if (!stationSend(t->link, t->mac, c.op, c.servos, c.arg, onCmdDone, &t->tickets[i])) return false;
+    t->unsent &= ~bit;
+    t->sent |= bit;
+  }
+  return true;
+}
+
+/* Public Function Definitions */
+void toastLineInit(toast_line* t, const toast_stage_cfg* stages, station_link* link, const uint8_t* mac,
+                   toast_brand_fn brand, void* brandArg) {
+  *t = toast_line();
+  t->stages = stages;
+  t->link = link;
+  memcpy(t->mac, mac, 6);
+  t->brand = brand;
+  t->brandArg = brandArg;
+  t->jumpTo = TOAST_STAGE_COUNT;
+  halLockInit(&t->lock);
+  for (uint8_t i = 0; i < TOAST_STAGE_CMDS; ++i) t->tickets[i] = { t, (uint8_t)(1 << i) };
+  t->stageStartMs = halMillis();
+  enterStage(t, STATE_B_DETECT_BUTTON, t->stageStartMs);
+}
+
+bool toastLineRequest(toast_line* t) {
+  uint32_t nowMs = halMillis();
+  halLock(&t->lock);
+  bool ok = t->requestCount < TOAST_QUEUE_DEPTH;
+  if (ok) {
+    t->requestMs[(t->requestHead + t->requestCount) % TOAST_QUEUE_DEPTH] = nowMs;
+    t->requestCount++;
+    t->stats.requests++;
+  } else {
+    t->stats.refused++;
+  }
+  halUnlock(&t->lock);
+  return ok;
+}
+
+// FUNCTION: Button -> brand -> commands -> every DONE -> wait -> next stage. Never blocks,
+// a phase that is done falls through to the next one in the same poll.
+void toastLinePoll(toast_line* t) {
+  uint32_t nowMs = halMillis();
+  const toast_stage_cfg& s = t->stages[t->stage];
+
+  if (t->jumpTo < TOAST_STAGE_COUNT && t->phase != TOAST_MOVE) {
+    uint8_t stage = t->jumpTo;
+    t->jumpTo = TOAST_STAGE_COUNT;
+    enterStage(t, stage, nowMs);
+    return;
+  }
+
+  switch (t->phase) {
+    case TOAST_IDLE: {
+      halLock(&t->lock);
+      bool take = t->requestCount > 0;
+      if (take) {
+        t->sliceStartMs = t->requestMs[t->requestHead];
+        t->requestHead = (t->requestHead + 1) % TOAST_QUEUE_DEPTH;
+        t->requestCount--;
+      }
+      halUnlock(&t->lock);
+      if (!take) return;
+      uint32_t queueMs = nowMs - t->sliceStartMs;
+      if (queueMs > t->stats.maxQueueMs) t->stats.maxQueueMs = queueMs;
+      t->stats.sumQueueMs += queueMs;
+      nextStage(t, nowMs);
+      return;
+    }
+
+    case TOAST_BRAND:
+      if (t->brand && !t->brand(t->brandArg)) {
+        if (nowMs - t->phaseStartMs < TOAST_BRAND_TIMEOUT_MS) return;
+        t->stats.brandTimeouts++;
+      }
+      t->phase = TOAST_SEND;
+      t->phaseStartMs = nowMs;
+      // Fall through
+
+    case TOAST_SEND:
+      if (!sendCmds(t)) {
+        t->stats.sendRetries++;
+        return;
+      }
+      t->phase = TOAST_MOVE;
+      // Fall through
+
+    case TOAST_MOVE: {
+      halLock(&t->lock);
+      bool owed = (t->done & t->sent) != t->sent;
+      uint8_t failed = t->failed;
+      halUnlock(&t->lock);
+      if (owed) return;
+      if (t->sent) {
+        uint32_t moveMs = nowMs - t->phaseStartMs;
+        t->stats.moves++;
+        if (moveMs > t->stats.maxMoveMs) t->stats.maxMoveMs = moveMs;
+        t->stats.sumMoveMs += moveMs;
+        t->stats.faults += failed;
+      }
+      t->phase = TOAST_WAIT;
+      t->phaseStartMs = nowMs;
+    }
+      // Fall through
+
+    case TOAST_WAIT:
+      if (nowMs - t->phaseStartMs < s.waitMs) return;
+      nextStage(t, nowMs);
+      return;
+  }
+}
+
+void toastLineJump(toast_line* t, uint8_t stage) {
+  if (stage < TOAST_STAGE_COUNT) t->jumpTo = stage;
+}
+
+void toastLineStats(toast_line* t, toast_line_stats* out) {
+  halLock(&t->lock);
+  *out = t->stats;
+  halUnlock(&t->lock);
+}
@@ -0,0 +1,147 @@
+/* Toast Line Header */
+#ifndef TOAST_LINE_H
+#define TOAST_LINE_H
+
+/* Includes */
+#include <stdint.h>
+#include "hal.h"
+#include "station_link.h"
+
+/* Typedefs */
+// Chef stages: a bottom slice, then a top slice
+enum toast_stage : uint8_t {
+  STATE_B_DETECT_BUTTON,  // 1. Go to STATE_B_DROP
+  STATE_B_DROP,           // 1. Reset gate (butter/toast), Reset flipper (Open Top) | 2. Open bottom dropper | 3. Wait
+  STATE_B_BUTTER,         // 1. Apply butter | 2. Open gate butter | 3. Wait
+  STATE_B_TOAST,          // 1. Measure sound & heat | 2. Brand | 3. open gate toast | 4. Wait
+  STATE_B_DISPENSE,       // 1. Dispense pusher | 2. Wait
+  STATE_T_DETECT_BUTTON,  // 1. Go to STATE_T_DROP
+  STATE_T_DROP,           // 1. Reset gate (butter/toast), Reset flipper (Close Top) | 2. Open top dropper | 3. Wait
+  STATE_T_BUTTER,         // 1. Apply butter | 2. Open gate butter | 3. Wait
+  STATE_T_TOAST,          // 1. Measure sound & heat | 2. Brand | 3. open gate toast | 4. Wait
+  STATE_T_DISPENSE,       // 1. Dispense flipper | 2. Wait
+  TOAST_STAGE_COUNT,
+};
+
+/* Constants */
+// -----------------------------
+// Station outputs: gate on the TowerPro, pusher on the continuous servo, flipper on the Parallax
+// -----------------------------
+constexpr uint8_t  TOAST_STAGE_CMDS     = 3;       // Station commands per stage, sent together
+constexpr uint8_t  TOAST_QUEUE_DEPTH    = 8;       // Slice requests waiting for the machine
+constexpr int16_t  TOAST_GATE_RESET     = 0;       // Gate angles
+constexpr int16_t  TOAST_GATE_BUTTER    = 90;
+constexpr int16_t  TOAST_GATE_TOAST     = 180;
+constexpr int16_t  TOAST_FLIP_OPEN      = 0;       // Flipper angles
+constexpr int16_t  TOAST_FLIP_CLOSED    = 90;
+constexpr int16_t  TOAST_FLIP_DISPENSE  = 180;
+constexpr int16_t  TOAST_PUSH_FRAMES    = 25;      // Pusher out and back
+constexpr uint32_t TOAST_BRAND_TIMEOUT_MS = 30000;   // No brand by then (iron never ready): toast without it
+
+/* Typedefs */
+typedef struct toast_cmd {
+  uint8_t op;               // link_op
+  uint8_t servos;           // LINK_SERVO_* mask, 0: unused
+  int16_t arg;
+} toast_cmd;
+
+typedef struct toast_stage_cfg {
+  toast_cmd cmds[TOAST_STAGE_CMDS];   // Sent together on entry ...
+  uint16_t waitMs;                    // ... then this long after the last DONE
+  bool brandFirst;                    // Brand before the commands
+  bool button;                        // Wait for a slice request, nothing else
+} toast_stage_cfg;
+
+// -----------------------------
+// The line, one entry per toast_stage
+// -----------------------------
+constexpr toast_stage_cfg TOAST_STAGES[TOAST_STAGE_COUNT] = {
+  { {}, 0, false, true },                                             // STATE_B_DETECT_BUTTON
+  { { { LINK_OP_ANGLE, LINK_SERVO_TOWERPRO, TOAST_GATE_RESET },
+      { LINK_OP_ANGLE, LINK_SERVO_PARALLAX, TOAST_FLIP_OPEN },
+      { LINK_OP_OPEN,  LINK_SERVO_BOTTOM, 0 } }, 500, false, false },  // STATE_B_DROP
+  { { { LINK_OP_ANGLE, LINK_SERVO_TOWERPRO, TOAST_GATE_BUTTER } }, 400, false, false },        // STATE_B_BUTTER
+  { { { LINK_OP_ANGLE, LINK_SERVO_TOWERPRO, TOAST_GATE_TOAST } }, 700, true, false },          // STATE_B_TOAST
+  { { { LINK_OP_BOUNCE, LINK_SERVO_CONTINUOUS, TOAST_PUSH_FRAMES } }, 300, false, false },     // STATE_B_DISPENSE
+  { {}, 0, false, true },                                             // STATE_T_DETECT_BUTTON
+  { { { LINK_OP_ANGLE, LINK_SERVO_TOWERPRO, TOAST_GATE_RESET },
+      { LINK_OP_ANGLE, LINK_SERVO_PARALLAX, TOAST_FLIP_CLOSED },
+      { LINK_OP_OPEN,  LINK_SERVO_TOP, 0 } }, 500, false, false },     // STATE_T_DROP
+  { { { LINK_OP_ANGLE, LINK_SERVO_TOWERPRO, TOAST_GATE_BUTTER } }, 400, false, false },        // STATE_T_BUTTER
+  { { { LINK_OP_ANGLE, LINK_SERVO_TOWERPRO, TOAST_GATE_TOAST } }, 700, true, false },          // STATE_T_TOAST
+  { { { LINK_OP_ANGLE, LINK_SERVO_PARALLAX, TOAST_FLIP_DISPENSE } }, 300, false, false },      // STATE_T_DISPENSE
+};
+
+enum toast_phase : uint8_t {
+  TOAST_IDLE,               // Button stage, no request yet
+  TOAST_BRAND,              // Waiting for the brand
+  TOAST_SEND,               // Commands the link had no room for go out on the next poll
+  TOAST_MOVE,               // Waiting for every DONE
+  TOAST_WAIT,               // Stage wait
+};
+
+// TOAST: true once the brand is in (or there is none to give), TOAST_BRAND_TIMEOUT_MS at most
+typedef bool (*toast_brand_fn)(void* arg);
+
+typedef struct toast_line_stats {
+  uint32_t requests;        // Slice requests (button presses)
+  uint32_t refused;         // Requests with the queue full
+  uint32_t slices;          // Dispensed
+  uint32_t faults;          // Commands that failed or timed out, the line carries on
+  uint32_t sendRetries;     // Polls the link had no room for a command
+  uint32_t brandTimeouts;   // TOAST stages that went on without the brand
+  uint32_t lastCycleMs;     // Request to dispensed
+  uint32_t maxCycleMs;
+  uint64_t sumCycleMs;
+  uint32_t maxQueueMs;      // Request to the machine taking it
+  uint64_t sumQueueMs;
+  uint32_t moves;           // Stages with commands ...
+  uint32_t maxMoveMs;       // ... first send to the last DONE
+  uint64_t sumMoveMs;
+  uint64_t stageMs[TOAST_STAGE_COUNT];  // Time spent per stage
+} toast_line_stats;
+
+struct toast_line;
+
+// DONE callback argument, one per command slot
+typedef struct toast_ticket {
+  toast_line* line;
+  uint8_t bit;
+} toast_ticket;
+
+typedef struct toast_line {
+  const toast_stage_cfg* stages;
+  station_link* link;
+  uint8_t mac[6];
+  toast_brand_fn brand;
+  void* brandArg;
+  // Owned by the poll
+  uint8_t stage;            // toast_stage
+  uint8_t phase;            // toast_phase
+  uint8_t jumpTo;           // Requested stage, TOAST_STAGE_COUNT: none
+  uint8_t unsent;           // Command slots not on the link yet
+  uint8_t sent;
+  uint32_t stageStartMs;
+  uint32_t phaseStartMs;
+  uint32_t sliceStartMs;    // Request time of the slice in the machine
+  toast_ticket tickets[TOAST_STAGE_CMDS];
+  // Stage commands finishing, from the receive callback
+  hal_lock lock;
+  uint8_t done;
+  uint8_t failed;
+  // Slice requests, any context
+  uint32_t requestMs[TOAST_QUEUE_DEPTH];
+  uint8_t requestHead;
+  uint8_t requestCount;
+  toast_line_stats stats;
+} toast_line;
+
+/* Public Function Definitions */
+void toastLineInit(toast_line* t, const toast_stage_cfg* stages, station_link* link, const uint8_t* mac,
+                   toast_brand_fn brand = NULL, void* brandArg = NULL);
+bool toastLineRequest(toast_line* t);            // Button: one more slice, false if the queue is full
+void toastLinePoll(toast_line* t);               // Every loop frame
+void toastLineJump(toast_line* t, uint8_t stage);   // Once the current stage's commands are in
+void toastLineStats(toast_line* t, toast_line_stats* out);
+
+#endif // TOAST_LINE_H
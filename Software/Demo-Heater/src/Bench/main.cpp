@@ -0,0 +1,336 @@
+/* Chef Bench
+ *
+ * Cycles per call of the Chef's hot kernels and what one 10 ms tick costs in all.
+ * On the board (src_dir = src/Bench/) setup() runs the suite once and prints the
+ * results as JSON; capture the serial monitor to a file. Natively (pio run -e native)
+ * it runs the same suite and writes the results file itself:
+ *
+ *   chef_bench                              bench_results.json
+ *   chef_bench -b bench_baseline.json       ... and compare, exit 1 if anything got slower
+ *   chef_bench -c board.log -b base.json    compare a board capture, run nothing
+ *
+ *   -o <file>   Results file
+ *   -t <pct>    Tolerance before a kernel counts as slower (BENCH_TOLERANCE_PCT)
+ *
+ * Baselines are per platform: keep one per board build and one per build machine.
+ * The station's output path (angle to pulse to duty, the motion tick) has a bench
+ * of its own, Demo-Servo src/Bench/.
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifndef ARDUINO
+#include <unistd.h>
+#endif
+#include "hal.h"
+#include "micro_bench.h"
+#include "led_anim.h"
+#include "sound_bands.h"
+#include "sound_gauge.h"
+#include "cmd_shell.h"
+#include "print_queue.h"
+#include "servo_trajectory.h"
+#include "fader_link.h"
+#include "station_link.h"
+
+/* Constants */
+constexpr uint32_t BENCH_CALLS          = 1000;
+constexpr uint32_t BENCH_BLOCK_CALLS    = 50;       // A sound block is 128 samples of work
+constexpr uint32_t BENCH_TICK_US        = 10000;    // The Chef's 10 ms sound/LED tick
+constexpr int      BENCH_PWM_MAX        = 4095 * 60 / 100;
+
+// As the Chef: tones it listens to and the machine noise it rejects
+const sound_tone benchTones[] = {
+  {  500, TONE_TRIGGER }, {  700, TONE_TRIGGER }, { 1500, TONE_TRIGGER }, { 2500, TONE_TRIGGER },
+  { 1000, TONE_MACHINE }, { 2000, TONE_MACHINE },
+};
+
+// Same servo limits as the Demo-Servo DS dropper
+constexpr traj_limits BENCH_TRAJ_LIMITS = { 4000, 40000 };
+
+const uint8_t benchStationMac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+/* Statics */
+static bench_suite suite;
+static uint8_t grb[GAUGE_FRAME_SIZE];
+static uint16_t soundBlock[SOUND_BLOCK_SIZE];
+static int16_t soundSigned[SOUND_BLOCK_SIZE];
+static int16_t fftRe[SOUND_BLOCK_SIZE];
+static int16_t fftIm[SOUND_BLOCK_SIZE];
+static int32_t goertzelCoeff;
+static sound_bands_result bands;
+static sound_gauge gauge;
+static traj_state traj;
+static fader_link_tx faderTx;
+static fader_link_rx faderRx;
+static fader_link_pos faderPkt;
+static station_link stationLink;
+static link_report report;
+static volatile uint32_t sink;
+
+#ifndef ARDUINO
+static const char* outPath = "bench_results.json";
+static const char* basePath = NULL;
+static const char* capturePath = NULL;
+static uint8_t tolerancePct = BENCH_TOLERANCE_PCT;
+#endif
+
+/* Private Function Definitions */
+static void onCmd(int argc, char** argv) { sink += argc; }
+
+// The Chef's command words, an unknown one falls through the whole table
+const shell_cmd benchCommands[] = {
+  { "A", NULL, onCmd }, { "M", NULL, onCmd }, { "F", NULL, onCmd }, { "fd", NULL, onCmd },
+  { "H", NULL, onCmd }, { "heat", NULL, onCmd }, { "brand", NULL, onCmd }, { "trip", NULL, onCmd },
+  { "st", NULL, onCmd }, { "sv", NULL, onCmd }, { "help", NULL, onCmd },
+};
+constexpr uint8_t BENCH_NUM_COMMANDS = sizeof(benchCommands) / sizeof(benchCommands[0]);
+
+// A voice tone, some heater PWM hum and the sensor bias, 12-bit
+static void fillSoundBlock() {
+  for (uint16_t n = 0; n < SOUND_BLOCK_SIZE; ++n) {
+    float t = (float)n / SOUND_SAMPLE_RATE_HZ;
+    float v = 2048.0f + 300.0f * sinf(2.0f * (float)M_PI * 700.0f * t) + 80.0f * sinf(2.0f * (float)M_PI * 1000.0f * t);
+    soundBlock[n] = (uint16_t)v;
+    soundSigned[n] = (int16_t)(((int32_t)soundBlock[n] - 2048) * 8);   // As the analyzer scales it
+  }
+  goertzelCoeff = goertzelCoeffQ14(700, SOUND_SAMPLE_RATE_HZ);
+}
+
+// FUNCTION: The float gradient the gauge table replaced, as loop() rendered it before,
+// into wire order G,R,B. Kept as the reference the table is timed and checked against.
+static uint8_t gaugeLerp(uint8_t a, uint8_t b, float t) {
+  return a + (b - a) * t;
+}
+
+static void gaugeRenderFloat(int step, uint8_t* out) {
+  float progress = (float)step / (GAUGE_PIXELS - 1);
+  float globalBrightness = pow(progress, 2.2) * 0.9 + 0.1;
+
+  for (int i = 0; i < GAUGE_PIXELS; i++) {
+    float ratio = (float)i / (GAUGE_PIXELS - 1);
+    uint8_t r, g;
+    if (ratio < 0.15) {
+      float t = ratio / 0.15;
+      r = gaugeLerp(0, 255, t);   g = gaugeLerp(255, 255, t);
+    } else if (ratio < 0.35) {
+      float t = (ratio - 0.15) / 0.20;
+      r = gaugeLerp(255, 255, t); g = gaugeLerp(255, 120, t);
+    } else {
+      float t = (ratio - 0.35) / 0.65;
+      r = gaugeLerp(255, 255, t); g = gaugeLerp(120, 0, t);
+    }
+    bool lit = i <= step;
+    out[i * 3 + 0] = lit ? (uint8_t)(g * globalBrightness) : 0;
+    out[i * 3 + 1] = lit ? (uint8_t)(r * globalBrightness) : 0;
+    out[i * 3 + 2] = 0;
+  }
+}
+
+// FUNCTION: Every table frame against the float render, byte for byte
+static void checkGaugeTable() {
+  uint8_t ref[GAUGE_FRAME_SIZE];
+  int bad = -1;
+  for (int step = 0; step < GAUGE_STEPS && bad < 0; ++step) {
+    gaugeRenderFloat(step, ref);
+    if (memcmp(ref, gaugeFrame(step), GAUGE_FRAME_SIZE) != 0) bad = step;
+  }
+  char line[64];
+  if (bad < 0) snprintf(line, sizeof(line), "gauge table matches the float render, %u steps\n", GAUGE_STEPS);
+  else         snprintf(line, sizeof(line), "gauge table DIFFERS from the float render at step %d\n", bad);
+  halPrint(line);
+}
+
+// -----------------------------
+// Kernels, i is the call number
+// -----------------------------
+static void benchLedCompose(uint32_t i) {
+  ledAnimSetGauge((uint16_t)(i * 1237));
+  sink += ledAnimCompose(i, grb);
+}
+
+// The gauge render before and after the frame table
+static void benchGaugeFloat(uint32_t i) {
+  gaugeRenderFloat((int)(i % GAUGE_STEPS), grb);
+}
+
+static void benchGaugeTable(uint32_t i) {
+  memcpy(grb, gaugeFrame((int)(i % GAUGE_STEPS)), GAUGE_FRAME_SIZE);
+}
+
+static void benchSoundBlock(uint32_t i) {
+  soundBandsProcess(soundBlock, SOUND_BLOCK_SIZE, &bands);
+}
+
+// The two analyzers' kernels, per block: one Goertzel tone, one 128-point FFT
+static void benchGoertzel(uint32_t i) {
+  sink += (uint32_t)goertzelPower(soundSigned, SOUND_BLOCK_SIZE, goertzelCoeff);
+}
+
+static void benchSoundFft(uint32_t i) {
+  memcpy(fftRe, soundSigned, sizeof(fftRe));
+  memset(fftIm, 0, sizeof(fftIm));
+  fftRadix2Q15(fftRe, fftIm, SOUND_BLOCK_LOG2);
+  sink += (uint16_t)fftRe[16];
+}
+
+static void benchSoundGauge(uint32_t i) {
+  static const uint16_t levels[8] = { 10, 30, 60, 90, 150, 250, 400, 20 };
+  soundGaugeStep(&gauge, levels[(i >> 4) & 7], BENCH_PWM_MAX);
+  sink += soundGaugeQ16(&gauge);
+}
+
+static void benchTrajPlan(uint32_t i) {
+  trajPlan(&traj, TRAJ_SCURVE, 1000, (uint16_t)(1500 + (i & 0x3FF)), &BENCH_TRAJ_LIMITS, 0);
+}
+
+static void benchTrajSample(uint32_t i) {
+  sink += trajSample(&traj, i % (trajDurationMs(&traj) + 1));
+}
+
+static void benchShellDispatch(uint32_t i) {
+  char line[SHELL_LINE_MAX];
+  strcpy(line, (i & 1) ? "sv a 90 3" : "hello station");   // Known word, or the fallback
+  shellDispatch(line, benchCommands, BENCH_NUM_COMMANDS, onCmd);
+}
+
+static void benchShellParseInt(uint32_t i) {
+  long v;
+  if (shellParseInt("-1234", &v)) sink += (uint32_t)v;
+}
+
+static void benchEnqueuePrint(uint32_t i) {
+  enqueuePrint("Sound: %d, Machine: %u, Smooth: %.0f, Gauge: %.2f, Step: %d, Cycles: %lu\n",
+               (int)(i & 0xFF), 12u, gauge.smooth, gauge.level, (int)(i & 15), (unsigned long)i);
+  printQueueFlush();
+}
+
+static void benchFaderEncode(uint32_t i) {
+  faderLinkTxStamp(&faderTx, &faderPkt, 0, (uint16_t)(i * 64), 0, i, i);
+}
+
+static void benchFaderDecode(uint32_t i) {
+  faderPkt.seq = (uint16_t)i;
+  const uint8_t* data = (const uint8_t*)&faderPkt;
+  if (faderLinkIsPos(data, sizeof(faderPkt))) {
+    fader_link_pos pkt;
+    memcpy(&pkt, data, sizeof(pkt));
+    sink += faderLinkRxAccept(&faderRx, pkt.seq, i * 10000);
+  }
+}
+
+// Not one of ours: the whole pending table is searched
+static void benchStationReport(uint32_t i) {
+  report.seq = (uint16_t)i;
+  sink += stationOnRecv(&stationLink, benchStationMac, (const uint8_t*)&report, sizeof(report));
+}
+
+static uint32_t resultCycles(const char* name) {
+  const bench_result* r = benchFind(&suite, name);
+  return r ? r->cycles : 0;
+}
+
+// FUNCTION: Everything the Chef does per 10 ms tick: one LED frame, one gauge step,
+// 10/16 of a sound block, one fader packet, one command line and a tenth of a
+// debug print
+static void addTick() {
+  uint32_t tick = resultCycles("led_compose") + resultCycles("sound_gauge") +
+                  resultCycles("sound_block") * 10 / 16 + resultCycles("fader_decode") +
+                  resultCycles("shell_dispatch") + resultCycles("enqueue_print") / 10;
+  benchAdd(&suite, "tick_10ms", tick, 1);
+  uint32_t pct100 = (uint32_t)((uint64_t)tick * 10000 / ((uint64_t)suite.mhz * BENCH_TICK_US));
+  char line[96];
+  snprintf(line, sizeof(line), "tick_10ms %lu cycles, %lu us at %lu MHz, %lu.%02lu%% of the tick\n",
+           (unsigned long)tick, (unsigned long)(tick / suite.mhz), (unsigned long)suite.mhz,
+           (unsigned long)(pct100 / 100), (unsigned long)(pct100 % 100));
+  halPrint(line);
+}
+
+static void runSuite() {
+  // Kernel state as the running Chef would have it
+  fillSoundBlock();
+  soundBandsInit(benchTones, sizeof(benchTones) / sizeof(benchTones[0]));
+  soundGaugeInit(&gauge);
+  ledAnimSetStageColor(0xFF, 0x40, 0x00);
+  printQueueInit();
+  stationInit(&stationLink);
+  report = link_report();
+  report.magic = LINK_MAGIC;
+  report.op = LINK_OP_ACK;
+  benchTrajPlan(0);
+  checkGaugeTable();
+
+  benchInit(&suite, "chef");
+  benchRun(&suite, "led_compose", benchLedCompose, BENCH_CALLS);
+  benchRun(&suite, "gauge_float", benchGaugeFloat, BENCH_CALLS);
+  benchRun(&suite, "gauge_table", benchGaugeTable, BENCH_CALLS);
+  benchRun(&suite, "sound_block", benchSoundBlock, BENCH_BLOCK_CALLS);
+  benchRun(&suite, "sound_goertzel", benchGoertzel, BENCH_BLOCK_CALLS);
+  benchRun(&suite, "sound_fft", benchSoundFft, BENCH_BLOCK_CALLS);
+  benchRun(&suite, "sound_gauge", benchSoundGauge, BENCH_CALLS);
+  benchRun(&suite, "traj_plan", benchTrajPlan, BENCH_CALLS);
+  benchRun(&suite, "traj_sample", benchTrajSample, BENCH_CALLS);
+  benchRun(&suite, "shell_dispatch", benchShellDispatch, BENCH_CALLS);
+  benchRun(&suite, "shell_parse_int", benchShellParseInt, BENCH_CALLS);
+  benchRun(&suite, "enqueue_print", benchEnqueuePrint, BENCH_CALLS);
+  benchRun(&suite, "fader_encode", benchFaderEncode, BENCH_CALLS);
+  benchRun(&suite, "fader_decode", benchFaderDecode, BENCH_CALLS);
+  benchRun(&suite, "station_report", benchStationReport, BENCH_CALLS);
+  addTick();
+}
+
+/* Public Function Definitions */
+#ifdef ARDUINO
+void setup() {
+  halConsoleBegin(115200);
+  halDelayMs(2000);   // Time to open the monitor
+  runSuite();
+  benchPrintJson(&suite);
+}
+
+void loop() {
+  halDelayMs(1000);
+}
+#else
+int main(int argc, char** argv) {
+  int opt;
+  while ((opt = getopt(argc, argv, "o:b:c:t:")) != -1) {
+    switch (opt) {
+      case 'o': outPath = optarg; break;
+      case 'b': basePath = optarg; break;
+      case 'c': capturePath = optarg; break;
+      case 't': tolerancePct = (uint8_t)atoi(optarg); break;
+      default:
+        fprintf(stderr, "chef_bench [-o results.json] [-b baseline.json] [-c board.log] [-t pct]\n");
+        return 2;
+    }
+  }
+
+  if (capturePath) {
+    if (!basePath || !benchLoadJson(&suite, capturePath)) {
+      fprintf(stderr, "-c needs a capture with results and a baseline (-b)\n");
+      return 2;
+    }
+  } else {
+    runSuite();
+    if (!benchWriteJson(&suite, outPath)) {
+      fprintf(stderr, "Cannot write %s\n", outPath);
+      return 2;
+    }
+    printf("%u results in %s\n", suite.count, outPath);
+  }
+
+  if (!basePath) return 0;
+  bench_suite base;
+  if (!benchLoadJson(&base, basePath)) {
+    fprintf(stderr, "No results in %s\n", basePath);
+    return 2;
+  }
+  uint8_t slower = benchCompare(&suite, &base, tolerancePct);
+  printf("%u of %u slower than %s by more than %u%%\n", slower, suite.count, basePath, tolerancePct);
+  return slower ? 1 : 0;
+}
+#endif
@@ -0,0 +1,317 @@
+/* Heater Control Driver */
+
+/* Includes */
+#include <SPI.h>
+#include <esp_timer.h>
+#include "heater_control.h"
+#include "heater_safety.h"
+
+/* Typedefs */
+enum heater_request : uint8_t {
+  HEATER_REQ_NONE,
+  HEATER_REQ_PROFILE,
+  HEATER_REQ_STOP,
+  HEATER_REQ_DOSE,
+};
+
+/* Statics */
+static uint8_t channel = 0;
+static uint32_t dutyMax = 255;
+static TaskHandle_t heaterTaskHandle = NULL;
+static StackType_t heaterStack[HEATER_TASK_STACK];
+static StaticTask_t heaterTcb;
+static esp_timer_handle_t burstTimer = NULL;
+static uint32_t (*supplyFn)() = NULL;
+
+// Owned by the heater task
+static heater_pid pid;
+static heater_profile profile;
+static heater_state state = HEATER_OFF;
+static float tempC = 0.0f;
+static float internalC = 0.0f;
+static uint8_t faultRun = 0;
+static uint32_t startMs = 0;
+static uint32_t inBandMs = 0;
+static uint32_t doseStartMs = 0;
+
+static portMUX_TYPE heaterMux = portMUX_INITIALIZER_UNLOCKED;
+static bool owned = false;   // The task may write the PWM channel
+static uint8_t request = HEATER_REQ_NONE;
+static heater_profile requestProfile;
+static heater_dose_cfg requestDose;
+static heater_status status = {};
+static heater_dose dose;     // Burst timer while running, under the lock
+static uint32_t lastSlotUs = 0;
+
+/* Private Function Definitions */
+// Under the lock: once heaterStop() returns no write of ours can land on the channel
+static inline void writeDutyLocked(float duty) {
+  if (owned) ledcWrite(channel, (uint32_t)(duty * dutyMax + 0.5f));
+}
+
+static inline void writeDuty(float duty) {
+  portENTER_CRITICAL(&heaterMux);
+  writeDutyLocked(duty);
+  portEXIT_CRITICAL(&heaterMux);
+}
+
+static inline float supplyVolts() {
+  return supplyFn ? (float)supplyFn() / 1000.0f : 0.0f;
+}
+
+// FUNCTION: Slot boundary (esp_timer task): book the slot that ended, set the next one
+static void onBurstSlot(void* arg) {
+  uint32_t now = (uint32_t)esp_timer_get_time();
+  float volts = supplyVolts();
+  portENTER_CRITICAL(&heaterMux);
+  float slotS = (float)(now - lastSlotUs) / 1000000.0f;
+  lastSlotUs = now;
+  writeDutyLocked(heaterDoseSlot(&dose, volts, slotS));
+  portEXIT_CRITICAL(&heaterMux);
+}
+
+// FUNCTION: One MAX31855 frame. Returns 0 and the temperatures, or HEATER_TC_* fault bits.
+static uint8_t readThermocouple(float* tc, float* internal) {
+  SPI.beginTransaction(SPISettings(HEATER_TC_SPI_HZ, MSBFIRST, SPI_MODE0));
+  digitalWrite(HEATER_TC_CS, LOW);
+  uint32_t raw = SPI.transfer32(0);
+  digitalWrite(HEATER_TC_CS, HIGH);
+  SPI.endTransaction();
+
+  if (raw == 0 || raw == 0xFFFFFFFF) return HEATER_TC_NO_SENSOR;   // Nothing driving MISO
+  if (raw & 0x00010000) return raw & 0x07;
+  *tc = (float)((int16_t)(raw >> 16) >> 2) * 0.25f;             // 14 bits, signed
+  *internal = (float)((int16_t)(raw & 0xFFFF) >> 4) * 0.0625f;   // 12 bits, signed
+  return 0;
+}
+
+// FUNCTION: Where the heater stands against the profile, per sample
+static void trackProfile(uint32_t nowMs) {
+  bool inBand = fabsf(tempC - profile.setpointC) <= profile.bandC;
+  if (tempC - profile.setpointC > status.overshootC) status.overshootC = tempC - profile.setpointC;
+  if (!inBand) {
+    state = HEATER_HEATING;
+    return;
+  }
+  if (state == HEATER_HEATING) {
+    state = HEATER_SOAK;
+    inBandMs = nowMs;
+    if (!status.timeToTempMs) status.timeToTempMs = nowMs - startMs;
+  }
+  if (state == HEATER_SOAK && nowMs - inBandMs >= profile.soakMs) state = HEATER_READY;
+}
+
+// FUNCTION: Stop the burst timer, outcome into the status. Call with the dose no longer running.
+static void endDose(uint32_t nowMs) {
+  esp_timer_stop(burstTimer);
+  portENTER_CRITICAL(&heaterMux);
+  heaterDoseAbort(&dose);
+  status.doseResult = dose.result;
+  status.doseJ = dose.deliveredJ;
+  status.doseMs = nowMs - doseStartMs;
+  status.doseSlots = dose.slots;
+  status.doseOnSlots = dose.onSlots;
+  portEXIT_CRITICAL(&heaterMux);
+}
+
+// FUNCTION: A dose request that never ran, into the status so the last dose's numbers
+// are not taken for it. Call under the lock.
+static void dropDoseLocked(uint8_t result, float targetJ) {
+  status.doseResult = result;
+  status.doseTargetJ = targetJ;
+  status.doseJ = 0.0f;
+  status.doseMs = 0;
+  status.doseSlots = 0;
+  status.doseOnSlots = 0;
+}
+
+// FUNCTION: Fixed-rate loop: request, sample, control, drive
+static void heaterTask(void* parameter) {
+  TickType_t wake = xTaskGetTickCount();
+
+  while (true) {
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(1000 / HEATER_SAMPLE_HZ));
+    uint32_t t0 = micros();
+    uint32_t nowMs = millis();
+
+    // 1. Take the latest request
+    portENTER_CRITICAL(&heaterMux);
+    uint8_t req = request;
+    heater_profile next = requestProfile;
+    heater_dose_cfg doseCfg = requestDose;
+    request = HEATER_REQ_NONE;
+    bool doseRunning = dose.result == HEATER_DOSE_RUNNING;
+    portEXIT_CRITICAL(&heaterMux);
+
+    // 2. Sample, a lost sensor or a safety trip while heating turns it off
+    float tc, internal;
+    uint8_t fault = readThermocouple(&tc, &internal);
+    if (!fault) {
+      faultRun = 0;
+      tempC = tc;
+      internalC = internal;
+    } else if (faultRun < HEATER_SENSOR_FAULTS) {
+      faultRun++;
+    }
+    heaterSafetyFeed(!fault, tempC);
+    bool sensorLost = faultRun >= HEATER_SENSOR_FAULTS || heaterSafetyTripped();
+
+    // 3. Apply the request, anything but a dose ends a running one
+    if (state == HEATER_DOSE && (req == HEATER_REQ_STOP || req == HEATER_REQ_PROFILE || sensorLost)) {
+      endDose(nowMs);
+      doseRunning = false;
+    }
+    if (req == HEATER_REQ_STOP) {
+      state = HEATER_OFF;
+      heaterPidReset(&pid);
+    } else if (req == HEATER_REQ_PROFILE) {
+      profile = next;
+      state = HEATER_HEATING;
+      startMs = nowMs;
+      heaterPidReset(&pid);
+      heaterPidSetTarget(&pid, profile.setpointC, profile.rampCPerS, tempC);
+      portENTER_CRITICAL(&heaterMux);
+      status.timeToTempMs = 0;
+      status.overshootC = 0.0f;
+      portEXIT_CRITICAL(&heaterMux);
+    } else if (req == HEATER_REQ_DOSE && state != HEATER_OFF && state != HEATER_FAULT && state != HEATER_DOSE) {
+      state = HEATER_DOSE;
+      doseStartMs = nowMs;
+      portENTER_CRITICAL(&heaterMux);
+      heaterDoseStart(&dose, &doseCfg);
+      lastSlotUs = (uint32_t)esp_timer_get_time();
+      writeDutyLocked(heaterDoseSlot(&dose, supplyVolts(), HEATER_BURST_SLOT_MS / 1000.0f));
+      status.doseResult = HEATER_DOSE_RUNNING;
+      status.doseTargetJ = doseCfg.targetJ;
+      status.doses++;
+      portEXIT_CRITICAL(&heaterMux);
+      esp_timer_start_periodic(burstTimer, HEATER_BURST_SLOT_MS * 1000UL);
+      doseRunning = true;
+    } else if (req == HEATER_REQ_DOSE) {
+      portENTER_CRITICAL(&heaterMux);
+      dropDoseLocked(HEATER_DOSE_REJECTED, doseCfg.targetJ);
+      portEXIT_CRITICAL(&heaterMux);
+    }
+
+    // 4. Dose over: back to the profile where it left off
+    if (state == HEATER_DOSE && !doseRunning) {
+      endDose(nowMs);
+      state = HEATER_HEATING;
+      heaterPidReset(&pid);
+    }
+
+    // 5. Control. A single bad reading keeps the last duty.
+    bool active = state != HEATER_OFF && state != HEATER_FAULT && state != HEATER_DOSE;
+    if (sensorLost && state != HEATER_OFF && state != HEATER_FAULT) {
+      state = HEATER_FAULT;
+      heaterPidReset(&pid);
+      writeDuty(0.0f);
+    } else if (active && !fault) {
+      writeDuty(heaterPidStep(&pid, tempC));
+      trackProfile(nowMs);
+    }
+    uint32_t us = micros() - t0;
+
+    // 6. Snapshot for heaterStatus()
+    portENTER_CRITICAL(&heaterMux);
+    status.state = state;
+    status.tempC = tempC;
+    status.internalC = internalC;
+    status.setpointC = pid.setpoint;
+    status.targetC = pid.target;
+    status.duty = (state == HEATER_DOSE) ? dose.duty : (active ? pid.duty : 0.0f);
+    if (state == HEATER_DOSE) {
+      status.doseJ = dose.deliveredJ;
+      status.doseMs = nowMs - doseStartMs;
+    }
+    status.supplyMv = supplyFn ? supplyFn() : 0;
+    if (fault) {
+      status.sensorFault = fault;
+      status.sensorFaults++;
+    }
+    status.samples++;
+    status.lastSampleUs = us;
+    portEXIT_CRITICAL(&heaterMux);
+  }
+}
+
+static void postRequest(heater_request req, const heater_profile* p) {
+  portENTER_CRITICAL(&heaterMux);
+  if (request == HEATER_REQ_DOSE) dropDoseLocked(HEATER_DOSE_ABORTED, requestDose.targetJ);   // Overtaken before the task saw it
+  request = req;
+  owned = req == HEATER_REQ_PROFILE;
+  if (p) requestProfile = *p;
+  portEXIT_CRITICAL(&heaterMux);
+}
+
+/* Public Function Definitions */
+bool heaterBegin(uint8_t pwmChannel, uint32_t pwmMax, const heater_pid_cfg* cfg) {
+  if (heaterTaskHandle) return true;
+  channel = pwmChannel;
+  dutyMax = pwmMax;
+  heaterPidInit(&pid, cfg, 1.0f / HEATER_SAMPLE_HZ);
+  dose.result = HEATER_DOSE_DONE;
+
+  pinMode(HEATER_TC_CS, OUTPUT);
+  digitalWrite(HEATER_TC_CS, HIGH);
+  SPI.begin(HEATER_TC_SCK, HEATER_TC_MISO, -1, HEATER_TC_CS);
+
+  esp_timer_create_args_t args = {};
+  args.callback = onBurstSlot;
+  args.name = "heater_burst";
+  if (esp_timer_create(&args, &burstTimer) != ESP_OK) return false;
+
+  heaterTaskHandle = xTaskCreateStaticPinnedToCore(heaterTask, "Heater Task", HEATER_TASK_STACK, NULL,
+                                                   HEATER_TASK_PRIORITY, heaterStack, &heaterTcb, HEATER_TASK_CORE);
+  return heaterTaskHandle != NULL;
+}
+
+void heaterSetProfile(const heater_profile* p) { postRequest(HEATER_REQ_PROFILE, p); }
+
+void heaterStop() {
+  postRequest(HEATER_REQ_STOP, NULL);
+  ledcWrite(channel, 0);
+}
+
+void heaterSetSupply(uint32_t (*supplyMv)()) {
+  supplyFn = supplyMv;
+}
+
+bool heaterDose(const heater_dose_cfg* cfg) {
+  if (!supplyFn || !supplyFn() || heaterSafetyTripped()) return false;
+  portENTER_CRITICAL(&heaterMux);
+  bool ok = owned && request == HEATER_REQ_NONE;
+  if (ok) {
+    request = HEATER_REQ_DOSE;
+    requestDose = *cfg;
+  }
+  portEXIT_CRITICAL(&heaterMux);
+  return ok;
+}
+
+bool heaterDosing() {
+  portENTER_CRITICAL(&heaterMux);
+  bool dosing = request == HEATER_REQ_DOSE || status.doseResult == HEATER_DOSE_RUNNING;
+  portEXIT_CRITICAL(&heaterMux);
+  return dosing;
+}
+
+bool heaterReady() {
+  portENTER_CRITICAL(&heaterMux);
+  bool ready = status.state == HEATER_READY;
+  portEXIT_CRITICAL(&heaterMux);
+  return ready;
+}
+
+bool heaterFaulted() {
+  portENTER_CRITICAL(&heaterMux);
+  bool fault = status.state == HEATER_FAULT;
+  portEXIT_CRITICAL(&heaterMux);
+  return fault;
+}
+
+void heaterStatus(heater_status* out) {
+  portENTER_CRITICAL(&heaterMux);
+  *out = status;
+  portEXIT_CRITICAL(&heaterMux);
+}
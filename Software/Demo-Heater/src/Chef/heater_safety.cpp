@@ -0,0 +1,189 @@
+/* Heater Safety Driver */
+
+/* Includes */
+#include <esp32/rom/gpio.h>
+#include <soc/gpio_sig_map.h>
+#include <soc/gpio_struct.h>
+#include "heater_safety.h"
+
+/* Statics */
+static uint8_t pin = 0;
+static uint8_t channel = 0;
+static uint32_t dutyMax = 255;
+static heater_trip_fn tripFn = NULL;
+static TaskHandle_t safetyTaskHandle = NULL;
+static StackType_t safetyStack[HEATER_SAFE_STACK];
+static StaticTask_t safetyTcb;
+
+static portMUX_TYPE safetyMux = portMUX_INITIALIZER_UNLOCKED;
+static bool tripped = false;
+static bool notified = true;    // onTrip called for the current trip
+static uint32_t cuts = 0;       // Every trip() call, lets a reset spot one racing it
+static uint32_t detectUs = 0;   // Of the current trip
+static float lastTempC = 0.0f;
+static uint32_t lastSampleMs = 0;
+static bool sensorSeen = false;   // A first good reading arms STALE and STUCK
+static heater_safety_status status = {};
+
+// Owned by the watchdog task
+static uint32_t stuckStartMs = 0;
+static float stuckStartC = 0.0f;
+
+/* Private Function Definitions */
+// FUNCTION: LEDC off the pin, pin low. ROM call and register writes only, fine in any ISR.
+static inline void IRAM_ATTR cutOutput() {
+  gpio_matrix_out(pin, SIG_GPIO_OUT_IDX, false, false);
+  if (pin < 32) GPIO.out_w1tc = 1UL << pin;
+  else          GPIO.out1_w1tc.val = 1UL << (pin - 32);
+}
+
+// FUNCTION: Cut first, book after. Any context, the first cause of a trip times it.
+static void IRAM_ATTR trip(uint8_t cause, uint32_t t0) {
+  cutOutput();
+  uint32_t us = micros() - t0;
+  portENTER_CRITICAL_ISR(&safetyMux);
+  cuts++;
+  if (!tripped) {
+    tripped = true;
+    notified = false;
+    detectUs = t0;
+    status.trips++;
+    status.cutUs = us;
+    if (us > status.maxCutUs) status.maxCutUs = us;
+  }
+  status.cause |= cause;
+  portEXIT_CRITICAL_ISR(&safetyMux);
+}
+
+// FUNCTION: Trip pin edge, the cutout opened
+static void IRAM_ATTR onTripPin() {
+  trip(HEATER_TRIP_INPUT, micros());
+  if (!safetyTaskHandle) return;   // Before the task exists: its first pass reports the trip
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(safetyTaskHandle, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+// FUNCTION: Checks nothing else can be trusted with, every period or at once when notified
+static void safetyTask(void* parameter) {
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(HEATER_SAFE_PERIOD_MS));
+    uint32_t t0 = micros();
+    uint32_t nowMs = millis();
+    float duty = (float)ledcRead(channel) / dutyMax;
+
+    portENTER_CRITICAL(&safetyMux);
+    float tempC = lastTempC;
+    uint32_t ageMs = nowMs - lastSampleMs;
+    bool armed = sensorSeen;
+    bool isTripped = tripped;
+    portEXIT_CRITICAL(&safetyMux);
+
+    // 1. Trip pin held open, also covers an edge lost while already tripped
+    uint8_t cause = 0;
+    if (HEATER_SAFE_TRIP_PIN >= 0 && digitalRead(HEATER_SAFE_TRIP_PIN) == HIGH) cause |= HEATER_TRIP_INPUT;
+
+    // 2. Heating blind: the heater task stalled or the thermocouple is gone
+    if (armed && duty > 0.0f && ageMs > HEATER_SAFE_STALE_MS) cause |= HEATER_TRIP_STALE;
+
+    // 3. Stuck: near full power and the temperature not following
+    if (!armed || duty < HEATER_SAFE_STUCK_DUTY || tempC - stuckStartC >= HEATER_SAFE_STUCK_RISE) {
+      stuckStartMs = nowMs;
+      stuckStartC = tempC;
+    } else if (nowMs - stuckStartMs >= HEATER_SAFE_STUCK_MS) {
+      cause |= HEATER_TRIP_STUCK;
+    }
+
+    if (cause) trip(cause, t0);
+    else if (isTripped) cutOutput();   // Keep it cut whatever attached the pin since
+
+    // 4. Tell the owner once per trip, from here rather than the ISR
+    portENTER_CRITICAL(&safetyMux);
+    bool notify = tripped && !notified;
+    if (notify) {
+      notified = true;
+      status.notifyUs = micros() - detectUs;
+    }
+    uint8_t tripCause = status.cause;
+    status.duty = duty;
+    status.checks++;
+    portEXIT_CRITICAL(&safetyMux);
+    if (notify && tripFn) tripFn(tripCause);
+  }
+}
+
+/* Public Function Definitions */
+bool heaterSafetyBegin(uint8_t pwmPin, uint8_t pwmChannel, uint32_t pwmMax, heater_trip_fn onTrip) {
+  if (safetyTaskHandle) return true;
+  pin = pwmPin;
+  channel = pwmChannel;
+  dutyMax = pwmMax;
+  tripFn = onTrip;
+  lastSampleMs = millis();
+
+  // Pin first, so the task's first check reads it pulled up rather than floating
+  if (HEATER_SAFE_TRIP_PIN >= 0) {
+    pinMode(HEATER_SAFE_TRIP_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(HEATER_SAFE_TRIP_PIN), onTripPin, RISING);
+  }
+  safetyTaskHandle = xTaskCreateStaticPinnedToCore(safetyTask, "Heater Safety", HEATER_SAFE_STACK, NULL,
+                                                   HEATER_SAFE_PRIORITY, safetyStack, &safetyTcb, HEATER_SAFE_CORE);
+  return safetyTaskHandle != NULL;
+}
+
+void heaterSafetyFeed(bool valid, float tempC) {
+  if (!safetyTaskHandle) return;
+  uint32_t t0 = micros();
+  bool over = valid && tempC > HEATER_SAFE_MAX_C;
+  if (over) trip(HEATER_TRIP_OVER_TEMP, t0);
+
+  portENTER_CRITICAL(&safetyMux);
+  if (valid) {
+    lastTempC = tempC;
+    lastSampleMs = millis();
+    sensorSeen = true;
+  }
+  portEXIT_CRITICAL(&safetyMux);
+  if (over) xTaskNotifyGive(safetyTaskHandle);
+}
+
+bool heaterSafetyTripped() {
+  portENTER_CRITICAL(&safetyMux);
+  bool t = tripped;
+  portEXIT_CRITICAL(&safetyMux);
+  return t;
+}
+
+bool heaterSafetyReset() {
+  uint32_t nowMs = millis();
+  bool pinClosed = HEATER_SAFE_TRIP_PIN < 0 || digitalRead(HEATER_SAFE_TRIP_PIN) == LOW;
+  portENTER_CRITICAL(&safetyMux);
+  bool fresh = !sensorSeen || nowMs - lastSampleMs <= HEATER_SAFE_STALE_MS;
+  bool ok = tripped && pinClosed && fresh && lastTempC < HEATER_SAFE_RESET_C;
+  uint32_t seen = cuts;
+  portEXIT_CRITICAL(&safetyMux);
+  if (!ok) return false;
+
+  // Reconnect at 0, unless something tripped again meanwhile
+  ledcWrite(channel, 0);
+  ledcAttachPin(pin, channel);
+  portENTER_CRITICAL(&safetyMux);
+  bool clean = cuts == seen;
+  if (clean) {
+    tripped = false;
+    status.cause = 0;
+  }
+  portEXIT_CRITICAL(&safetyMux);
+  if (!clean) cutOutput();
+  return clean;
+}
+
+void heaterSafetyStatus(heater_safety_status* out) {
+  uint32_t nowMs = millis();
+  portENTER_CRITICAL(&safetyMux);
+  *out = status;
+  out->tripped = tripped;
+  out->tempC = lastTempC;
+  out->sampleAgeMs = nowMs - lastSampleMs;
+  portEXIT_CRITICAL(&safetyMux);
+}
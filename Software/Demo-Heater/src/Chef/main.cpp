@@ -1,7 +1,18 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <esp_now.h>
-#include <Adafruit_NeoPixel.h>
+#include "hal.h"
+#include "led_anim.h"
+#include "led_output.h"
+#include "sound_input.h"
+#include "sound_gauge.h"
+#include "cmd_shell.h"
+#include "print_queue.h"
+#include "station_link.h"
+#include "toast_line.h"
+#include "fader_follow.h"
+#include "heater_control.h"
+#include "heater_safety.h"
 
 
 //===================================================================================================
@@ -13,18 +24,32 @@
 #define NUMPIXELS       (16)
 #define SOUND_PIN       (34)
 
-#define PERIOD_LED_ERROR  (200)
-#define PERIOD_LED_GOOD   (1000)
-
 #define PWM_DEFAULT_FREQ          (1000)    // 1kHz
 #define PWM_DEFAULT_DUTY          (0)       // 0%
-#define PWM_DEFAULT_RESOLUTION    (8)       // 8-bit: 0-255
+#define PWM_DEFAULT_RESOLUTION    (12)      // 12-bit: 0-4095, fine enough to end a dose on the Joule
+#define PWM_MAX_DUTY              ((1 << PWM_DEFAULT_RESOLUTION) - 1)
 #define PWM_DEFAULT_CHANNEL       (0)
+#define PWM_FADER_MAX             (PWM_MAX_DUTY * 60 / 100)   // The AUDIO mode cap
+#define HEATER_ELEMENT_OHM        (0.96f)   // 150 W at 12 V
 
 #define SERIAL_RATE (115200)
 #define SERIAL_DEBUG                        // Define to enable serial debugging
 
 
+//===================================================================================================
+// Sound Bands
+
+// Tones the gauge listens to, and the machine's own noise it must ignore
+const sound_tone soundTones[] = {
+  {  500, TONE_TRIGGER },   // Voice
+  {  700, TONE_TRIGGER },
+  { 1500, TONE_TRIGGER },
+  { 2500, TONE_TRIGGER },
+  { 1000, TONE_MACHINE },   // Heater PWM, and the fader loop's 1 kHz duty steps (its 20 kHz PWM is above hearing)
+  { 2000, TONE_MACHINE },   // ... and their second harmonic
+};
+
+
 
 
 //===================================================================================================
@@ -52,30 +77,51 @@ void IRAM_ATTR handleInterrupt() {
 //===================================================================================================
 // Finite State Machine
 
-enum state {
-    STATE_B_DETECT_BUTTON,  // 1. Go to STATE_B_DROP 
-    STATE_B_DROP,           // 1. Reset gate (butter/toast), Reset flipper (Open Top) | 2. Open bottom dropper | 3. Wait
-    STATE_B_BUTTER,         // 1. Apply butter | 2. Open gate butter | 3. Wait
-    STATE_B_TOAST,          // 1. Measure sound & heat | 2. Brand | 3. open gate toast | 4. Wait
-    STATE_B_DISPENSE,       // 1. Dispense pusher | 2. Wait
-    STATE_T_DETECT_BUTTON,  // 1. Go to STATE_T_DROP 
-    STATE_T_DROP,           // 1. Reset gate (butter/toast), Reset flipper (Close Top) | 2. Open top dropper | 3. Wait
-    STATE_T_BUTTER,         // 1. Apply butter | 2. Open gate butter | 3. Wait
-    STATE_T_TOAST,          // 1. Measure sound & heat | 2. Brand | 3. open gate toast | 4. Wait
-    STATE_T_DISPENSE,       // 1. Dispense flipper | 2. Wait
+// Stages and their station commands live in toast_line.h (TOAST_STAGES), the
+// button queues slices, loop() walks the stages
+toast_line fsm;
+
+// Brand step of the TOAST stages
+enum brand_step { BRAND_WAIT, BRAND_DOSING, BRAND_DONE };
+brand_step brandStep = BRAND_WAIT;
+
+// Gauge background color per stage (0xRRGGBB), shown on the unlit pixels
+const uint32_t stageColors[] = {
+  0x0000FF,   // STATE_B_DETECT_BUTTON
+  0x00FFFF,   // STATE_B_DROP
+  0xFFC000,   // STATE_B_BUTTER
+  0xFF4000,   // STATE_B_TOAST
+  0x00FF00,   // STATE_B_DISPENSE
+  0x0000FF,   // STATE_T_DETECT_BUTTON
+  0x00FFFF,   // STATE_T_DROP
+  0xFFC000,   // STATE_T_BUTTER
+  0xFF4000,   // STATE_T_TOAST
+  0x00FF00,   // STATE_T_DISPENSE
 };
 
-state fsm = STATE_B_DETECT_BUTTON;
-
-#define DELAY_B_DROP_WAIT            500   // STATE_B_DROP: Wait after opening bottom dropper
-#define DELAY_B_BUTTER_WAIT          400   // STATE_B_BUTTER: Wait after opening butter gate
-#define DELAY_B_TOAST_WAIT           700   // STATE_B_TOAST: Wait after opening toast gate
-#define DELAY_B_DISPENSE_WAIT        300   // STATE_B_DISPENSE: Wait after dispensing pusher
-
-#define DELAY_T_DROP_WAIT            500   // STATE_T_DROP: Wait after opening top dropper
-#define DELAY_T_BUTTER_WAIT          400   // STATE_T_BUTTER: Wait after opening butter gate
-#define DELAY_T_TOAST_WAIT           700   // STATE_T_TOAST: Wait after opening toast gate
-#define DELAY_T_DISPENSE_WAIT        300   // STATE_T_DISPENSE: Wait after dispensing flipper
+// Heater temperature per stage (HEAT mode): setpoint C, ramp C/s (0: full power), band C, soak ms
+const heater_profile heaterProfiles[] = {
+  { 150.0f,  0.0f, 5.0f,    0 },   // STATE_B_DETECT_BUTTON: standby, warm but not branding
+  { 180.0f,  0.0f, 5.0f,    0 },   // STATE_B_DROP: head start while the slice falls
+  { 200.0f,  0.0f, 5.0f,    0 },   // STATE_B_BUTTER
+  { 260.0f,  0.0f, 3.0f, 1500 },   // STATE_B_TOAST: brand, settled at temperature
+  { 150.0f,  0.0f, 5.0f,    0 },   // STATE_B_DISPENSE
+  { 150.0f,  0.0f, 5.0f,    0 },   // STATE_T_DETECT_BUTTON
+  { 180.0f,  0.0f, 5.0f,    0 },   // STATE_T_DROP
+  { 200.0f,  0.0f, 5.0f,    0 },   // STATE_T_BUTTER
+  { 260.0f,  0.0f, 3.0f, 1500 },   // STATE_T_TOAST
+  { 150.0f,  0.0f, 5.0f,    0 },   // STATE_T_DISPENSE
+};
+static_assert(sizeof(heaterProfiles) / sizeof(heaterProfiles[0]) == TOAST_STAGE_COUNT, "One profile per stage");
+static_assert(sizeof(stageColors) / sizeof(stageColors[0]) == TOAST_STAGE_COUNT, "One color per stage");
+
+// TOAST: the brand is an energy dose once the iron is READY, not PWM for a fixed time
+const heater_dose_cfg brandDose = {
+  300.0f,               // targetJ: 2 s at 12 V
+  HEATER_ELEMENT_OHM,
+  1.0f,                 // density: every slot on, shortest brand
+  4000,                 // timeoutMs
+};
 
 
 //===================================================================================================
@@ -83,19 +129,22 @@ state fsm = STATE_B_DETECT_BUTTON;
 
 bool ready = false;
 
-unsigned long previousMillisLED = 0;
 unsigned long previousMillisHello = 0;
 unsigned long previousMillisSound = 0;
 
-long ledInterval = PERIOD_LED_GOOD;      // 1 second
 long helloInterval = 10000;   // 10 seconds
 const long soundInterval = 10;  // More frequent updates for faster reaction
 
+// Who drives the heater PWM
+enum pwm_mode {
+  PWM_MANUAL,     // Serial 0-100 (default)
+  PWM_AUDIO,      // Sound gauge
+  PWM_FADER,      // Remote fader
+  PWM_HEATER,     // Temperature loop, profile per FSM stage
+};
+pwm_mode pwmMode = PWM_MANUAL;
 
-bool ledState = LOW;
-bool audioMode = false;  // Default: Manual-based PWM updates
-
-Adafruit_NeoPixel strip(NUMPIXELS, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
+static_assert(NUMPIXELS == GAUGE_PIXELS, "Gauge table is generated for GAUGE_PIXELS pixels");
 
 // PWM configuration
 int pwmDutyCycle = PWM_DEFAULT_DUTY;
@@ -110,6 +159,10 @@ struct_message incomingData;
 struct_message outgoingData; 
 char outgoingMsg[32] = "Hello ESP-NOW";  // Default message - Modify with new messages
 
+// Demo-Servo station, broadcast reaches every station until set to its MAC
+uint8_t servoStationMAC[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+station_link servoLink;
+
 /**
  * @brief WIFI MESSAGE PROTOCOL
  * 
@@ -123,85 +176,24 @@ char outgoingMsg[32] = "Hello ESP-NOW";  // Default message - Modify with new me
 
 // Task handles
 TaskHandle_t TaskWiFiHandle = NULL;
-TaskHandle_t TaskPrintHandle = NULL;
-
-// Print queue and buffer
-QueueHandle_t printQueue;
-#define PRINT_BUFFER_SIZE   (128)
-#define PRINT_BUFFER_COUNT  (10)
+StackType_t wifiTaskStack[10000];
+StaticTask_t wifiTaskTcb;
+TaskHandle_t setupTaskHandle = NULL;   // Notified once the radio is up (or failed to come up)
+constexpr uint32_t WIFI_INIT_TIMEOUT_MS = 2000;
 
 //===================================================================================================
 // Function Definitions
 
 
-// FUNCTION: Color Interpolate
-uint32_t interpolateColor(uint8_t r1, uint8_t g1, uint8_t b1,
-                          uint8_t r2, uint8_t g2, uint8_t b2,
-                          float t) {
-  uint8_t r = r1 + (r2 - r1) * t;
-  uint8_t g = g1 + (g2 - g1) * t;
-  uint8_t b = b1 + (b2 - b1) * t;
-  return strip.Color(r, g, b);
-}
-
-// FUNCTION: Brightness & Color Gradient
-void displayEnhancedBrightnessGradient(int step) {
-  float progress = (float)step / (NUMPIXELS - 1);
-  float globalBrightness = pow(progress, 2.2) * 0.9 + 0.1;
-
-  for (int i = 0; i < NUMPIXELS; i++) {
-    float ratio = (float)i / (NUMPIXELS - 1);
-    uint32_t color;
-
-    if (ratio < 0.15) {
-      float t = ratio / 0.15;
-      color = interpolateColor(0, 255, 0, 255, 255, 0, t);
-    } else if (ratio < 0.35) {
-      float t = (ratio - 0.15) / 0.20;
-      color = interpolateColor(255, 255, 0, 255, 120, 0, t);
-    } else {
-      float t = (ratio - 0.35) / 0.65;
-      color = interpolateColor(255, 120, 0, 255, 0, 0, t);
-    }
-
-    uint8_t r = ((color >> 16) & 0xFF) * globalBrightness;
-    uint8_t g = ((color >> 8) & 0xFF) * globalBrightness;
-    uint8_t b = (color & 0xFF) * globalBrightness;
-
-    if (i <= step)
-      strip.setPixelColor(i, r, g, b);
-    else
-      strip.setPixelColor(i, 0, 0, 0);
-  }
-
-  strip.show();
-}
-
-
-
-// FUNCTION: Sends strings to global queue
-void enqueuePrint(const char* fmt, ...) {
-  char tempBuf[PRINT_BUFFER_SIZE];
-  va_list args;
-  va_start(args, fmt);
-  vsnprintf(tempBuf, PRINT_BUFFER_SIZE, fmt, args);
-  va_end(args);
-  xQueueSend(printQueue, tempBuf, 10 / portTICK_PERIOD_MS);
-}
-
-// FUNCTION: Prints strings from global queue
-void printTask(void* parameter) {
-  char localBuffer[PRINT_BUFFER_SIZE];
-  while (true) {
-    if (xQueueReceive(printQueue, localBuffer, portMAX_DELAY)) {
-      Serial.print(localBuffer);
-    }
-  }
-}
-
 // FUNCTION: ESP-NOW Read Message
 void OnDataRecv(const uint8_t* mac, const uint8_t* incomingDataPtr, int len) {
 
+  // 0. Servo station ACK/DONE reports
+  if (stationOnRecv(&servoLink, mac, incomingDataPtr, len)) return;
+
+  // 0. Remote fader positions
+  if (faderFollowOnRecv(mac, incomingDataPtr, len)) return;
+
   // 1. Fetch message
   memcpy(&incomingData, incomingDataPtr, sizeof(incomingData));
   enqueuePrint("Received data: %s\n", incomingData.msg);
@@ -241,6 +233,7 @@ void wifiTask(void* parameter) {
 
   if (esp_now_init() != ESP_OK) {
     enqueuePrint("Error initializing ESP-NOW\n");
+    xTaskNotifyGive(setupTaskHandle);
     vTaskDelete(NULL);
   }
 
@@ -260,6 +253,9 @@ void wifiTask(void* parameter) {
     }
   }
 
+  // The WiFi stack has its buffers, setup() may mark the heap
+  xTaskNotifyGive(setupTaskHandle);
+
   while (1) {
     strcpy(outgoingData.msg, outgoingMsg);
     outgoingData.value = millis() / 1000;
@@ -275,16 +271,249 @@ void wifiTask(void* parameter) {
   }
 }
 
+//===================================================================================================
+// Serial Commands
+
+// FUNCTION: Hand the PWM to a new owner, the temperature loop lets go first
+void setPwmMode(pwm_mode mode) {
+  if (pwmMode == PWM_HEATER && mode != PWM_HEATER) heaterStop();
+  pwmMode = mode;
+  if (mode == PWM_HEATER) heaterSetProfile(&heaterProfiles[fsm.stage]);
+}
+
+// FUNCTION: PWM follows the sound input
+void cmdAudio(int argc, char** argv) {
+  setPwmMode(PWM_AUDIO);
+  enqueuePrint("Switched to AUDIO mode (PWM follows sound input).\n");
+}
+
+// FUNCTION: PWM set by hand
+void cmdManual(int argc, char** argv) {
+  setPwmMode(PWM_MANUAL);
+  enqueuePrint("Switched to MANUAL mode (PWM set via serial).\n");
+}
+
+// FUNCTION: PWM follows the remote fader
+void cmdFader(int argc, char** argv) {
+  setPwmMode(PWM_FADER);
+  enqueuePrint("Switched to FADER mode (PWM follows the remote fader, 0-%d%%).\n", PWM_FADER_MAX * 100 / PWM_MAX_DUTY);
+}
+
+// FUNCTION: Remote fader position (WiFi task), the heater follows at once
+void onFaderPos(uint8_t axis, uint16_t pos, uint8_t flags) {
+  if (pwmMode != PWM_FADER || axis != 0) return;
+  pwmDutyCycle = (uint32_t)pos * PWM_FADER_MAX / FADER_LINK_POS_MAX;
+  ledcWrite(PWM_DEFAULT_CHANNEL, pwmDutyCycle);
+}
+
+// FUNCTION: Remote fader stream statistics
+void cmdFaderStats(int argc, char** argv) {
+  fader_follow_stats st;
+  faderFollowStats(&st);
+  enqueuePrint("Fader link %s: pos %u%s, %lu received, %lu stale, %lu echoes, apply %lu us (max %lu)\n",
+               st.linkUp ? "up" : "down", (unsigned)((uint32_t)st.lastPos * 100 / FADER_LINK_POS_MAX),
+               (st.lastFlags & FADER_LINK_TOUCHED) ? "% touched" : "%",
+               (unsigned long)st.received, (unsigned long)st.stale, (unsigned long)st.echoes,
+               (unsigned long)st.lastApplyUs, (unsigned long)st.maxApplyUs);
+}
+
+// FUNCTION: PWM follows the temperature loop, profile of the current stage
+void cmdHeat(int argc, char** argv) {
+  setPwmMode(PWM_HEATER);
+  enqueuePrint("Switched to HEAT mode (stage %d: %.0f C).\n", fsm.stage, heaterProfiles[fsm.stage].setpointC);
+}
+
+// FUNCTION: Heater status, "heat <C>" holds a temperature of its own until the next stage change
+void cmdHeatStatus(int argc, char** argv) {
+  long setpoint;
+  if (argc > 1 && shellParseInt(argv[1], &setpoint)) {
+    static heater_profile manualProfile = { 0.0f, 0.0f, 5.0f, 0 };
+    manualProfile.setpointC = (float)constrain(setpoint, 0L, (long)HEATER_SAFE_SETPOINT_C);
+    if (pwmMode != PWM_HEATER) setPwmMode(PWM_HEATER);
+    heaterSetProfile(&manualProfile);
+    if (setpoint > (long)HEATER_SAFE_SETPOINT_C) {
+      enqueuePrint("Heater holding %.0f C, clamped from %ld: the cutoff trips at %.0f C\n",
+                   manualProfile.setpointC, setpoint, HEATER_SAFE_MAX_C);
+    } else {
+      enqueuePrint("Heater holding %.0f C\n", manualProfile.setpointC);
+    }
+    return;
+  }
+
+  static const char* const stateNames[] = { "OFF", "HEATING", "SOAK", "READY", "DOSE", "FAULT" };
+  heater_status st;
+  heaterStatus(&st);
+  enqueuePrint("Heater %s: %.2f C (junction %.1f), setpoint %.1f of %.1f, duty %.0f%%\n",
+               stateNames[st.state], st.tempC, st.internalC, st.setpointC, st.targetC, st.duty * 100.0f);
+  enqueuePrint("Time to temp %lu ms, overshoot %.2f C, %lu samples, %lu sensor faults (last 0x%02X), %lu us per sample\n",
+               (unsigned long)st.timeToTempMs, st.overshootC, (unsigned long)st.samples,
+               (unsigned long)st.sensorFaults, st.sensorFault, (unsigned long)st.lastSampleUs);
+  enqueuePrint("Supply %lu mV, %lu doses, last %s: %.1f of %.0f J in %lu ms (%lu of %lu slots on)\n",
+               (unsigned long)st.supplyMv, (unsigned long)st.doses, heaterDoseName(st.doseResult), st.doseJ,
+               st.doseTargetJ, (unsigned long)st.doseMs, (unsigned long)st.doseOnSlots, (unsigned long)st.doseSlots);
+}
+
+// FUNCTION: Brand now, "brand <J>" with a dose of its own. Needs HEAT mode.
+void cmdBrand(int argc, char** argv) {
+  heater_dose_cfg cfg = brandDose;
+  long joules;
+  if (argc > 1 && shellParseInt(argv[1], &joules)) cfg.targetJ = (float)constrain(joules, 1L, 2000L);
+  if (heaterDose(&cfg)) enqueuePrint("Branding %.0f J\n", cfg.targetJ);
+  else                  enqueuePrint("Brand needs HEAT mode, a working heater and a supply reading\n");
+}
+
+// FUNCTION: Safety cutoff fired (watchdog task), the output is already cut. loop() stops the PWM owners.
+volatile uint8_t heaterTripCause = 0;
+void onHeaterTrip(uint8_t cause) {
+  heaterTripCause = cause;
+}
+
+// FUNCTION: Safety cutoff status, "trip reset" re-arms once every cause has cleared
+void cmdTrip(int argc, char** argv) {
+  if (argc > 1 && strcasecmp(argv[1], "reset") == 0) {
+    if (heaterSafetyReset()) {
+      ledAnimSetError(false);
+      enqueuePrint("Heater cutoff re-armed, PWM 0 in MANUAL mode\n");
+    } else {
+      enqueuePrint("Heater cutoff not re-armed: still tripped, too hot, no reading or never tripped\n");
+    }
+    return;
+  }
+
+  heater_safety_status st;
+  heaterSafetyStatus(&st);
+  enqueuePrint("Heater cutoff %s (cause 0x%02X), %lu trips, %.1f C %lu ms ago, duty %.0f%%\n",
+               st.tripped ? "TRIPPED" : "armed", st.cause, (unsigned long)st.trips, st.tempC,
+               (unsigned long)st.sampleAgeMs, st.duty * 100.0f);
+  enqueuePrint("Last trip: cut %lu us (max %lu) after detection, FSM told after %lu us, %lu checks\n",
+               (unsigned long)st.cutUs, (unsigned long)st.maxCutUs, (unsigned long)st.notifyUs,
+               (unsigned long)st.checks);
+}
+
+// FUNCTION: FSM stage and line statistics, or jump to a stage
+void cmdStage(int argc, char** argv) {
+  long stage;
+  if (argc < 2 || !shellParseInt(argv[1], &stage) || stage < 0 || stage >= TOAST_STAGE_COUNT) {
+    toast_line_stats st;
+    toastLineStats(&fsm, &st);
+    enqueuePrint("Stage %d phase %d, %u waiting, st <0-%d> jumps\n", fsm.stage, fsm.phase,
+                 fsm.requestCount, TOAST_STAGE_COUNT - 1);
+    enqueuePrint("Slices %lu of %lu requests (%lu refused), cycle %lu ms (avg %lu, max %lu), %lu faults, %lu brand timeouts\n",
+                 (unsigned long)st.slices, (unsigned long)st.requests, (unsigned long)st.refused,
+                 (unsigned long)st.lastCycleMs, (unsigned long)(st.slices ? st.sumCycleMs / st.slices : 0),
+                 (unsigned long)st.maxCycleMs, (unsigned long)st.faults, (unsigned long)st.brandTimeouts);
+    return;
+  }
+  toastLineJump(&fsm, (uint8_t)stage);
+  enqueuePrint("Stage %ld once the current commands are in\n", stage);
+}
+
+// FUNCTION: TOAST stages wait for this before opening the gate
+bool brandIn(void* arg) {
+  return pwmMode != PWM_HEATER || brandStep == BRAND_DONE;
+}
+
+// FUNCTION: Servo station finished a command (or gave up)
+void onStationDone(uint16_t seq, uint8_t status, void* arg) {
+  station_stats st;
+  stationStats(&servoLink, &st);
+  if (status == LINK_TIMEOUT) enqueuePrint("Station cmd %u timed out\n", seq);
+  else enqueuePrint("Station cmd %u done, status %u, %lu ms after send\n",
+                    seq, status, (unsigned long)(st.lastDoneUs / 1000));
+}
+
+// FUNCTION: Remote servo commands, "sv" alone prints the link latency
+// sv ping|stop|open|close [mask], sv a <deg> [mask], sv b <pause_ms> [mask]
+void cmdServo(int argc, char** argv) {
+  if (argc < 2) {
+    station_stats st;
+    stationStats(&servoLink, &st);
+    enqueuePrint("Station link: %lu sent, %lu resends, %lu acks, %lu dones, %lu timeouts\n",
+                 (unsigned long)st.sent, (unsigned long)st.resends, (unsigned long)st.acks,
+                 (unsigned long)st.dones, (unsigned long)st.timeouts);
+    enqueuePrint("RTT %lu us (min %lu, avg %lu, max %lu), send to motion %lu us (avg %lu, max %lu)\n",
+                 (unsigned long)st.lastRttUs, (unsigned long)st.minRttUs, (unsigned long)st.avgRttUs,
+                 (unsigned long)st.maxRttUs, (unsigned long)st.lastStartUs,
+                 (unsigned long)st.avgStartUs, (unsigned long)st.maxStartUs);
+    return;
+  }
+
+  uint8_t op;
+  int maskArg = 2;
+  if      (strcasecmp(argv[1], "ping") == 0)  op = LINK_OP_PING;
+  else if (strcasecmp(argv[1], "stop") == 0)  op = LINK_OP_STOP;
+  else if (strcasecmp(argv[1], "open") == 0)  op = LINK_OP_OPEN;
+  else if (strcasecmp(argv[1], "close") == 0) op = LINK_OP_CLOSE;
+  else if (strcasecmp(argv[1], "a") == 0)     { op = LINK_OP_ANGLE;  maskArg = 3; }
+  else if (strcasecmp(argv[1], "b") == 0)     { op = LINK_OP_BOUNCE; maskArg = 3; }
+  else {
+    enqueuePrint("sv: unknown op '%s'\n", argv[1]);
+    return;
+  }
+
+  long arg = 0, mask = LINK_SERVO_TOP | LINK_SERVO_BOTTOM;
+  if (maskArg == 3 && (argc < 3 || !shellParseInt(argv[2], &arg))) {
+    enqueuePrint("sv: %s needs a number\n", argv[1]);
+    return;
+  }
+  if (argc > maskArg) shellParseInt(argv[maskArg], &mask);
+
+  uint16_t seq = stationSend(&servoLink, servoStationMAC, op, (uint8_t)(mask & LINK_SERVO_ALL),
+                             (int16_t)constrain(arg, -32768L, 32767L), onStationDone);
+  if (seq) enqueuePrint("Station cmd %u sent\n", seq);
+  else     enqueuePrint("Station link busy, command dropped\n");
+}
+
+void cmdHelp(int argc, char** argv);
+
+// FUNCTION: Anything else is a PWM value (0-100) in manual mode, or the next ESP-NOW message
+void cmdFallback(int argc, char** argv) {
+  long userValue;
+  if (argc == 1 && shellParseInt(argv[0], &userValue)) {
+    if (pwmMode == PWM_MANUAL && userValue >= 0 && userValue <= 100) {
+      pwmDutyCycle = map(userValue, 0, 100, 0, PWM_MAX_DUTY);
+      ledcWrite(PWM_DEFAULT_CHANNEL, pwmDutyCycle);
+      enqueuePrint("Manual PWM set to %ld%%\n", userValue);
+    } else {
+      enqueuePrint("PWM is 0-100 and needs MANUAL mode ('M').\n");
+    }
+    return;
+  }
+
+  //TODO COPY THIS FORMAT TO SEND MESSAGES
+  const char* msg = shellJoin(argc, argv);
+  if (strlen(msg) < sizeof(outgoingMsg)) {
+    strcpy(outgoingMsg, msg);
+    enqueuePrint("Updated message to send: %s\n", outgoingMsg);
+  } else {
+    enqueuePrint("Unknown command or message too long. Use PWM (0–100) or shorter text message.\n");
+  }
+}
+
+const shell_cmd commands[] = {
+  { "A",    "AUDIO mode, PWM follows sound",  cmdAudio },
+  { "M",    "MANUAL mode, then 0-100 sets PWM", cmdManual },
+  { "F",    "FADER mode, PWM follows the remote fader", cmdFader },
+  { "fd",   "Remote fader link statistics", cmdFaderStats },
+  { "H",    "HEAT mode, PWM holds the stage temperature", cmdHeat },
+  { "heat", "[C] Heater status, or hold C", cmdHeatStatus },
+  { "brand", "[J] Energy dose now (HEAT mode)", cmdBrand },
+  { "trip", "[reset] Heater cutoff status, or re-arm", cmdTrip },
+  { "st",   "[n] FSM stage and slices, or jump", cmdStage },
+  { "sv",   "[ping|stop|open|close|a <deg>|b <ms>] [mask 1 top 2 bottom 4 tp 8 cr 16 px]", cmdServo },
+  { "help", "This list, other text is sent over ESP-NOW", cmdHelp },
+};
+constexpr uint8_t NUM_COMMANDS = sizeof(commands) / sizeof(commands[0]);
+
+void cmdHelp(int argc, char** argv) { shellHelp(commands, NUM_COMMANDS); }
+
+
 //===================================================================================================
 // Setup Function
 
 void setup() {
 
-  // 1. Init LED pin
-  pinMode(LED_PIN, OUTPUT);
-  pinMode(SOUND_PIN, INPUT);
-
-  // 1.1 Attach hardware interrupt
+  // 1. Attach hardware interrupt
   pinMode(INTERRUPT_PIN, INPUT_PULLUP);  // Expecting a LOW signal to trigger
   attachInterrupt(digitalPinToInterrupt(INTERRUPT_PIN), handleInterrupt, FALLING);
 
@@ -295,38 +524,32 @@ void setup() {
   ledcAttachPin(PWM_PIN, PWM_DEFAULT_CHANNEL);
   ledcWrite(PWM_DEFAULT_CHANNEL, PWM_DEFAULT_DUTY);
 
-  // 3. Begin serial
+  // 2a. Cutoff before anything can drive the heater: trip pin, over temperature, stale or stuck PWM
+  bool safetyOk = heaterSafetyBegin(PWM_PIN, PWM_DEFAULT_CHANNEL, PWM_MAX_DUTY, onHeaterTrip);
+
+  // 2b. Thermocouple and temperature loop, measures from now on, drives the PWM in HEAT mode
+  bool heaterOk = heaterBegin(PWM_DEFAULT_CHANNEL, PWM_MAX_DUTY);
+  heaterSetSupply(soundInputSupplyMv);
+
+  // 3. Begin serial, lines are assembled off the UART events
   Serial.begin(SERIAL_RATE);
+  shellBegin(Serial);
 
-  // 4. Create shared core print queue
-  printQueue = xQueueCreate(PRINT_BUFFER_COUNT, PRINT_BUFFER_SIZE);
-  if (printQueue == NULL) {
-    Serial.println("Failed to create print queue!");
-    ledInterval = PERIOD_LED_ERROR;
+  // 4-5. Shared print queue, drained by the print task (core 0)
+  if (!printQueueBegin(0)) {
+    Serial.println("Failed to start print queue!");
+    ledAnimSetError(true);
   }
 
-  // 5. Pin shared print task (core 0)
-  xTaskCreatePinnedToCore(
-    printTask,
-    "Print Task",
-    4096,
-    NULL,
-    1,
-    &TaskPrintHandle,
-    0
-  );
-
   // 6. Hold until "GO" inputed by user serial
   enqueuePrint("Type 'GO' then press Enter to start:\n");
-  String input;
   while (!ready) {
-    if (Serial.available()) {
-      input = Serial.readStringUntil('\n');
-      input.trim();
-      if (input.equalsIgnoreCase("GO")) {
+    char* input = shellGetLine();
+    if (input) {
+      if (strcasecmp(input, "GO") == 0) {
         ready = true;
         enqueuePrint("Starting main loop...\n");
-        enqueuePrint("You can enter 'ON', 'OFF', or a PWM value (0–100).\n");
+        cmdHelp(0, NULL);
       } else {
         enqueuePrint("Waiting for 'GO'...\n");
       }
@@ -334,22 +557,53 @@ void setup() {
     vTaskDelay(100 / portTICK_PERIOD_MS);
   }
 
-  // 7. Pin WIFI task on core 1
-  xTaskCreatePinnedToCore(
+  // 7. Pin WIFI task on core 1, the remote fader drives the PWM in FADER mode, the
+  // servo link carries the line's stage commands. Wait for its radio init: the WiFi
+  // stack allocates there, and that belongs before the heap mark.
+  stationInit(&servoLink);
+  toastLineInit(&fsm, TOAST_STAGES, &servoLink, servoStationMAC, brandIn);
+  faderFollowBegin(onFaderPos);
+  setupTaskHandle = xTaskGetCurrentTaskHandle();
+  TaskWiFiHandle = xTaskCreateStaticPinnedToCore(
     wifiTask,
     "WiFi Task",
-    10000,
+    sizeof(wifiTaskStack),
     NULL,
     1,
-    &TaskWiFiHandle,
+    wifiTaskStack,
+    &wifiTaskTcb,
     1
   );
-  enqueuePrint("MAC Address: %s\n", WiFi.macAddress().c_str());
+  if (!ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WIFI_INIT_TIMEOUT_MS))) {
+    enqueuePrint("WiFi init not done after %lu ms, heap mark may count it\n", (unsigned long)WIFI_INIT_TIMEOUT_MS);
+  }
+  uint8_t mac[6];
+  halRadioMac(mac);
+  enqueuePrint("MAC Address: %02X:%02X:%02X:%02X:%02X:%02X\n", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+  // 8. Start Neopixels and status LED (own frame timer, RMT output)
+  if (!ledAnimBegin(NEOPIXEL_PIN, LED_PIN)) {
+    enqueuePrint("Failed to start LED animation!\n");
+  }
+
+  if (!safetyOk) {
+    enqueuePrint("Failed to start heater cutoff!\n");
+    ledAnimSetError(true);
+  }
+
+  if (!heaterOk) {
+    enqueuePrint("Failed to start heater control!\n");
+    ledAnimSetError(true);
+  }
 
-  // 8. Start Neopixels
-  strip.begin();
-  strip.show();
+  // 9. Start sound band analyzer (I2S ADC DMA, core 0)
+  if (!soundInputBegin(soundTones, sizeof(soundTones) / sizeof(soundTones[0]))) {
+    enqueuePrint("Failed to start sound input!\n");
+    ledAnimSetError(true);
+  }
 
+  // 10. Everything is allocated, loop() runs without the heap from here (see Hello)
+  halHeapMark();
 }
 
 //===================================================================================================
@@ -360,139 +614,127 @@ void loop() {
   // 1. Get fake RTOS scheduler
   unsigned long currentMillis = millis();
 
-  // 2. Blink status LED (1 Second)
-  if (currentMillis - previousMillisLED >= ledInterval) {
-    previousMillisLED = currentMillis;
-    ledState = !ledState;
-    digitalWrite(LED_PIN, ledState);
+  // 2. Show the current stage on the gauge background
+  static int shownStage = -1;
+  if (shownStage != fsm.stage) {
+    shownStage = fsm.stage;
+    uint32_t c = stageColors[fsm.stage];
+    ledAnimSetStageColor((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF);
+    if (pwmMode == PWM_HEATER) heaterSetProfile(&heaterProfiles[fsm.stage]);
+    brandStep = BRAND_WAIT;
+  }
+
+  // 2a. Heater cutoff tripped: pin already low, every PWM owner lets go so re-arming starts from 0
+  uint8_t tripCause = heaterTripCause;
+  if (tripCause) {
+    heaterTripCause = 0;
+    setPwmMode(PWM_MANUAL);
+    pwmDutyCycle = 0;
+    ledcWrite(PWM_DEFAULT_CHANNEL, 0);
+    ledAnimSetError(true);
+    enqueuePrint("Heater cutoff TRIPPED (cause 0x%02X), MANUAL mode at 0, 'trip reset' to re-arm\n", tripCause);
+  }
+
+  // 2b. TOAST: brand once the iron is at temperature, report when the dose is in. A FAULT
+  // heater brands nothing, the slice goes on unbranded; so does one that never gets ready,
+  // after TOAST_BRAND_TIMEOUT_MS.
+  bool toastStage = fsm.stage == STATE_B_TOAST || fsm.stage == STATE_T_TOAST;
+  static uint32_t brandTimeouts = 0;
+  if (fsm.stats.brandTimeouts != brandTimeouts) {
+    brandTimeouts = fsm.stats.brandTimeouts;
+    enqueuePrint("Brand: heater not ready after %lu ms, toasting without it\n", (unsigned long)TOAST_BRAND_TIMEOUT_MS);
+  }
+  if (toastStage && pwmMode == PWM_HEATER && brandStep == BRAND_WAIT && heaterFaulted()) {
+    brandStep = BRAND_DONE;
+    enqueuePrint("Brand: heater FAULT, toasting without it\n");
+  } else if (toastStage && pwmMode == PWM_HEATER && brandStep == BRAND_WAIT && heaterReady() && heaterDose(&brandDose)) {
+    brandStep = BRAND_DOSING;
+    enqueuePrint("Branding %.0f J\n", brandDose.targetJ);
+  } else if (brandStep == BRAND_DOSING && !heaterDosing()) {
+    brandStep = BRAND_DONE;
+    heater_status hst;
+    heaterStatus(&hst);
+    enqueuePrint("Brand %s%s: %.1f J in %lu ms at %lu mV\n", (hst.doseResult == HEATER_DOSE_DONE) ? "" : "FAILED, ",
+                 heaterDoseName(hst.doseResult), hst.doseJ, (unsigned long)hst.doseMs, (unsigned long)hst.supplyMv);
   }
 
   // 3. Serial print status "Hello" (10 Seconds)
   if (currentMillis - previousMillisHello >= helloInterval) {
     previousMillisHello = currentMillis;
     enqueuePrint("Hello! Time since boot: %lu ms\n", currentMillis);
+
+    led_output_stats ledStats;
+    ledOutputStats(&ledStats);
+    enqueuePrint("LED frames sent: %lu, skipped: %lu, dropped: %lu, frame: %lu us\n",
+                 (unsigned long)ledStats.framesSent, (unsigned long)ledStats.framesSkipped,
+                 (unsigned long)ledStats.framesDropped, (unsigned long)ledStats.lastFrameUs);
+    enqueuePrint("Heap: %lu allocations, %ld blocks held since setup()\n", (unsigned long)halHeapSinceMark(),
+                 (long)halHeapBlocksSinceMark());
   }
 
   // 4. Update Lights via Sound - Gauge that builds up as user yells
   if (currentMillis - previousMillisSound >= soundInterval) {
     previousMillisSound = currentMillis;
 
-    int soundValue = analogRead(SOUND_PIN);
-
-    // Smooth the raw sound input
-    static float smoothValue = 0;
-    float alpha = 0.4;
-    smoothValue = smoothValue * (1 - alpha) + soundValue * alpha;
-
-    // Gauge system: accumulates when sound is detected, drains when quiet
-    static float gaugeLevel = 0.0;  // Gauge level from 0.0 to 1.0
-    const float maxGaugeLevel = 1.0;
-    const float minGaugeLevel = 0.0;
-    
-    // Thresholds for detecting sound activity (very sensitive for lower sounds)
-    const int quietThreshold = 300;   // Below this is considered quiet
-    const int activeThreshold = 400;  // Above this actively charges the gauge
-    const int loudThreshold = 600;   // Very loud sounds charge faster
-    
-    // Charging and draining rates (much faster for quick response)
-    const float chargeRateSlow = 0.03;   // Slow charge for moderate sounds
-    const float chargeRateFast = 0.06;  // Fast charge for loud sounds
-    const float drainRate = 0.002;      // Rate at which gauge drains when quiet (faster decay)
-    
-    // Determine if sound is active and how intense
-    bool isQuiet = smoothValue < quietThreshold;
-    bool isActive = smoothValue >= activeThreshold;
-    bool isLoud = smoothValue >= loudThreshold;
-    
-    // Update gauge level based on sound activity
-    if (isQuiet) {
-      // Drain the gauge when quiet
-      gaugeLevel = max(minGaugeLevel, gaugeLevel - drainRate);
-    } else if (isLoud) {
-      // Fast charge for loud sounds
-      gaugeLevel = min(maxGaugeLevel, gaugeLevel + chargeRateFast);
-    } else if (isActive) {
-      // Slow charge for moderate sounds
-      gaugeLevel = min(maxGaugeLevel, gaugeLevel + chargeRateSlow);
-    }
-    // If between quiet and active, charge slowly (even lower sounds help)
-    else {
-      gaugeLevel = min(maxGaugeLevel, gaugeLevel + chargeRateSlow * 0.5f);
-    }
-    
+    // Trigger band amplitude of the latest block, machine tones excluded
+    static sound_bands_result bands = {};
+    soundInputLatest(&bands);
+    int soundValue = bands.triggerLevel;
+
+    // Gauge system: accumulates when sound is detected, drains when quiet. Servo whine
+    // (motor drive and gears) is broadband over the voice tones, no machine bin rejects it;
+    // while the station's servos run (stage commands out, DONEs owed) the gauge holds.
+    static sound_gauge gauge = {};
+    bool servosRunning = fsm.phase == TOAST_SEND || fsm.phase == TOAST_MOVE;
+    if (!servosRunning) soundGaugeStep(&gauge, bands.triggerLevel, PWM_FADER_MAX);
+
     // Map gauge level (0.0 to 1.0) to LED steps (0 to NUMPIXELS - 1)
-    int step = (int)(gaugeLevel * (NUMPIXELS - 1));
+    int step = (int)(gauge.level * (NUMPIXELS - 1));
     step = constrain(step, 0, NUMPIXELS - 1);
 
     // Debug output every 100ms to monitor values
     static unsigned long lastDebugMillis = 0;
     if (currentMillis - lastDebugMillis >= 100) {
       lastDebugMillis = currentMillis;
-      enqueuePrint("Sound: %d, Smooth: %.0f, Gauge: %.2f, Step: %d\n", 
-                   soundValue, smoothValue, gaugeLevel, step);
+      enqueuePrint("Sound: %d, Machine: %u, Smooth: %.0f, Gauge: %.2f, Step: %d, Cycles: %lu\n",
+                   soundValue, bands.machineLevel, gauge.smooth, gauge.level, step, (unsigned long)bands.cycles);
     }
 
-    displayEnhancedBrightnessGradient(step);
-
-    // Map gauge level to PWM duty cycle (0–255)
-    const int PWM_MAX_60 = 153; // 60% of 255
-    int pwmValue = (int)(gaugeLevel * PWM_MAX_60);
-    pwmValue = constrain(pwmValue, 0, PWM_MAX_60);
-
-    // Smooth PWM response for stability
-    static int smoothPWM = 0;
-    float pwmAlpha = 0.1; // lower values make it smoother
-    smoothPWM = smoothPWM * (1 - pwmAlpha) + pwmValue * pwmAlpha;
+    ledAnimSetGauge(soundGaugeQ16(&gauge));
 
-    // Write PWM signal based on sound intensity
-    if(audioMode)
+    // Write PWM signal based on sound intensity (0-60%, smoothed for stability)
+    if(pwmMode == PWM_AUDIO)
     {
-      ledcWrite(PWM_DEFAULT_CHANNEL, (int)smoothPWM);
+      ledcWrite(PWM_DEFAULT_CHANNEL, gauge.pwm);
     }
   }
 
   // 5. Service interrupt
     if (interruptTriggered) {
     interruptTriggered = false;
-    enqueuePrint("Interrupt triggered at %lu ms\n", millis());
-    // Add your interrupt-handling logic here
-    
+    // Start button: one more slice for the line
+    if (toastLineRequest(&fsm)) enqueuePrint("Slice requested at %lu ms, %u waiting\n", millis(), fsm.requestCount);
+    else                        enqueuePrint("Slice queue full, button ignored\n");
   }
 
-  // 6. Parse serial input
-  if (Serial.available()) {
-    
-    // 4.1 Read serial
-    String cmd = Serial.readStringUntil('\n');
-    cmd.trim();
-
-    // 4.2 Decode PWM Mode
-    if (cmd.equalsIgnoreCase("A")) {
-      audioMode = true;
-      enqueuePrint("Switched to AUDIO mode (PWM follows sound input).\n");
-    } else if (cmd.equalsIgnoreCase("M")) {
-      audioMode = false;
-      enqueuePrint("Switched to MANUAL mode (PWM set via serial).\n");
-    } else if (!audioMode && cmd.toInt() >= 0 && cmd.toInt() <= 100) {
-      int userValue = cmd.toInt();
-      pwmDutyCycle = map(userValue, 0, 100, 0, 255);
-      ledcWrite(PWM_DEFAULT_CHANNEL, pwmDutyCycle);
-      enqueuePrint("Manual PWM set to %d%%\n", userValue);
-    }
-
-    
-    // 4.4 Update ESP-NOW message if not a PWM number //TODO COPY THIS FORMAT TO SEND MESSAGES
-    else if (cmd.length() < sizeof(outgoingMsg)) {
-      cmd.toCharArray(outgoingMsg, sizeof(outgoingMsg));
-      enqueuePrint("Updated message to send: %s\n", outgoingMsg);
-    }
-    
-    // 4.5 Unknown command error
-    else {
-      enqueuePrint("Unknown command or message too long. Use PWM (0–100) or shorter text message.\n");
+  // 6. Handle one pending command line (never waits on the UART)
+  shellPoll(commands, NUM_COMMANDS, cmdFallback);
+
+  // 7. Resend unanswered servo commands, time out lost ones, then move the line on
+  stationPoll(&servoLink);
+  toastLinePoll(&fsm);
+
+  // 8. Remote fader gone quiet: heater off rather than stuck at its last value
+  if (pwmMode == PWM_FADER && pwmDutyCycle != 0) {
+    fader_follow_stats fst;
+    faderFollowStats(&fst);
+    if (!fst.linkUp) {
+      pwmDutyCycle = 0;
+      ledcWrite(PWM_DEFAULT_CHANNEL, 0);
+      enqueuePrint("Fader link lost, PWM off\n");
     }
   }
 
-  // 6. Yield to other tasks
+  // 9. Yield to other tasks
   vTaskDelay(20 / portTICK_PERIOD_MS);
 }
@@ -0,0 +1,127 @@
+/* Sound Input Driver */
+
+/* Includes */
+#include <driver/i2s.h>
+#include <esp_adc_cal.h>
+#include "sound_input.h"
+
+/* Statics */
+static TaskHandle_t TaskSoundHandle = NULL;
+static StackType_t soundStack[4096];
+static StaticTask_t soundTcb;
+static portMUX_TYPE soundMux = portMUX_INITIALIZER_UNLOCKED;
+static sound_bands_result latestResult = {};
+static bool latestFresh = false;
+static esp_adc_cal_characteristics_t adcChars;
+static volatile uint32_t supplyMv = 0;
+
+/* Private Function Definitions */
+
+// FUNCTION: Pulls DMA blocks, splits sound from supply by the channel in the top
+// nibble, runs the band analyzer on the sound half
+static void soundTask(void* parameter) {
+  static uint16_t dma[2 * SOUND_BLOCK_SIZE];
+  static uint16_t block[SOUND_BLOCK_SIZE];
+  size_t bytesRead = 0;
+
+  while (true) {
+    if (i2s_read(I2S_NUM_0, dma, sizeof(dma), &bytesRead, portMAX_DELAY) != ESP_OK ||
+        bytesRead != sizeof(dma)) {
+      continue;
+    }
+
+    uint16_t n = 0;
+    uint32_t supplySum = 0, supplyCount = 0;
+    for (uint16_t i = 0; i < 2 * SOUND_BLOCK_SIZE; ++i) {
+      uint8_t chan = dma[i] >> 12;
+      if (chan == SOUND_ADC_CHANNEL && n < SOUND_BLOCK_SIZE) {
+        block[n++] = dma[i];
+      } else if (chan == SUPPLY_ADC_CHANNEL) {
+        supplySum += dma[i] & 0x0FFF;
+        supplyCount++;
+      }
+    }
+    if (supplyCount) {
+      uint32_t mv = esp_adc_cal_raw_to_voltage(supplySum / supplyCount, &adcChars);
+      supplyMv = mv * SUPPLY_DIVIDER_X1000 / 1000;
+    }
+    if (n != SOUND_BLOCK_SIZE) continue;
+
+    sound_bands_result result;
+    uint32_t start = ESP.getCycleCount();
+    soundBandsProcess(block, SOUND_BLOCK_SIZE, &result);
+    result.cycles = ESP.getCycleCount() - start;
+
+    portENTER_CRITICAL(&soundMux);
+    latestResult = result;
+    latestFresh = true;
+    portEXIT_CRITICAL(&soundMux);
+  }
+}
+
+/* Public Function Definitions */
+
+// FUNCTION: Start continuous sampling on SOUND_ADC_CHANNEL and SUPPLY_ADC_CHANNEL,
+// and the analyzer task (core 0)
+bool soundInputBegin(const sound_tone* tones, uint8_t count) {
+  soundBandsInit(tones, count);
+  esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &adcChars);
+
+  i2s_config_t cfg = {};
+  cfg.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+  cfg.sample_rate = 2 * SOUND_SAMPLE_RATE_HZ;   // Two channels, each at SOUND_SAMPLE_RATE_HZ
+  cfg.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  cfg.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  cfg.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  cfg.intr_alloc_flags = 0;
+  cfg.dma_buf_count = SOUND_DMA_BUFFERS;
+  cfg.dma_buf_len = 2 * SOUND_BLOCK_SIZE;
+  cfg.use_apll = false;
+
+  if (i2s_driver_install(I2S_NUM_0, &cfg, 0, NULL) != ESP_OK) return false;
+  if (i2s_set_adc_mode(ADC_UNIT_1, SOUND_ADC_CHANNEL) != ESP_OK) return false;
+  adc1_config_channel_atten(SOUND_ADC_CHANNEL, ADC_ATTEN_DB_11);
+  adc1_config_channel_atten(SUPPLY_ADC_CHANNEL, ADC_ATTEN_DB_11);
+  if (i2s_adc_enable(I2S_NUM_0) != ESP_OK) return false;
+
+  // Enabling installs a one-channel pattern, alternate sound and supply instead
+  adc_digi_pattern_table_t pattern[2] = {};
+  pattern[0].atten = ADC_ATTEN_DB_11;
+  pattern[0].bit_width = ADC_WIDTH_BIT_12;
+  pattern[0].channel = SOUND_ADC_CHANNEL;
+  pattern[1] = pattern[0];
+  pattern[1].channel = SUPPLY_ADC_CHANNEL;
+  adc_digi_config_t dig = {};
+  dig.conv_limit_en = false;
+  dig.adc1_pattern_len = 2;
+  dig.adc1_pattern = pattern;
+  dig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  dig.format = ADC_DIGI_FORMAT_12BIT;
+  if (adc_digi_controller_config(&dig) != ESP_OK) return false;
+
+  TaskSoundHandle = xTaskCreateStaticPinnedToCore(
+    soundTask,
+    "Sound Task",
+    sizeof(soundStack),
+    NULL,
+    2,
+    soundStack,
+    &soundTcb,
+    0
+  );
+  return TaskSoundHandle != NULL;
+}
+
+// FUNCTION: Copy the most recent block result, true if it arrived since the last call
+bool soundInputLatest(sound_bands_result* out) {
+  portENTER_CRITICAL(&soundMux);
+  *out = latestResult;
+  bool fresh = latestFresh;
+  latestFresh = false;
+  portEXIT_CRITICAL(&soundMux);
+  return fresh;
+}
+
+uint32_t soundInputSupplyMv() {
+  return supplyMv;
+}
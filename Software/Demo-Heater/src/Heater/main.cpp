@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include "cmd_shell.h"
 
 #define LED_PIN (2)
 #define OUT_PIN (19)
@@ -18,10 +19,41 @@ const int pwmChannel = 0;
 const int pwmResolution = 8; // 8-bit: 0-255
 int pwmDutyCycle = 0;      // default 50%
 
+void cmdOn(int argc, char** argv) {
+  digitalWrite(OUT_PIN, HIGH);
+  Serial.println("OUT_PIN turned ON");
+}
+
+void cmdOff(int argc, char** argv) {
+  digitalWrite(OUT_PIN, LOW);
+  Serial.println("OUT_PIN turned OFF");
+}
+
+// Bare number: PWM duty in percent
+void cmdPwm(int argc, char** argv) {
+  long userValue;
+  if (shellParseInt(argv[0], &userValue) && userValue >= 0 && userValue <= 100) {
+    pwmDutyCycle = map(userValue, 0, 100, 0, 255);
+    ledcWrite(pwmChannel, pwmDutyCycle);
+    Serial.print("PWM duty cycle set to ");
+    Serial.print(userValue);
+    Serial.println("%");
+  } else {
+    Serial.println("Unknown command. Use ON, OFF, or a number (0–100).");
+  }
+}
+
+const shell_cmd commands[] = {
+  { "ON",  "OUT_PIN high", cmdOn },
+  { "OFF", "OUT_PIN low",  cmdOff },
+};
+constexpr uint8_t NUM_COMMANDS = sizeof(commands) / sizeof(commands[0]);
+
 void setup() {
   pinMode(LED_PIN, OUTPUT);
   pinMode(OUT_PIN, OUTPUT);
   Serial.begin(115200);
+  shellBegin(Serial);
 
   // Setup PWM
   ledcSetup(pwmChannel, pwmFreq, pwmResolution);
@@ -30,12 +62,10 @@ void setup() {
 
   Serial.println("Type 'GO' then press Enter to start:");
 
-  String input;
   while (!ready) {
-    if (Serial.available()) {
-      input = Serial.readStringUntil('\n');
-      input.trim();
-      if (input.equalsIgnoreCase("GO")) {
+    char* input = shellGetLine();
+    if (input) {
+      if (strcasecmp(input, "GO") == 0) {
         ready = true;
         Serial.println("Starting main loop...");
         Serial.println("You can enter 'ON', 'OFF', or a PWM value (0–100).");
@@ -43,6 +73,7 @@ void setup() {
         Serial.println("Waiting for 'GO'...");
       }
     }
+    delay(20);
   }
 }
 
@@ -64,28 +95,6 @@ void loop() {
     Serial.println(" ms");
   }
 
-  // Serial input for commands
-  if (Serial.available()) {
-    String cmd = Serial.readStringUntil('\n');
-    cmd.trim();
-
-    if (cmd.equalsIgnoreCase("ON")) {
-      digitalWrite(OUT_PIN, HIGH);
-      Serial.println("OUT_PIN turned ON");
-    } else if (cmd.equalsIgnoreCase("OFF")) {
-      digitalWrite(OUT_PIN, LOW);
-      Serial.println("OUT_PIN turned OFF");
-
-
-    } else if (cmd.toInt() >= 0 && cmd.toInt() <= 100) {
-      int userValue = cmd.toInt();
-      pwmDutyCycle = map(userValue, 0, 100, 0, 255);
-      ledcWrite(pwmChannel, pwmDutyCycle);
-      Serial.print("PWM duty cycle set to ");
-      Serial.print(userValue);
-      Serial.println("%");
-    } else {
-      Serial.println("Unknown command. Use ON, OFF, or a number (0–100).");
-    }
-  }
+  // Command handling, never waits on the UART
+  shellPoll(commands, NUM_COMMANDS, cmdPwm);
 }
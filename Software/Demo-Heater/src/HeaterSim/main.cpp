@@ -0,0 +1,188 @@
+/* Heater Simulator
+ *
+ * Host build (pio run -e native, src_dir = src/HeaterSim/): runs the firmware's
+ * heater_pid against a thermal plant model, faster than real time, and prints
+ * rise time, overshoot, settling time and energy for every case below.
+ *
+ *   heater_sim            all cases, one line each
+ *   heater_sim <n>        also a CSV trace of case n (time, plate, sensor, setpoint, duty)
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include "heater_pid.h"
+#include "thermal_plant.h"
+
+/* Constants */
+constexpr float    SIM_DT_S       = 0.001f;   // Plant integration step
+constexpr uint32_t SIM_STEPS_PER_SAMPLE = (uint32_t)(1.0f / SIM_DT_S) / HEATER_SAMPLE_HZ;
+constexpr uint8_t  SIM_MAX_CASES  = 16;
+
+// Nominal heater: 150 W element on a small iron, 400 C over ambient at full power,
+// one minute time constant, thermocouple a little behind the plate
+constexpr thermal_plant_cfg PLANT_NOMINAL = {
+  22.0f,                // ambientC
+  150.0f,               // powerW
+  4.0f,                 // elementJPerC
+  18.5f,                // plateJPerC
+  3.0f,                 // couplingWPerC
+  0.375f,               // lossWPerC
+  0.3f,                 // deadTimeS
+  1.0f,                 // sensorTauS
+  0.15f,                // noiseC
+  0.25f,                // quantC
+  12345,                // seed
+};
+
+/* Typedefs */
+typedef struct sim_case {
+  const char*       name;
+  heater_pid_cfg    pid;
+  thermal_plant_cfg plant;
+  heater_profile    profile;
+  float             startC;
+  float             supply;     // Supply voltage, 1 = nominal
+  uint8_t           pwmBits;    // LEDC resolution the duty is rounded to
+  float             durationS;
+} sim_case;
+
+typedef struct sim_result {
+  float riseS;          // 10 to 90 % of the step, plate temperature
+  float toBandS;        // First inside the band
+  float settleS;        // Inside the band from here to the end
+  float overshootC;     // Plate above the setpoint
+  float settleJ;        // Energy until settled
+  float totalJ;
+  float finalErrC;      // Plate, mean of the last 10 s
+  float holdDuty;       // Mean of the last 10 s
+} sim_result;
+
+/* Statics */
+static sim_case cases[SIM_MAX_CASES];
+static uint8_t caseCount = 0;
+static thermal_plant plant;
+
+/* Private Function Definitions */
+static sim_case baseCase(const char* name) {
+  sim_case c;
+  c.name = name;
+  c.pid = HEATER_PID_DEFAULTS;
+  c.plant = PLANT_NOMINAL;
+  c.profile = { 260.0f, 0.0f, 3.0f, 1500 };   // The TOAST stage
+  c.startC = PLANT_NOMINAL.ambientC;
+  c.supply = 1.0f;
+  c.pwmBits = 12;
+  c.durationS = 240.0f;
+  return c;
+}
+
+static void addCase(const sim_case& c) {
+  if (caseCount < SIM_MAX_CASES) cases[caseCount++] = c;
+}
+
+// FUNCTION: The parameter sets, edit freely
+static void buildCases() {
+  sim_case c;
+  addCase(baseCase("defaults 22->260"));
+
+  c = baseCase("stage 150->260");    c.startC = 150.0f;                        addCase(c);
+  c = baseCase("stage 260->150");    c.startC = 260.0f; c.profile.setpointC = 150.0f; addCase(c);
+  c = baseCase("supply -10%");       c.supply = 0.9f;                          addCase(c);
+  c = baseCase("supply +10%");       c.supply = 1.1f;                          addCase(c);
+  c = baseCase("dead time 1.5 s");   c.plant.deadTimeS = 1.5f;                 addCase(c);
+  c = baseCase("first order");       c.plant.elementJPerC = 22.5f; c.plant.plateJPerC = 0.0f; addCase(c);
+  c = baseCase("heavy iron x2");     c.plant.plateJPerC *= 2.0f;               addCase(c);
+  c = baseCase("noise 1 C");         c.plant.noiseC = 1.0f;                    addCase(c);
+  c = baseCase("ramp 5 C/s");        c.profile.rampCPerS = 5.0f;               addCase(c);
+  c = baseCase("no D");              c.pid.kd = 0.0f;                          addCase(c);
+  c = baseCase("no feed-forward");   c.pid.kff = 0.0f; c.pid.kffRate = 0.0f; c.pid.integMax = 1.0f; c.pid.ki = 0.01f; addCase(c);
+  c = baseCase("wide I band 50 C");  c.pid.iBandC = 50.0f;                     addCase(c);
+  c = baseCase("kp x2");             c.pid.kp *= 2.0f;                         addCase(c);
+  c = baseCase("8-bit PWM");         c.pwmBits = 8;                            addCase(c);
+}
+
+// FUNCTION: One case, the controller sees only what the firmware would
+static sim_result runCase(const sim_case& c, FILE* trace) {
+  heater_pid pid;
+  heaterPidInit(&pid, &c.pid, 1.0f / HEATER_SAMPLE_HZ);
+  thermalPlantInit(&plant, &c.plant, SIM_DT_S, c.startC);
+  heaterPidSetTarget(&pid, c.profile.setpointC, c.profile.rampCPerS, thermalPlantRead(&plant));
+
+  sim_result r = {};
+  float sp = c.profile.setpointC;
+  float step = sp - c.startC;
+  float t10 = -1.0f, t90 = -1.0f, lastOut = 0.0f;
+  float worst = 0.0f;
+  uint32_t dutyMax = (1UL << c.pwmBits) - 1;
+  uint32_t samples = (uint32_t)(c.durationS * HEATER_SAMPLE_HZ);
+  uint32_t tailSamples = 10 * HEATER_SAMPLE_HZ;
+  double tailErr = 0.0, tailDuty = 0.0;
+  r.toBandS = -1.0f;
+
+  for (uint32_t s = 0; s < samples; ++s) {
+    float t = (float)s / HEATER_SAMPLE_HZ;
+    float sensed = thermalPlantRead(&plant);
+    float duty = heaterPidStep(&pid, sensed);
+    float out = (float)(uint32_t)(duty * dutyMax + 0.5f) / dutyMax;   // What ledcWrite puts out
+    for (uint32_t i = 0; i < SIM_STEPS_PER_SAMPLE; ++i) thermalPlantStep(&plant, out, c.supply);
+
+    float plate = plant.plateC;
+    float rel = (step >= 0.0f) ? plate - c.startC : c.startC - plate;
+    float absStep = fabsf(step);
+    if (t10 < 0.0f && rel >= 0.1f * absStep) t10 = t;
+    if (t90 < 0.0f && rel >= 0.9f * absStep) t90 = t;
+    bool inBand = fabsf(plate - sp) <= c.profile.bandC;
+    if (inBand && r.toBandS < 0.0f) r.toBandS = t;
+    if (!inBand) {
+      lastOut = t + 1.0f / HEATER_SAMPLE_HZ;
+      r.settleJ = plant.energyJ;
+    }
+    float past = (step >= 0.0f) ? plate - sp : sp - plate;
+    if (past > worst) worst = past;
+    if (s >= samples - tailSamples) {
+      tailErr += plate - sp;
+      tailDuty += out;
+    }
+    if (trace) fprintf(trace, "%.1f,%.2f,%.2f,%.2f,%.3f\n", t, plate, sensed, pid.setpoint, out);
+  }
+
+  r.riseS = (t10 >= 0.0f && t90 >= 0.0f) ? t90 - t10 : -1.0f;
+  r.settleS = lastOut;
+  r.overshootC = worst;
+  r.totalJ = plant.energyJ;
+  r.finalErrC = (float)(tailErr / tailSamples);
+  r.holdDuty = (float)(tailDuty / tailSamples);
+  return r;
+}
+
+/* Public Function Definitions */
+int main(int argc, char** argv) {
+  int traceCase = (argc > 1) ? atoi(argv[1]) : -1;
+  buildCases();
+
+  printf("%-3s %-20s %7s %7s %7s %9s %9s %9s %7s %6s\n",
+         "#", "case", "rise s", "band s", "settle", "overshoot", "settle kJ", "total kJ", "err C", "duty");
+  double simS = 0.0;
+  auto wallStart = std::chrono::steady_clock::now();
+  for (uint8_t i = 0; i < caseCount; ++i) {
+    const sim_case& c = cases[i];
+    FILE* trace = NULL;
+    if (i == traceCase) {
+      trace = fopen("heater_trace.csv", "w");
+      if (trace) fprintf(trace, "t,plate,sensor,setpoint,duty\n");
+    }
+    sim_result r = runCase(c, trace);
+    if (trace) fclose(trace);
+    simS += c.durationS;
+    printf("%-3u %-20s %7.1f %7.1f %7.1f %9.2f %9.2f %9.2f %7.2f %5.0f%%\n",
+           i, c.name, r.riseS, r.toBandS, r.settleS, r.overshootC,
+           r.settleJ / 1000.0f, r.totalJ / 1000.0f, r.finalErrC, r.holdDuty * 100.0f);
+  }
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  printf("\n%.0f s simulated in %.2f s wall, %.0fx real time\n", simS, wallS, simS / wallS);
+  if (traceCase >= 0 && traceCase < caseCount) printf("Trace of case %d in heater_trace.csv\n", traceCase);
+  return 0;
+}
@@ -0,0 +1,142 @@
+/* Chef Host Build
+ *
+ * Host build (pio run -e native, src_dir = src/Host/): the Chef's HAL-ported layers
+ * against the fakes in lib/Hal, on the virtual clock. A stand-in station answers the
+ * servo link, a stand-in fader streams positions, the gauge ramps on the LED timer.
+ *
+ *   chef_host             10 s simulated
+ *   chef_host <ms>        that long
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal.h"
+#include "led_anim.h"
+#include "led_output.h"
+#include "station_link.h"
+#include "fader_follow.h"
+
+/* Constants */
+constexpr uint32_t HOST_LOOP_MS       = 20;      // Chef loop() period
+constexpr uint32_t HOST_CMD_MS        = 500;     // A servo command this often
+constexpr uint32_t STATION_ACK_US     = 1500;    // Air time both ways plus receive to start
+constexpr uint32_t STATION_MOVE_US    = 350000;
+constexpr uint32_t FADER_PERIOD_US    = 10000;
+
+const uint8_t chefMac[6]    = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+const uint8_t stationMac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+const uint8_t faderMac[6]   = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x03 };
+
+/* Statics */
+static hal_timer ackTimer, doneTimer, faderTimer;
+static station_link link;
+static link_cmd stationCmd;
+static fader_link_tx faderTx = {};
+static uint16_t faderPos = 0;
+static uint32_t faderEchoes = 0;
+static uint32_t lastFaderPos = 0;
+
+/* Private Function Definitions */
+// FUNCTION: Stand-in station, one report for every servo it was asked to move
+static void stationReport(uint8_t op) {
+  link_report report = {};
+  report.magic = LINK_MAGIC;
+  report.op = op;
+  report.seq = stationCmd.seq;
+  report.servos = stationCmd.servos;
+  report.sentUs = stationCmd.sentUs;
+  report.rxToStartUs = 200;
+  report.rxToDoneUs = (op == LINK_OP_DONE) ? STATION_MOVE_US : 0;
+  report.stationMs = halMillis();
+  halFakeRadioRx(stationMac, (const uint8_t*)&report, sizeof(report));
+}
+
+static void onStationAck(void* arg) {
+  stationReport(LINK_OP_ACK);
+  if (linkOpMoves(stationCmd.op)) halTimerStartOnce(doneTimer, STATION_MOVE_US);
+}
+
+static void onStationDone(void* arg) {
+  stationReport(LINK_OP_DONE);
+}
+
+// FUNCTION: Stand-in fader, a slow triangle at 100 packets/s
+static void onFaderTick(void* arg) {
+  static int16_t dir = 256;
+  if ((dir > 0 && faderPos > FADER_LINK_POS_MAX - dir) || (dir < 0 && faderPos < -dir)) dir = -dir;
+  faderPos += dir;
+  fader_link_pos pkt;
+  faderLinkTxStamp(&faderTx, &pkt, 0, faderPos, 0, halMicros(), halMicros());
+  halFakeRadioRx(faderMac, (const uint8_t*)&pkt, sizeof(pkt));
+}
+
+// FUNCTION: Whatever the Chef puts on the air
+static void onAir(const uint8_t* dst, const uint8_t* data, int len) {
+  if (memcmp(dst, stationMac, 6) == 0 && linkIsCmd(data, len)) {
+    memcpy(&stationCmd, data, sizeof(stationCmd));
+    halTimerStartOnce(ackTimer, STATION_ACK_US);
+  } else if (memcmp(dst, faderMac, 6) == 0 && faderLinkIsEcho(data, len)) {
+    faderEchoes++;
+  }
+}
+
+static void onRecv(const uint8_t* mac, const uint8_t* data, int len) {
+  if (stationOnRecv(&link, mac, data, len)) return;
+  faderFollowOnRecv(mac, data, len);
+}
+
+static void onFaderPos(uint8_t axis, uint16_t pos, uint8_t flags) {
+  lastFaderPos = pos;
+}
+
+static void printSummary() {
+  station_stats st;
+  stationStats(&link, &st);
+  fader_follow_stats fst;
+  faderFollowStats(&fst);
+  led_output_stats lst;
+  ledOutputStats(&lst);
+  printf("%lu ms simulated\n", (unsigned long)halMillis());
+  printf("Station link: %lu sent, %lu resends, %lu acks, %lu dones, %lu timeouts, RTT %lu us\n",
+         (unsigned long)st.sent, (unsigned long)st.resends, (unsigned long)st.acks,
+         (unsigned long)st.dones, (unsigned long)st.timeouts, (unsigned long)st.avgRttUs);
+  printf("Fader follow: %lu received, %lu stale, %lu echoes out, %lu back, last %lu\n",
+         (unsigned long)fst.received, (unsigned long)fst.stale, (unsigned long)fst.echoes,
+         (unsigned long)faderEchoes, (unsigned long)lastFaderPos);
+  printf("LED frames: %lu sent, %lu skipped, %lu us on the wire\n",
+         (unsigned long)lst.framesSent, (unsigned long)lst.framesSkipped, (unsigned long)lst.lastFrameUs);
+}
+
+/* Public Function Definitions */
+void setup() {
+  halFakeSetMac(chefMac);
+  halFakeRadioSetTx(onAir);
+  halRadioBegin(onRecv);
+  stationInit(&link);
+  halTimerCreate(onStationAck, NULL, "station_ack", &ackTimer);
+  halTimerCreate(onStationDone, NULL, "station_done", &doneTimer);
+  halTimerCreate(onFaderTick, NULL, "fader", &faderTimer);
+  halTimerStartPeriodic(faderTimer, FADER_PERIOD_US);
+
+  faderFollowBegin(onFaderPos);
+  ledAnimBegin(14, 2);
+  ledAnimSetStageColor(0xFF, 0x40, 0x00);
+  atexit(printSummary);
+}
+
+void loop() {
+  static uint32_t lastCmdMs = 0;
+  static bool open = false;
+  uint32_t nowMs = halMillis();
+
+  if (nowMs - lastCmdMs >= HOST_CMD_MS) {
+    lastCmdMs = nowMs;
+    open = !open;
+    stationSend(&link, stationMac, open ? LINK_OP_OPEN : LINK_OP_CLOSE, LINK_SERVO_TOP | LINK_SERVO_BOTTOM, 0);
+  }
+  stationPoll(&link);
+  ledAnimSetGauge((uint16_t)((nowMs % 4000) * 0xFFFF / 4000));
+  halDelayMs(HOST_LOOP_MS);
+}
@@ -0,0 +1,579 @@
+/* Line Simulator
+ *
+ * Host build (pio run -e native, src_dir = src/LineSim/): a whole toast line on one
+ * ESP-NOW channel, event by event on a virtual clock. Every Chef runs the firmware's
+ * toast_line and station_link, every servo station the firmware's servo_remote; the
+ * servos take their planned trajectory time, the channel one frame at a time.
+ *
+ *   line_sim                       1, 2, 4, 8, 16 stations, nominal stage timing
+ *   line_sim -n 4,8 -w 50,100      station counts x stage waits (% of TOAST_STAGES)
+ *
+ *   -n <list>   Stations on the channel, each a Chef and its servo station
+ *   -w <list>   Stage waits, % of TOAST_STAGES
+ *   -d <ms>     Brand time in the TOAST stages
+ *   -f <pct>    Brands that never come in (iron never ready), the line waits TOAST_BRAND_TIMEOUT_MS
+ *   -m <min>    Simulated minutes per case
+ *   -r <n>      Slice requests per minute per station, 0: always one waiting
+ *   -b <n>      Other frames per second per station (a remote fader streams 100)
+ *   -l <pct>    Frames lost on the air
+ *   -v          Per-station table for every case
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <queue>
+#include <vector>
+#include "hal.h"
+#include "station_link.h"
+#include "toast_line.h"
+#include "servo_remote.h"
+#include "servo_trajectory.h"
+#include "fader_link.h"
+
+/* Constants */
+constexpr uint8_t  SIM_MAX_STATIONS     = 32;
+constexpr uint8_t  SIM_MAX_CASES        = 8;      // Per list
+constexpr uint32_t SIM_LOOP_US          = 20000;  // Chef loop() period
+constexpr uint32_t SIM_REMOTE_WAKE_US   = 50;     // Notify to the remote task running
+constexpr uint16_t SIM_AIR_QUEUE        = 4096;   // Frames waiting for the channel, whole line
+
+// 802.11b 1 Mbps, long preamble: channel access, the frame, SIFS and the MAC-level ACK
+constexpr uint32_t AIR_ACCESS_US        = 200;    // DIFS + mean backoff
+constexpr uint32_t AIR_PHY_US           = 192;
+constexpr uint32_t AIR_OVERHEAD_BYTES   = 43;     // MAC header, ESP-NOW vendor element, FCS
+constexpr uint32_t AIR_US_PER_BYTE      = 8;
+constexpr uint32_t AIR_ACK_US           = 314;
+
+// Station servos, as Demo-Servo's models
+constexpr uint8_t  SIM_SERVOS           = 5;      // One per LINK_SERVO_* bit
+constexpr uint8_t  SIM_MOTION_DEPTH     = 8;      // MOTION_QUEUE_DEPTH
+constexpr uint16_t SIM_FRAME_MS         = 20;     // SERVO_FRAME_MS
+constexpr uint16_t SIM_DS_SETTLE_MS     = 80;     // DS_SETTLE_MS
+constexpr uint16_t SIM_OPEN_US          = 2000;   // Dropper presets
+constexpr uint16_t SIM_CLOSED_US        = 1000;
+constexpr uint16_t SIM_PARALLAX_DEG_S   = 400;    // Feedback loop at full speed ...
+constexpr uint8_t  SIM_PARALLAX_SETTLE  = 3;      // ... then FB_SETTLE_FRAMES
+constexpr traj_limits SIM_DS_LIMITS       = { 4000, 40000 };
+constexpr traj_limits SIM_TOWERPRO_LIMITS = { 3000, 30000 };
+
+/* Typedefs */
+enum sim_event_type : uint8_t {
+  EV_CHEF_LOOP,
+  EV_REQUEST,
+  EV_OTHER,
+  EV_AIR_DONE,
+  EV_SERVO_DONE,
+  EV_REMOTE,
+};
+
+typedef struct sim_event {
+  uint64_t atUs;
+  uint64_t order;           // Same time: first scheduled first
+  uint8_t type;             // sim_event_type
+  uint8_t node;
+  uint8_t servo;
+} sim_event;
+
+struct sim_later {
+  bool operator()(const sim_event& a, const sim_event& b) const {
+    return (a.atUs != b.atUs) ? a.atUs > b.atUs : a.order > b.order;
+  }
+};
+
+typedef struct sim_frame {
+  uint64_t queuedUs;
+  uint8_t src[6];
+  uint8_t dst[6];
+  uint8_t len;
+  uint8_t data[32];
+  bool other;               // Background traffic, air time only
+} sim_frame;
+
+typedef struct sim_air_stats {
+  uint32_t frames;
+  uint64_t waitUs;          // Queued to on the air
+  uint32_t maxWaitUs;
+} sim_air_stats;
+
+typedef struct sim_move {
+  remote_done_fn cb;
+  void* cbArg;
+} sim_move;
+
+typedef struct sim_servo {
+  uint16_t us;
+  int16_t deg;
+  uint64_t busyUntilUs;
+  sim_move moves[SIM_MOTION_DEPTH];
+  uint8_t head;
+  uint8_t count;
+} sim_servo;
+
+typedef struct sim_chef {
+  uint8_t mac[6];
+  station_link link;
+  toast_line line;
+  sim_air_stats air;
+  uint32_t brandPhaseMs;    // TOAST phase the brand below was drawn for
+  bool brandLost;
+} sim_chef;
+
+typedef struct sim_station {
+  uint8_t mac[6];
+  servo_remote remote;
+  sim_servo servos[SIM_SERVOS];
+  sim_air_stats air;
+} sim_station;
+
+typedef struct sim_case {
+  uint8_t stations;
+  uint16_t waitPct;
+} sim_case;
+
+/* Statics */
+static uint8_t stationCounts[SIM_MAX_CASES] = { 1, 2, 4, 8, 16 };
+static uint8_t stationCountN = 5;
+static uint16_t waitPcts[SIM_MAX_CASES] = { 100 };
+static uint8_t waitPctN = 1;
+static uint32_t brandMs = 2000;           // 300 J at 150 W
+static float brandLostPct = 0.0f;
+static uint32_t minutes = 10;
+static float requestsPerMin = 0.0f;
+static float otherPerS = 0.0f;
+static float lossPct = 0.0f;
+static bool verbose = false;
+
+// One case, fresh in every child process
+static sim_chef chefs[SIM_MAX_STATIONS];
+static sim_station stations[SIM_MAX_STATIONS];
+static uint8_t stationCount = 0;
+static toast_stage_cfg stages[TOAST_STAGE_COUNT];
+static std::priority_queue<sim_event, std::vector<sim_event>, sim_later> events;
+static uint64_t eventOrder = 0;
+static uint32_t rng = 0x9E3779B9;
+
+static sim_frame airQueue[SIM_AIR_QUEUE];
+static uint16_t airHead = 0, airCount = 0;
+static sim_frame onAir;
+static bool airBusy = false;
+static uint64_t airBusyUs = 0;
+static uint32_t airLost = 0, airOverflow = 0;
+
+// Whose code is running: a frame it sends leaves from here
+static const uint8_t* ctxMac = NULL;
+static sim_air_stats* ctxAir = NULL;
+static uint8_t ctxStation = 0;
+
+/* Private Function Definitions */
+static float uniform() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return (rng >> 8) * (1.0f / 16777216.0f);
+}
+
+static void schedule(uint64_t atUs, uint8_t type, uint8_t node, uint8_t servo = 0) {
+  events.push({ atUs, eventOrder++, type, node, servo });
+}
+
+static void runAsChef(uint8_t i) {
+  ctxMac = chefs[i].mac;
+  ctxAir = &chefs[i].air;
+}
+
+static void runAsStation(uint8_t i) {
+  ctxMac = stations[i].mac;
+  ctxAir = &stations[i].air;
+  ctxStation = i;
+}
+
+static uint32_t airtimeUs(uint8_t len) {
+  return AIR_ACCESS_US + AIR_PHY_US + (len + AIR_OVERHEAD_BYTES) * AIR_US_PER_BYTE + AIR_ACK_US;
+}
+
+// FUNCTION: Next frame on the air, the channel carries one at a time
+static void startTx() {
+  onAir = airQueue[airHead];
+  airHead = (airHead + 1) % SIM_AIR_QUEUE;
+  airCount--;
+  airBusy = true;
+  uint32_t us = airtimeUs(onAir.len);
+  airBusyUs += us;
+  schedule(halFakeNowUs() + us, EV_AIR_DONE, 0);
+}
+
+static void queueFrame(const uint8_t* src, const uint8_t* dst, const uint8_t* data, int len, bool other,
+                       sim_air_stats* air) {
+  if (airCount >= SIM_AIR_QUEUE) {
+    airOverflow++;
+    return;
+  }
+  sim_frame& f = airQueue[(airHead + airCount) % SIM_AIR_QUEUE];
+  f.queuedUs = halFakeNowUs();
+  memcpy(f.src, src, 6);
+  memcpy(f.dst, dst, 6);
+  f.len = (uint8_t)len;
+  if (data) memcpy(f.data, data, len);
+  f.other = other;
+  airCount++;
+  if (air) air->frames++;
+  if (!airBusy) startTx();
+}
+
+// FUNCTION: halRadioSend() of whoever is running
+static void onSend(const uint8_t* dst, const uint8_t* data, int len) {
+  if (len > (int)sizeof(onAir.data)) return;
+  queueFrame(ctxMac, dst, data, len, false, ctxAir);
+}
+
+// MACs are 02:00:00:00:<1 Chef, 2 station>:<index>
+static void makeMac(uint8_t* mac, uint8_t role, uint8_t i) {
+  const uint8_t m[6] = { 0x02, 0x00, 0x00, 0x00, role, i };
+  memcpy(mac, m, 6);
+}
+
+static void deliver(const sim_frame& f) {
+  uint8_t i = f.dst[5];
+  if (f.other || i >= stationCount) return;
+  if (lossPct > 0.0f && uniform() * 100.0f < lossPct) {
+    airLost++;
+    return;
+  }
+  if (f.dst[4] == 1) {
+    runAsChef(i);
+    stationOnRecv(&chefs[i].link, f.src, f.data, f.len);
+  } else if (f.dst[4] == 2) {
+    runAsStation(i);
+    if (remoteOnRecv(&stations[i].remote, f.src, f.data, f.len)) {
+      schedule(halFakeNowUs() + SIM_REMOTE_WAKE_US, EV_REMOTE, i);
+    }
+  }
+}
+
+static uint16_t angleToUs(int16_t deg) {
+  if (deg < 0) deg = 0;
+  if (deg > 180) deg = 180;
+  return (uint16_t)(500 + (uint32_t)deg * 2000 / 180);
+}
+
+static uint32_t trajMs(uint16_t fromUs, uint16_t toUs, const traj_limits* lim) {
+  traj_state traj;
+  trajPlan(&traj, TRAJ_SCURVE, fromUs, toUs, lim, 0);
+  return trajDurationMs(&traj);
+}
+
+// FUNCTION: Stand-in for the station's remoteExec(): the move queues behind the
+// servo's last one and takes its planned time
+static link_status simExec(uint8_t op, uint8_t servo, int16_t arg,
+                           remote_done_fn cb, void* cbArg, uint8_t* pin) {
+  uint8_t idx = 0;
+  while (idx < SIM_SERVOS && !(servo & (1 << idx))) idx++;
+  if (idx >= SIM_SERVOS) return LINK_BAD_SERVO;
+  sim_servo& s = stations[ctxStation].servos[idx];
+  if (op == LINK_OP_PING || op == LINK_OP_STOP) return LINK_OK;
+
+  uint32_t ms = 0;
+  switch (servo) {
+    case LINK_SERVO_TOP:
+    case LINK_SERVO_BOTTOM: {
+      if (op == LINK_OP_BOUNCE) return LINK_BAD_OP;
+      uint16_t to = (op == LINK_OP_OPEN) ? SIM_OPEN_US : (op == LINK_OP_CLOSE) ? SIM_CLOSED_US : angleToUs(arg);
+      ms = trajMs(s.us, to, &SIM_DS_LIMITS) + SIM_DS_SETTLE_MS;
+      s.us = to;
+      break;
+    }
+    case LINK_SERVO_TOWERPRO: {
+      if (op != LINK_OP_ANGLE) return LINK_BAD_OP;
+      uint16_t to = angleToUs(arg);
+      ms = trajMs(s.us, to, &SIM_TOWERPRO_LIMITS);
+      s.us = to;
+      break;
+    }
+    case LINK_SERVO_CONTINUOUS:
+      if (op != LINK_OP_BOUNCE) return LINK_BAD_OP;
+      ms = 2 * (uint32_t)((arg < 0) ? 0 : arg) * SIM_FRAME_MS;
+      break;
+    case LINK_SERVO_PARALLAX: {
+      if (op != LINK_OP_ANGLE) return LINK_BAD_OP;
+      uint32_t deg = (uint32_t)abs(arg - s.deg);
+      ms = SIM_FRAME_MS + deg * 1000 / SIM_PARALLAX_DEG_S + SIM_PARALLAX_SETTLE * SIM_FRAME_MS;
+      s.deg = arg;
+      break;
+    }
+  }
+
+  if (s.count >= SIM_MOTION_DEPTH) return LINK_BUSY;
+  uint64_t now = halFakeNowUs();
+  uint64_t start = (s.busyUntilUs > now) ? s.busyUntilUs : now;
+  s.busyUntilUs = start + (uint64_t)ms * 1000;
+  s.moves[(s.head + s.count) % SIM_MOTION_DEPTH] = { cb, cbArg };
+  s.count++;
+  schedule(s.busyUntilUs, EV_SERVO_DONE, ctxStation, idx);
+  *pin = idx;
+  return LINK_OK;
+}
+
+static bool simKick(uint8_t pin) { return true; }
+
+static bool simBrand(void* arg) {
+  sim_chef& chef = *(sim_chef*)arg;
+  uint32_t phaseMs = chef.line.phaseStartMs;
+  if (chef.brandPhaseMs != phaseMs) {
+    chef.brandPhaseMs = phaseMs;
+    chef.brandLost = brandLostPct > 0.0f && uniform() * 100.0f < brandLostPct;
+  }
+  return !chef.brandLost && halMillis() - phaseMs >= brandMs;
+}
+
+static uint64_t exponentialUs(float perS) {
+  return (uint64_t)(-logf(1.0f - uniform()) / perS * 1e6f) + 1;
+}
+
+static void handle(const sim_event& ev) {
+  uint8_t i = ev.node;
+  switch (ev.type) {
+    case EV_CHEF_LOOP:
+      runAsChef(i);
+      if (requestsPerMin <= 0.0f && chefs[i].line.requestCount == 0) toastLineRequest(&chefs[i].line);
+      stationPoll(&chefs[i].link);
+      toastLinePoll(&chefs[i].line);
+      schedule(ev.atUs + SIM_LOOP_US, EV_CHEF_LOOP, i);
+      break;
+
+    case EV_REQUEST:
+      toastLineRequest(&chefs[i].line);
+      schedule(ev.atUs + exponentialUs(requestsPerMin / 60.0f), EV_REQUEST, i);
+      break;
+
+    case EV_OTHER: {
+      static const uint8_t broadcast[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+      queueFrame(chefs[i].mac, broadcast, NULL, sizeof(fader_link_pos), true, NULL);
+      schedule(ev.atUs + exponentialUs(otherPerS), EV_OTHER, i);
+      break;
+    }
+
+    case EV_AIR_DONE: {
+      sim_frame f = onAir;
+      airBusy = false;
+      if (!f.other) {
+        sim_air_stats* air = (f.src[4] == 1) ? &chefs[f.src[5]].air : &stations[f.src[5]].air;
+        uint32_t waitUs = (uint32_t)(ev.atUs - airtimeUs(f.len) - f.queuedUs);
+        air->waitUs += waitUs;
+        if (waitUs > air->maxWaitUs) air->maxWaitUs = waitUs;
+      }
+      deliver(f);
+      if (!airBusy && airCount) startTx();
+      break;
+    }
+
+    case EV_SERVO_DONE: {
+      sim_servo& s = stations[i].servos[ev.servo];
+      sim_move m = s.moves[s.head];
+      s.head = (s.head + 1) % SIM_MOTION_DEPTH;
+      s.count--;
+      runAsStation(i);
+      if (m.cb) m.cb(ev.servo, m.cbArg);
+      schedule(ev.atUs + SIM_REMOTE_WAKE_US, EV_REMOTE, i);
+      break;
+    }
+
+    case EV_REMOTE:
+      runAsStation(i);
+      remoteService(&stations[i].remote);
+      break;
+  }
+}
+
+static uint32_t avg(uint64_t sum, uint32_t n) {
+  return n ? (uint32_t)(sum / n) : 0;
+}
+
+// FUNCTION: One case start to end, prints its line (and station table)
+static void runCase(const sim_case& c, uint32_t seed) {
+  auto wallStart = std::chrono::steady_clock::now();
+  rng = seed;
+  stationCount = c.stations;
+  for (uint8_t s = 0; s < TOAST_STAGE_COUNT; ++s) {
+    stages[s] = TOAST_STAGES[s];
+    stages[s].waitMs = (uint16_t)((uint32_t)TOAST_STAGES[s].waitMs * c.waitPct / 100);
+  }
+  halFakeRadioSetTx(onSend);
+
+  for (uint8_t i = 0; i < stationCount; ++i) {
+    sim_chef& chef = chefs[i];
+    sim_station& st = stations[i];
+    makeMac(chef.mac, 1, i);
+    makeMac(st.mac, 2, i);
+    stationInit(&chef.link);
+    toastLineInit(&chef.line, stages, &chef.link, st.mac, simBrand, &chef);
+    chef.brandPhaseMs = UINT32_MAX;
+    remoteBegin(&st.remote, simExec, simKick);
+    for (uint8_t k = 0; k < SIM_SERVOS; ++k) st.servos[k].us = SIM_CLOSED_US;
+
+    schedule((uint64_t)(uniform() * SIM_LOOP_US), EV_CHEF_LOOP, i);
+    if (requestsPerMin > 0.0f) schedule(exponentialUs(requestsPerMin / 60.0f), EV_REQUEST, i);
+    if (otherPerS > 0.0f) schedule(exponentialUs(otherPerS), EV_OTHER, i);
+  }
+
+  uint64_t endUs = (uint64_t)minutes * 60000000ULL;
+  uint64_t handled = 0;
+  while (!events.empty() && events.top().atUs < endUs) {
+    sim_event ev = events.top();
+    events.pop();
+    halFakeAdvanceUs(ev.atUs - halFakeNowUs());
+    handle(ev);
+    handled++;
+  }
+  halFakeAdvanceUs(endUs - halFakeNowUs());
+
+  // Line totals
+  uint32_t slices = 0, moves = 0, resends = 0, timeouts = 0, faults = 0, unbranded = 0, acks = 0, maxRtt = 0;
+  uint32_t maxCycle = 0, maxQueue = 0, maxMove = 0, frames = 0, maxAirWait = 0;
+  uint64_t sumCycle = 0, sumQueue = 0, sumMove = 0, sumRtt = 0, airWait = 0;
+  for (uint8_t i = 0; i < stationCount; ++i) {
+    toast_line_stats ls;
+    toastLineStats(&chefs[i].line, &ls);
+    station_stats ss;
+    stationStats(&chefs[i].link, &ss);
+    slices += ls.slices;
+    sumCycle += ls.sumCycleMs;
+    if (ls.maxCycleMs > maxCycle) maxCycle = ls.maxCycleMs;
+    sumQueue += ls.sumQueueMs;
+    if (ls.maxQueueMs > maxQueue) maxQueue = ls.maxQueueMs;
+    moves += ls.moves;
+    sumMove += ls.sumMoveMs;
+    if (ls.maxMoveMs > maxMove) maxMove = ls.maxMoveMs;
+    faults += ls.faults;
+    unbranded += ls.brandTimeouts;
+    resends += ss.resends;
+    timeouts += ss.timeouts;
+    acks += ss.acks;
+    sumRtt += (uint64_t)ss.avgRttUs * ss.acks;
+    if (ss.maxRttUs > maxRtt) maxRtt = ss.maxRttUs;
+    const sim_air_stats* airs[2] = { &chefs[i].air, &stations[i].air };
+    for (const sim_air_stats* a : airs) {
+      frames += a->frames;
+      airWait += a->waitUs;
+      if (a->maxWaitUs > maxAirWait) maxAirWait = a->maxWaitUs;
+    }
+  }
+  float simMin = (float)minutes;
+  printf("%3u %5u%% %7lu %7.2f %7lu %7lu %7lu %7lu %6lu %6lu %6lu %6lu %6lu %5lu %5lu %6lu %5.1f%% %6lu %6lu\n",
+         c.stations, c.waitPct, (unsigned long)slices, slices / simMin / c.stations,
+         (unsigned long)avg(sumCycle, slices), (unsigned long)maxCycle,
+         (unsigned long)avg(sumQueue, slices), (unsigned long)maxQueue,
+         (unsigned long)avg(sumMove, moves), (unsigned long)maxMove,
+         (unsigned long)avg(sumRtt, acks), (unsigned long)maxRtt,
+         (unsigned long)resends, (unsigned long)timeouts, (unsigned long)faults, (unsigned long)unbranded,
+         100.0f * airBusyUs / endUs, (unsigned long)avg(airWait, frames), (unsigned long)maxAirWait);
+
+  if (verbose) {
+    for (uint8_t i = 0; i < stationCount; ++i) {
+      toast_line_stats ls;
+      toastLineStats(&chefs[i].line, &ls);
+      station_stats ss;
+      stationStats(&chefs[i].link, &ss);
+      remote_stats rs;
+      remoteStats(&stations[i].remote, &rs);
+      const sim_air_stats& ca = chefs[i].air;
+      const sim_air_stats& sa = stations[i].air;
+      printf("    #%-2u slices %5lu  cycle %6lu/%6lu  queue %6lu/%6lu  move %5lu/%5lu  rtt %5lu/%5lu"
+             "  resends %4lu  timeouts %3lu  dup %3lu  start %4lu us  air wait %5lu/%5lu %5lu/%5lu\n",
+             i, (unsigned long)ls.slices, (unsigned long)avg(ls.sumCycleMs, ls.slices), (unsigned long)ls.maxCycleMs,
+             (unsigned long)avg(ls.sumQueueMs, ls.slices), (unsigned long)ls.maxQueueMs,
+             (unsigned long)avg(ls.sumMoveMs, ls.moves), (unsigned long)ls.maxMoveMs,
+             (unsigned long)ss.avgRttUs, (unsigned long)ss.maxRttUs, (unsigned long)ss.resends,
+             (unsigned long)ss.timeouts, (unsigned long)rs.duplicates, (unsigned long)rs.maxRxToStartUs,
+             (unsigned long)avg(ca.waitUs, ca.frames), (unsigned long)ca.maxWaitUs,
+             (unsigned long)avg(sa.waitUs, sa.frames), (unsigned long)sa.maxWaitUs);
+    }
+    printf("    stage ms:");
+    for (uint8_t s = 0; s < TOAST_STAGE_COUNT; ++s) {
+      uint64_t sum = 0;
+      for (uint8_t i = 0; i < stationCount; ++i) sum += chefs[i].line.stats.stageMs[s];
+      printf(" %lu", (unsigned long)avg(sum, slices ? slices : 1));
+    }
+    printf("  (per slice)\n");
+  }
+
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  if (verbose || airLost || airOverflow) {
+    printf("    %llu events, %lu lost, %lu over the air queue, %.2f s wall, %.0f slices/s\n",
+           (unsigned long long)handled, (unsigned long)airLost, (unsigned long)airOverflow,
+           wallS, slices / wallS);
+  }
+}
+
+// FUNCTION: "1,2,4" into out, returns the count
+template <typename T>
+static uint8_t parseList(const char* s, T* out) {
+  uint8_t n = 0;
+  while (*s && n < SIM_MAX_CASES) {
+    char* end;
+    long v = strtol(s, &end, 10);
+    if (end == s) break;
+    out[n++] = (T)v;
+    s = (*end == ',') ? end + 1 : end;
+  }
+  return n;
+}
+
+/* Public Function Definitions */
+int main(int argc, char** argv) {
+  int opt;
+  while ((opt = getopt(argc, argv, "n:w:d:f:m:r:b:l:v")) != -1) {
+    switch (opt) {
+      case 'n': stationCountN = parseList(optarg, stationCounts); break;
+      case 'w': waitPctN = parseList(optarg, waitPcts); break;
+      case 'd': brandMs = (uint32_t)atol(optarg); break;
+      case 'f': brandLostPct = (float)atof(optarg); break;
+      case 'm': minutes = (uint32_t)atol(optarg); break;
+      case 'r': requestsPerMin = (float)atof(optarg); break;
+      case 'b': otherPerS = (float)atof(optarg); break;
+      case 'l': lossPct = (float)atof(optarg); break;
+      case 'v': verbose = true; break;
+      default:
+        fprintf(stderr, "line_sim [-n 1,2,4] [-w 50,100] [-d brand_ms] [-f lost%%] [-m min] [-r req/min] [-b frames/s] [-l loss%%] [-v]\n");
+        return 1;
+    }
+  }
+
+  printf("%u min per case, brand %lu ms (%.1f%% never in), %s, %.0f other frames/s per station, %.1f%% lost\n",
+         minutes, (unsigned long)brandMs, brandLostPct, (requestsPerMin > 0.0f) ? "Poisson requests" : "saturated",
+         otherPerS, lossPct);
+  if (requestsPerMin > 0.0f) printf("%.1f slice requests per minute per station\n", requestsPerMin);
+  printf("%3s %6s %7s %7s %15s %15s %13s %13s %6s %6s %6s %6s %6s %13s\n",
+         "sta", "wait", "slices", "/min", "cycle avg/max", "queue avg/max", "move avg/max", "rtt avg/max",
+         "resend", "tmo", "fault", "nobrnd", "air", "air wait us");
+
+  auto wallStart = std::chrono::steady_clock::now();
+  uint32_t seed = 0x9E3779B9;
+  for (uint8_t w = 0; w < waitPctN; ++w) {
+    for (uint8_t n = 0; n < stationCountN; ++n) {
+      sim_case c = { stationCounts[n], waitPcts[w] };
+      if (!c.stations || c.stations > SIM_MAX_STATIONS) {
+        printf("%3u stations: 1 to %u\n", c.stations, SIM_MAX_STATIONS);
+        continue;
+      }
+      // Every case in its own process: the firmware modules start from scratch
+      fflush(stdout);
+      pid_t pid = fork();
+      if (pid == 0) {
+        runCase(c, seed);
+        fflush(stdout);
+        _exit(0);
+      }
+      if (pid > 0) waitpid(pid, NULL, 0);
+      seed = seed * 1664525u + 1013904223u;
+    }
+  }
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  printf("\n%u cases in %.2f s wall\n", (unsigned)(waitPctN * stationCountN), wallS);
+  return 0;
+}
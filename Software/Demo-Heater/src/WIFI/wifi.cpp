@@ -1,5 +1,7 @@
 #include <Arduino.h>
-#include <WiFi.h>
+#include "cmd_shell.h"
+#include "hal.h"
+#include "print_queue.h"
 #include <esp_now.h>
 
 #define LED_PIN (2)
@@ -30,33 +32,12 @@ typedef struct struct_message {
 struct_message incomingData;
 struct_message outgoingData; 
 
-// Task handles
-TaskHandle_t TaskWiFiHandle = NULL;
-TaskHandle_t TaskPrintHandle = NULL;
-
-// Print queue and buffer
-QueueHandle_t printQueue;
-const int PRINT_BUFFER_SIZE = 128;
-
-// Sends formatted strings to queue (copies data instead of pointer)
-void enqueuePrint(const char* fmt, ...) {
-  char tempBuf[PRINT_BUFFER_SIZE];
-  va_list args;
-  va_start(args, fmt);
-  vsnprintf(tempBuf, PRINT_BUFFER_SIZE, fmt, args);
-  va_end(args);
-  xQueueSend(printQueue, tempBuf, 10 / portTICK_PERIOD_MS);
-}
+uint8_t broadcastAddress[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
 
-// Print task: reads messages and prints them
-void printTask(void* parameter) {
-  char localBuffer[PRINT_BUFFER_SIZE];
-  while (true) {
-    if (xQueueReceive(printQueue, localBuffer, portMAX_DELAY)) {
-      Serial.print(localBuffer);
-    }
-  }
-}
+// Task handles, stack and control block static: nothing from the heap after setup()
+hal_task TaskWiFiHandle = NULL;
+uint8_t wifiTaskStack[10000];
+hal_task_mem wifiTaskMem = HAL_TASK_MEM(wifiTaskStack);
 
 // ESP-NOW receive callback
 void OnDataRecv(const uint8_t* mac, const uint8_t* incomingDataPtr, int len) {
@@ -74,20 +55,14 @@ void OnDataSent(const uint8_t* mac_addr, esp_now_send_status_t status) {
 void wifiTask(void* parameter) {
   enqueuePrint("WiFi Task started on core: %d\n", xPortGetCoreID());
 
-  WiFi.mode(WIFI_STA);
-  WiFi.disconnect();
-
-  if (esp_now_init() != ESP_OK) {
+  if (!halRadioBegin(OnDataRecv)) {
     enqueuePrint("Error initializing ESP-NOW\n");
     vTaskDelete(NULL);
   }
-
-  esp_now_register_recv_cb(OnDataRecv);
   esp_now_register_send_cb(OnDataSent);
 
-  // Add broadcast peer
+  // Add broadcast peer here, the send loop never allocates
   esp_now_peer_info_t peerInfo = {};
-  uint8_t broadcastAddress[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
   memcpy(peerInfo.peer_addr, broadcastAddress, 6);
   peerInfo.channel = 0;
   peerInfo.encrypt = false;
@@ -102,9 +77,7 @@ void wifiTask(void* parameter) {
     strcpy(outgoingData.msg, "Hello ESP-NOW");
     outgoingData.value = millis() / 1000;
 
-    esp_err_t result = esp_now_send(broadcastAddress, (uint8_t*)&outgoingData, sizeof(outgoingData));
-
-    if (result == ESP_OK) {
+    if (halRadioSend(broadcastAddress, (uint8_t*)&outgoingData, sizeof(outgoingData))) {
       enqueuePrint("Sent with success\n");
     } else {
       enqueuePrint("Error sending the data\n");
@@ -113,30 +86,46 @@ void wifiTask(void* parameter) {
   }
 }
 
+void cmdOn(int argc, char** argv) {
+  digitalWrite(OUT_PIN, HIGH);
+  enqueuePrint("OUT_PIN turned ON\n");
+}
+
+void cmdOff(int argc, char** argv) {
+  digitalWrite(OUT_PIN, LOW);
+  enqueuePrint("OUT_PIN turned OFF\n");
+}
+
+// Bare number: PWM duty in percent
+void cmdPwm(int argc, char** argv) {
+  long userValue;
+  if (shellParseInt(argv[0], &userValue) && userValue >= 0 && userValue <= 100) {
+    pwmDutyCycle = map(userValue, 0, 100, 0, 255);
+    ledcWrite(pwmChannel, pwmDutyCycle);
+    enqueuePrint("PWM duty cycle set to %ld%%\n", userValue);
+  } else {
+    enqueuePrint("Unknown command. Use ON, OFF, or a number (0–100).\n");
+  }
+}
+
+const shell_cmd commands[] = {
+  { "ON",  "OUT_PIN high", cmdOn },
+  { "OFF", "OUT_PIN low",  cmdOff },
+};
+constexpr uint8_t NUM_COMMANDS = sizeof(commands) / sizeof(commands[0]);
+
 void setup() {
   pinMode(LED_PIN, OUTPUT);
   pinMode(OUT_PIN, OUTPUT);
   Serial.begin(115200);
+  shellBegin(Serial);
 
-  // Create a queue with 10 message slots
-  printQueue = xQueueCreate(10, PRINT_BUFFER_SIZE);
-
-  if (printQueue == NULL) {
-    Serial.println("Failed to create print queue!");
+  // Shared print queue, drained by the print task (core 0)
+  if (!printQueueBegin(0)) {
+    Serial.println("Failed to start print queue!");
     while (1);
   }
 
-  // Start print task (core 0)
-  xTaskCreatePinnedToCore(
-    printTask,
-    "Print Task",
-    4096,
-    NULL,
-    1,
-    &TaskPrintHandle,
-    0
-  );
-
   // Setup PWM
   ledcSetup(pwmChannel, pwmFreq, pwmResolution);
   ledcAttachPin(PWM_PIN, pwmChannel);
@@ -144,12 +133,10 @@ void setup() {
 
   enqueuePrint("Type 'GO' then press Enter to start:\n");
 
-  String input;
   while (!ready) {
-    if (Serial.available()) {
-      input = Serial.readStringUntil('\n');
-      input.trim();
-      if (input.equalsIgnoreCase("GO")) {
+    char* input = shellGetLine();
+    if (input) {
+      if (strcasecmp(input, "GO") == 0) {
         ready = true;
         enqueuePrint("Starting main loop...\n");
         enqueuePrint("You can enter 'ON', 'OFF', or a PWM value (0–100).\n");
@@ -161,17 +148,11 @@ void setup() {
   }
 
   // Start WiFi task on core 1
-  xTaskCreatePinnedToCore(
-    wifiTask,
-    "WiFi Task",
-    10000,
-    NULL,
-    1,
-    &TaskWiFiHandle,
-    1
-  );
-
-  enqueuePrint("MAC Address: %s\n", WiFi.macAddress().c_str());
+  halTaskStart(wifiTask, NULL, "WiFi Task", &wifiTaskMem, 1, 1, &TaskWiFiHandle);
+
+  uint8_t mac[6];
+  halRadioMac(mac);
+  enqueuePrint("MAC Address: %02X:%02X:%02X:%02X:%02X:%02X\n", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 }
 
 void loop() {
@@ -190,26 +171,8 @@ void loop() {
     enqueuePrint("Hello! Time since boot: %lu ms\n", currentMillis);
   }
 
-  // Command handling
-  if (Serial.available()) {
-    String cmd = Serial.readStringUntil('\n');
-    cmd.trim();
-
-    if (cmd.equalsIgnoreCase("ON")) {
-      digitalWrite(OUT_PIN, HIGH);
-      enqueuePrint("OUT_PIN turned ON\n");
-    } else if (cmd.equalsIgnoreCase("OFF")) {
-      digitalWrite(OUT_PIN, LOW);
-      enqueuePrint("OUT_PIN turned OFF\n");
-    } else if (cmd.toInt() >= 0 && cmd.toInt() <= 100) {
-      int userValue = cmd.toInt();
-      pwmDutyCycle = map(userValue, 0, 100, 0, 255);
-      ledcWrite(pwmChannel, pwmDutyCycle);
-      enqueuePrint("PWM duty cycle set to %d%%\n", userValue);
-    } else {
-      enqueuePrint("Unknown command. Use ON, OFF, or a number (0–100).\n");
-    }
-  }
+  // Command handling, never waits on the UART
+  shellPoll(commands, NUM_COMMANDS, cmdPwm);
 
   vTaskDelay(20 / portTICK_PERIOD_MS);
 }
@@ -1,5 +1,6 @@
 #include <Arduino.h>
-#include <WiFi.h>
+#include "hal.h"
+#include "print_queue.h"
 #include <esp_now.h>
 
 // Structure must match the sender
@@ -14,29 +15,6 @@ struct_message outgoingData;
 // Master's MAC address
 uint8_t masterMAC[] = {0x88, 0x13, 0xBF, 0x0B, 0xC4, 0x58};
 
-QueueHandle_t printQueue;
-const int PRINT_BUFFER_SIZE = 128;
-
-// Add messages to the print queue
-void enqueuePrint(const char* fmt, ...) {
-  char tempBuf[PRINT_BUFFER_SIZE];
-  va_list args;
-  va_start(args, fmt);
-  vsnprintf(tempBuf, PRINT_BUFFER_SIZE, fmt, args);
-  va_end(args);
-  xQueueSend(printQueue, tempBuf, portMAX_DELAY);
-}
-
-// Dedicated print task
-void printTask(void* parameter) {
-  char localBuffer[PRINT_BUFFER_SIZE];
-  while (true) {
-    if (xQueueReceive(printQueue, localBuffer, portMAX_DELAY)) {
-      Serial.println(localBuffer);
-    }
-  }
-}
-
 // Callback when data is received
 void OnDataRecv(const uint8_t* mac, const uint8_t* incomingDataPtr, int len) {
   memcpy(&incomingData, incomingDataPtr, sizeof(incomingData));
@@ -47,17 +25,16 @@ void OnDataRecv(const uint8_t* mac, const uint8_t* incomingDataPtr, int len) {
            mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 
   // Print received message
-  enqueuePrint("Received from %s: %s, value: %d", macStr, incomingData.msg, incomingData.value);
+  enqueuePrint("Received from %s: %s, value: %d\n", macStr, incomingData.msg, incomingData.value);
 
   // Prepare acknowledgment
   strcpy(outgoingData.msg, "Ack from Slave");
   outgoingData.value = millis() / 1000;
 
-  esp_err_t result = esp_now_send(masterMAC, (uint8_t*)&outgoingData, sizeof(outgoingData));
-  if (result == ESP_OK) {
-    enqueuePrint("Ack sent back to master");
+  if (halRadioSend(masterMAC, (uint8_t*)&outgoingData, sizeof(outgoingData))) {
+    enqueuePrint("Ack sent back to master\n");
   } else {
-    enqueuePrint("Failed to send ack");
+    enqueuePrint("Failed to send ack\n");
   }
 }
 
@@ -65,28 +42,18 @@ void setup() {
   Serial.begin(115200);
   delay(500);
 
-  // Create a print queue
-  printQueue = xQueueCreate(10, PRINT_BUFFER_SIZE);
-  if (printQueue == NULL) {
-    Serial.println("Failed to create print queue");
+  // Shared print queue, drained by the print task (core 0)
+  if (!printQueueBegin(0)) {
+    Serial.println("Failed to start print queue");
     while (1);
   }
 
-  // Start printing task
-  xTaskCreatePinnedToCore(printTask, "Print Task", 4096, NULL, 1, NULL, 0);
-
-  WiFi.mode(WIFI_STA);
-  WiFi.disconnect();
-
-  if (esp_now_init() != ESP_OK) {
-    enqueuePrint("Error initializing ESP-NOW");
+  if (!halRadioBegin(OnDataRecv)) {
+    enqueuePrint("Error initializing ESP-NOW\n");
     while (1);
   }
 
-  // Register receive callback
-  esp_now_register_recv_cb(OnDataRecv);
-
-  // Register peer (the master)
+  // Register peer (the master) here, the ack path never allocates
   esp_now_peer_info_t peerInfo = {};
   memcpy(peerInfo.peer_addr, masterMAC, 6);
   peerInfo.channel = 0;
@@ -94,11 +61,11 @@ void setup() {
 
   if (!esp_now_is_peer_exist(masterMAC)) {
     if (esp_now_add_peer(&peerInfo) != ESP_OK) {
-      enqueuePrint("Failed to add master peer");
+      enqueuePrint("Failed to add master peer\n");
     }
   }
 
-  enqueuePrint("Slave ready. Waiting for data...");
+  enqueuePrint("Slave ready. Waiting for data...\n");
 }
 
 void loop() {
@@ -0,0 +1,143 @@
+/* Sound Band Analyzer Tests
+ *
+ * Native (pio test -e native): the fixed-point kernels and the trigger/machine split
+ * on synthetic 12-bit blocks with a known tone, amplitude and bias.
+ */
+
+/* Includes */
+#include <math.h>
+#include <string.h>
+#include <unity.h>
+#include "sound_bands.h"
+
+/* Constants */
+constexpr uint16_t TEST_BIAS = 2048;
+
+// As the Chef: tones it listens to and the machine noise it rejects
+const sound_tone testTones[] = {
+  {  500, TONE_TRIGGER }, {  750, TONE_TRIGGER }, { 1500, TONE_TRIGGER }, { 2500, TONE_TRIGGER },
+  { 1000, TONE_MACHINE }, { 2000, TONE_MACHINE },
+};
+
+/* Statics */
+static uint16_t block[SOUND_BLOCK_SIZE];
+static int16_t re[SOUND_BLOCK_SIZE];
+static int16_t im[SOUND_BLOCK_SIZE];
+
+/* Private Function Definitions */
+// FUNCTION: Bias plus up to two tones, amplitudes in ADC counts
+static void fillBlock(float hzA, float ampA, float hzB = 0.0f, float ampB = 0.0f) {
+  for (uint16_t n = 0; n < SOUND_BLOCK_SIZE; ++n) {
+    float t = (float)n / SOUND_SAMPLE_RATE_HZ;
+    float v = TEST_BIAS + ampA * sinf(2.0f * (float)M_PI * hzA * t) + ampB * sinf(2.0f * (float)M_PI * hzB * t);
+    block[n] = (uint16_t)lroundf(v);
+  }
+}
+
+static void fillTone(int16_t* x, float hz, float amp) {
+  for (uint16_t n = 0; n < SOUND_BLOCK_SIZE; ++n) {
+    x[n] = (int16_t)lroundf(amp * cosf(2.0f * (float)M_PI * hz * n / SOUND_SAMPLE_RATE_HZ));
+  }
+}
+
+/* Public Function Definitions */
+void setUp() {
+  soundBandsInit(testTones, sizeof(testTones) / sizeof(testTones[0]));
+}
+
+void tearDown() { }
+
+void test_isqrt64_exact_and_floor() {
+  TEST_ASSERT_EQUAL_UINT32(0, isqrt64(0));
+  TEST_ASSERT_EQUAL_UINT32(1, isqrt64(1));
+  TEST_ASSERT_EQUAL_UINT32(1, isqrt64(3));
+  TEST_ASSERT_EQUAL_UINT32(2, isqrt64(4));
+  TEST_ASSERT_EQUAL_UINT32(65535, isqrt64(65536ULL * 65536ULL - 1));
+  TEST_ASSERT_EQUAL_UINT32(65536, isqrt64(65536ULL * 65536ULL));
+  TEST_ASSERT_EQUAL_UINT32(3037000499UL, isqrt64(3037000499ULL * 3037000499ULL));
+  TEST_ASSERT_EQUAL_UINT32(4294967295UL, isqrt64(UINT64_MAX));
+}
+
+// A cosine of amplitude A on the bin gives |X| = N * A / 2
+void test_goertzel_known_tone_power() {
+  const float amp = 1000.0f;
+  fillTone(re, 1000.0f, amp);
+  uint64_t on = goertzelPower(re, SOUND_BLOCK_SIZE, goertzelCoeffQ14(1000, SOUND_SAMPLE_RATE_HZ));
+  uint64_t off = goertzelPower(re, SOUND_BLOCK_SIZE, goertzelCoeffQ14(2000, SOUND_SAMPLE_RATE_HZ));
+  float expected = SOUND_BLOCK_SIZE * amp / 2.0f;
+  TEST_ASSERT_FLOAT_WITHIN(expected * 0.02f, expected, (float)isqrt64(on));
+  TEST_ASSERT_LESS_THAN(on / 1000, off);
+}
+
+// Output is DFT / N: a cosine of amplitude A on bin k shows A/2 at k and at N - k
+void test_fft_bin_placement() {
+  const uint16_t bin = 16;   // 1000 Hz at 8 kHz, 128 points
+  fillTone(re, (float)bin * SOUND_SAMPLE_RATE_HZ / SOUND_BLOCK_SIZE, 8000.0f);
+  memset(im, 0, sizeof(im));
+  fftRadix2Q15(re, im, SOUND_BLOCK_LOG2);
+
+  uint16_t peak = 0;
+  uint32_t peakMag = 0;
+  for (uint16_t k = 0; k < SOUND_BLOCK_SIZE / 2; ++k) {
+    uint32_t mag = isqrt64((uint64_t)((int32_t)re[k] * re[k]) + (uint64_t)((int32_t)im[k] * im[k]));
+    if (mag > peakMag) { peakMag = mag; peak = k; }
+  }
+  TEST_ASSERT_EQUAL_UINT16(bin, peak);
+  TEST_ASSERT_INT_WITHIN(40, 4000, peakMag);
+  TEST_ASSERT_INT_WITHIN(40, 4000, re[SOUND_BLOCK_SIZE - bin]);
+  TEST_ASSERT_INT_WITHIN(4, 0, re[bin + 4]);
+}
+
+void test_process_removes_bias() {
+  fillBlock(750.0f, 0.0f);
+  sound_bands_result r;
+  soundBandsProcess(block, SOUND_BLOCK_SIZE, &r);
+  TEST_ASSERT_EQUAL_UINT16(TEST_BIAS, r.dcLevel);
+  TEST_ASSERT_LESS_OR_EQUAL(1, r.triggerLevel);
+  TEST_ASSERT_LESS_OR_EQUAL(1, r.machineLevel);
+}
+
+void test_process_short_block_bias() {
+  fillBlock(750.0f, 0.0f);
+  sound_bands_result r;
+  soundBandsProcess(block, SOUND_BLOCK_SIZE / 2, &r);
+  TEST_ASSERT_EQUAL_UINT16(TEST_BIAS, r.dcLevel);
+  TEST_ASSERT_LESS_OR_EQUAL(1, r.triggerLevel);
+}
+
+void test_process_trigger_tone() {
+  fillBlock(750.0f, 300.0f);
+  sound_bands_result r;
+  soundBandsProcess(block, SOUND_BLOCK_SIZE, &r);
+  TEST_ASSERT_INT_WITHIN(30, 300, r.triggerLevel);
+  TEST_ASSERT_LESS_THAN(30, r.machineLevel);
+}
+
+void test_process_machine_tone_rejected() {
+  fillBlock(1000.0f, 300.0f);
+  sound_bands_result r;
+  soundBandsProcess(block, SOUND_BLOCK_SIZE, &r);
+  TEST_ASSERT_INT_WITHIN(30, 300, r.machineLevel);
+  TEST_ASSERT_LESS_THAN(30, r.triggerLevel);
+}
+
+void test_process_split_with_both() {
+  fillBlock(1500.0f, 200.0f, 2000.0f, 400.0f);
+  sound_bands_result r;
+  soundBandsProcess(block, SOUND_BLOCK_SIZE, &r);
+  TEST_ASSERT_INT_WITHIN(30, 200, r.triggerLevel);
+  TEST_ASSERT_INT_WITHIN(40, 400, r.machineLevel);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_isqrt64_exact_and_floor);
+  RUN_TEST(test_goertzel_known_tone_power);
+  RUN_TEST(test_fft_bin_placement);
+  RUN_TEST(test_process_removes_bias);
+  RUN_TEST(test_process_short_block_bias);
+  RUN_TEST(test_process_trigger_tone);
+  RUN_TEST(test_process_machine_tone_rejected);
+  RUN_TEST(test_process_split_with_both);
+  return UNITY_END();
+}
@@ -0,0 +1,144 @@
+/* Station Link Tests
+ *
+ * Native (pio test -e native): the Chef's side of the servo link against the lib/Hal
+ * fakes. The tests play the station, answering on the fake radio.
+ */
+
+/* Includes */
+#include <string.h>
+#include <unity.h>
+#include "hal.h"
+#include "servo_link.h"
+#include "station_link.h"
+
+/* Constants */
+const uint8_t stationMac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+/* Statics */
+static station_link stationLink;
+static link_cmd lastCmd;
+static uint32_t cmdsOnAir = 0;
+static uint16_t doneSeq = 0;
+static uint8_t doneStatus = 0;
+static uint32_t doneCalls = 0;
+
+/* Private Function Definitions */
+static void onAir(const uint8_t* dst, const uint8_t* data, int len) {
+  if (memcmp(dst, stationMac, 6) != 0 || !linkIsCmd(data, len)) return;
+  memcpy(&lastCmd, data, sizeof(lastCmd));
+  cmdsOnAir++;
+}
+
+static void onDone(uint16_t seq, uint8_t status, void* arg) {
+  doneSeq = seq;
+  doneStatus = status;
+  doneCalls++;
+}
+
+static void reply(uint8_t op, uint16_t seq, uint8_t servos, uint8_t status = LINK_OK) {
+  link_report report = {};
+  report.magic = LINK_MAGIC;
+  report.op = op;
+  report.seq = seq;
+  report.servos = servos;
+  report.status = status;
+  report.sentUs = lastCmd.sentUs;
+  TEST_ASSERT_TRUE(stationOnRecv(&stationLink, stationMac, (const uint8_t*)&report, sizeof(report)));
+}
+
+/* Public Function Definitions */
+void setUp() {
+  halFakeRadioSetTx(onAir);
+  stationInit(&stationLink);
+  cmdsOnAir = 0;
+  doneCalls = 0;
+  doneSeq = 0;
+}
+
+void tearDown() { }
+
+void test_ping_completes_on_ack() {
+  uint16_t seq = stationSend(&stationLink, stationMac, LINK_OP_PING, LINK_SERVO_TOP, 0, onDone);
+  TEST_ASSERT_NOT_EQUAL(0, seq);
+  TEST_ASSERT_EQUAL_UINT32(1, cmdsOnAir);
+  TEST_ASSERT_EQUAL_UINT16(seq, lastCmd.seq);
+  TEST_ASSERT_TRUE(stationBusy(&stationLink, seq));
+
+  reply(LINK_OP_ACK, seq, LINK_SERVO_TOP);
+  TEST_ASSERT_FALSE(stationBusy(&stationLink, seq));
+  TEST_ASSERT_EQUAL_UINT32(1, doneCalls);
+  TEST_ASSERT_EQUAL_UINT16(seq, doneSeq);
+  TEST_ASSERT_EQUAL_UINT8(LINK_OK, doneStatus);
+}
+
+void test_move_waits_for_every_done() {
+  uint16_t seq = stationSend(&stationLink, stationMac, LINK_OP_OPEN, LINK_SERVO_TOP | LINK_SERVO_BOTTOM, 0, onDone);
+  reply(LINK_OP_ACK, seq, LINK_SERVO_TOP | LINK_SERVO_BOTTOM);
+  TEST_ASSERT_TRUE(stationBusy(&stationLink, seq));
+  reply(LINK_OP_DONE, seq, LINK_SERVO_TOP);
+  TEST_ASSERT_EQUAL_UINT32(0, doneCalls);
+  reply(LINK_OP_DONE, seq, LINK_SERVO_BOTTOM, LINK_STOPPED);
+  TEST_ASSERT_EQUAL_UINT32(1, doneCalls);
+  TEST_ASSERT_EQUAL_UINT8(LINK_STOPPED, doneStatus);   // First failure is the command's
+  TEST_ASSERT_FALSE(stationBusy(&stationLink, seq));
+}
+
+// The ACK got lost and the resend's ACK comes in after the move finished
+void test_done_before_ack() {
+  uint16_t seq = stationSend(&stationLink, stationMac, LINK_OP_OPEN, LINK_SERVO_TOP | LINK_SERVO_BOTTOM, 0, onDone);
+  reply(LINK_OP_DONE, seq, LINK_SERVO_TOP, LINK_STOPPED);
+  reply(LINK_OP_DONE, seq, LINK_SERVO_BOTTOM);
+  TEST_ASSERT_EQUAL_UINT32(0, doneCalls);
+  TEST_ASSERT_TRUE(stationBusy(&stationLink, seq));
+  reply(LINK_OP_ACK, seq, LINK_SERVO_TOP | LINK_SERVO_BOTTOM);
+  TEST_ASSERT_EQUAL_UINT32(1, doneCalls);
+  TEST_ASSERT_EQUAL_UINT8(LINK_STOPPED, doneStatus);
+  TEST_ASSERT_FALSE(stationBusy(&stationLink, seq));
+}
+
+void test_resends_same_seq_then_times_out() {
+  uint16_t seq = stationSend(&stationLink, stationMac, LINK_OP_CLOSE, LINK_SERVO_TOP, 0, onDone);
+  for (uint8_t i = 1; i < LINK_MAX_TRIES; ++i) {
+    halDelayMs(LINK_ACK_TIMEOUT_MS);
+    stationPoll(&stationLink);
+    TEST_ASSERT_EQUAL_UINT32(1 + i, cmdsOnAir);
+    TEST_ASSERT_EQUAL_UINT16(seq, lastCmd.seq);
+  }
+  halDelayMs(LINK_ACK_TIMEOUT_MS);
+  stationPoll(&stationLink);
+  TEST_ASSERT_EQUAL_UINT32(LINK_MAX_TRIES, cmdsOnAir);
+  TEST_ASSERT_EQUAL_UINT32(1, doneCalls);
+  TEST_ASSERT_EQUAL_UINT8(LINK_TIMEOUT, doneStatus);
+
+  station_stats st;
+  stationStats(&stationLink, &st);
+  TEST_ASSERT_EQUAL_UINT32(LINK_MAX_TRIES - 1, st.resends);
+  TEST_ASSERT_EQUAL_UINT32(1, st.timeouts);
+}
+
+void test_in_flight_limit() {
+  for (uint8_t i = 0; i < LINK_MAX_PENDING; ++i) {
+    TEST_ASSERT_NOT_EQUAL(0, stationSend(&stationLink, stationMac, LINK_OP_PING, LINK_SERVO_TOP, 0));
+  }
+  TEST_ASSERT_EQUAL(0, stationSend(&stationLink, stationMac, LINK_OP_PING, LINK_SERVO_TOP, 0));
+}
+
+void test_foreign_packets_ignored() {
+  uint8_t text[sizeof(link_report)] = { 'H', 'e', 'l', 'l', 'o' };
+  TEST_ASSERT_FALSE(stationOnRecv(&stationLink, stationMac, text, sizeof(text)));
+  uint16_t seq = stationSend(&stationLink, stationMac, LINK_OP_PING, LINK_SERVO_TOP, 0, onDone);
+  reply(LINK_OP_ACK, (uint16_t)(seq + 100), LINK_SERVO_TOP);   // Not ours
+  TEST_ASSERT_TRUE(stationBusy(&stationLink, seq));
+  TEST_ASSERT_EQUAL_UINT32(0, doneCalls);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_ping_completes_on_ack);
+  RUN_TEST(test_move_waits_for_every_done);
+  RUN_TEST(test_done_before_ack);
+  RUN_TEST(test_resends_same_seq_then_times_out);
+  RUN_TEST(test_in_flight_limit);
+  RUN_TEST(test_foreign_packets_ignored);
+  return UNITY_END();
+}
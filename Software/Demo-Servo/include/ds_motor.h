@@ -4,22 +4,23 @@
 #define DS_MOTOR_H
 
 /* Includes */
+#include "servo_motion.h"
 
 /* Constants */
 // -----------------------------
-// DS positional presets (per pin)
+// DS positional presets (per pin), calibration defaults
 // -----------------------------
 constexpr uint8_t TOP_BUN_CLOSED     = 170;  // OUT1_PIN
 constexpr uint8_t TOP_BUN_OPEN       = 80;   // OUT1_PIN
 constexpr uint8_t BOTTOM_BUN_CLOSED  = 90;   // OUT2_PIN
 constexpr uint8_t BOTTOM_BUN_OPEN    = 0;    // OUT2_PIN
-constexpr uint16_t DS_BOUNCE_MOVE_MS = 500;  // time to hold each target
+constexpr uint16_t DS_SETTLE_MS      = 80;   // servo catching up with the setpoint
 
 /* Public Function Definitions */
-uint8_t dsClosedAngleForPin(uint8_t pin);
-uint8_t dsOpenAngleForPin(uint8_t pin);
-void driveDsServoAngle(uint8_t pin, int angleDeg);
-void dsHoldAngle(uint8_t pin, int angleDeg, uint16_t holdMs);
-void dsBounce(uint8_t pin, uint16_t pauseMs);
+uint16_t dsClosedUsForPin(uint8_t pin);
+uint16_t dsOpenUsForPin(uint8_t pin);
+bool dsHoldUs(uint8_t pin, uint16_t us, uint16_t holdMs, motion_done_cb cb = NULL, void* arg = NULL);
+bool dsHoldAngle(uint8_t pin, int angleDeg, uint16_t holdMs, motion_done_cb cb = NULL, void* arg = NULL);
+bool dsBounce(uint8_t pin, uint16_t pauseMs, motion_done_cb cb = NULL, void* arg = NULL);
 
 #endif // DS_MOTOR_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+/* Servo Calibration Store Header */
+#ifndef SERVO_CAL_H
+#define SERVO_CAL_H
+
+/* Includes */
+#include <Arduino.h>
+#include "servo_util.h"
+
+/* Constants */
+// -----------------------------
+// NVS store, one blob per pin
+// -----------------------------
+constexpr const char* SERVO_CAL_NAMESPACE = "servo_cal";
+constexpr uint8_t     SERVO_CAL_VERSION   = 1;   // Bump when servo_cal changes layout
+
+// -----------------------------
+// Endpoint search: stall current on the servo supply shunt
+// -----------------------------
+constexpr uint8_t  CAL_SENSE_PIN      = 35;    // ADC1, shunt amplifier output
+constexpr uint8_t  CAL_SENSE_SAMPLES  = 16;
+constexpr uint32_t CAL_STALL_MV       = 60;    // Rise over the idle reading that counts as stalled
+constexpr uint8_t  CAL_STALL_STEPS    = 3;     // Consecutive stalled steps to accept an endpoint
+constexpr uint16_t CAL_STEP_US        = 10;
+constexpr uint16_t CAL_STEP_MS        = 60;    // Move one step and let the current settle
+constexpr uint16_t CAL_MARGIN_US      = 20;    // Back off from the mechanical stop
+constexpr uint16_t CAL_REST_MS        = 500;
+
+// -----------------------------
+// Neutral search: no motion on the feedback signal
+// -----------------------------
+constexpr uint16_t CAL_NEUTRAL_SPAN_US = 60;   // Search neutral +- this
+constexpr uint16_t CAL_NEUTRAL_STEP_US = 2;
+constexpr uint16_t CAL_NEUTRAL_STEP_MS = 120;
+constexpr int32_t  CAL_STILL_DEG10     = 2;    // Angle change that still counts as stopped
+
+/* Typedefs */
+// Per-channel calibration, flat table indexed by LEDC slot
+typedef struct servo_cal {
+  uint8_t  version;
+  uint8_t  pin;
+  uint16_t minUs;        // Usable pulse range (positional: 0 and 180 deg)
+  uint16_t maxUs;
+  uint16_t neutralUs;    // Rest / stop pulse
+  uint16_t deadbandUs;   // Continuous: +- around neutral without motion
+  uint16_t openUs;       // Station presets
+  uint16_t closedUs;
+} servo_cal;
+
+/* Externs */
+extern servo_cal servoCalTable[SERVO_MAX_CHANNELS];
+
+/* Public Function Definitions */
+bool     servoCalBegin();
+void     servoCalLoad(uint8_t slot, const servo_cal* defaults);
+bool     servoCalSave(uint8_t slot);
+void     servoCalReset(uint8_t slot);   // Back to the model defaults, erase from NVS
+int      servoCalSlotForPin(uint8_t pin);
+uint16_t servoCalAngleToUs(uint8_t slot, int angleDeg);
+bool     servoCalAutoEndpoints(uint8_t slot, bool* lowFound, bool* highFound);
+bool     servoCalAutoNeutral(uint8_t slot, int32_t (*readAngleDeg10)());
+
+#endif // SERVO_CAL_H
@@ -0,0 +1,132 @@
+/* Servo Driver Layer Header */
+#ifndef SERVO_DRIVER_H
+#define SERVO_DRIVER_H
+
+/* Includes */
+#include <Arduino.h>
+#include "servo_util.h"
+#include "servo_motion.h"
+#include "servo_models.h"
+#include "servo_cal.h"
+
+/* Typedefs */
+// -----------------------------
+// CRTP base: model traits, pin and LEDC slot are template parameters, so every
+// call resolves at compile time (no virtuals, no pin lookup) and the output is
+// one duty register write. Pulse limits come from the slot's calibration entry,
+// a direct index into the flat table. Derived supplies outUs(), backUs(),
+// restUs() and bounceProfile for the shared bounce.
+// -----------------------------
+template <typename Derived, typename Traits, uint8_t Pin, uint8_t Slot>
+class ServoDriver {
+  static_assert(Slot < SERVO_MAX_CHANNELS, "Servo slot out of range");
+  static_assert(Traits::minUs >= SERVO_CLAMP_MIN_US && Traits::maxUs <= SERVO_CLAMP_MAX_US,
+                "Model pulse range outside the hard limits");
+
+ public:
+  using traits = Traits;
+  static constexpr uint8_t pin     = Pin;
+  static constexpr uint8_t channel = SERVO_LEDC_FIRST_CHANNEL + Slot;
+
+  static const servo_cal& cal() { return servoCalTable[Slot]; }
+
+  static uint16_t clampUs(uint16_t us) {
+    return (us < cal().minUs) ? cal().minUs : ((us > cal().maxUs) ? cal().maxUs : us);
+  }
+
+  // Load the calibration (model defaults if none stored), claim the fixed channel
+  // and register with the motion manager, at rest
+  static bool begin(uint16_t openUs = Traits::minUs, uint16_t closedUs = Traits::maxUs) {
+    const servo_cal defaults = {
+      SERVO_CAL_VERSION, Pin, Traits::minUs, Traits::maxUs, Traits::neutralUs, Traits::deadbandUs,
+      openUs, closedUs
+    };
+    servoCalLoad(Slot, &defaults);
+    if (!servoAttachSlot(Pin, Slot)) return false;
+    if (!motionAddChannel(Pin, Derived::restUs())) return false;
+    motionSetLimits(Pin, &Traits::limits);
+    return true;
+  }
+
+  // Immediate pulse, drops anything queued on this servo. Motion state and register
+  // change together, at the slot's own channel.
+  static void writeUs(uint16_t us) {
+    motionWriteSlot(Slot, clampUs(us));
+  }
+
+  // Queued: profiled move within the model limits, then hold for holdMs
+  static bool moveUs(uint16_t us, traj_profile profile, uint16_t holdMs,
+                     motion_done_cb cb = NULL, void* arg = NULL) {
+    return motionMoveProfile(Pin, clampUs(us), profile, holdMs, cb, arg);
+  }
+
+  // Queued: out for outMs, rest for pauseMs, back for outMs, end at rest
+  static bool bounce(uint16_t outMs, uint16_t pauseMs, motion_done_cb cb = NULL, void* arg = NULL) {
+    constexpr traj_profile p = Derived::bounceProfile;
+    return moveUs(Derived::outUs(),  p, outMs) &&
+           moveUs(Derived::restUs(), p, pauseMs) &&
+           moveUs(Derived::backUs(), p, outMs) &&
+           moveUs(Derived::restUs(), p, 0, cb, arg);
+  }
+
+  static bool     saveCal() { return servoCalSave(Slot); }
+  static void     stop()  { motionStop(Pin); }
+  static bool     busy()  { return motionBusy(Pin); }
+  static uint32_t etaMs() { return motionEtaMs(Pin); }
+};
+
+// -----------------------------
+// Positional: angle maps onto the model's pulse range, bounce sweeps end to end
+// -----------------------------
+template <typename Traits, uint8_t Pin, uint8_t Slot>
+class PositionalServo : public ServoDriver<PositionalServo<Traits, Pin, Slot>, Traits, Pin, Slot> {
+  static_assert(!Traits::continuous, "PositionalServo needs a positional model");
+  using Base = ServoDriver<PositionalServo<Traits, Pin, Slot>, Traits, Pin, Slot>;
+
+ public:
+  static constexpr traj_profile bounceProfile = TRAJ_SCURVE;
+
+  // Uncalibrated mapping, for compile-time presets
+  static constexpr uint16_t modelAngleToUs(int deg) {
+    return Traits::minUs + static_cast<uint16_t>(
+      (static_cast<uint32_t>((deg < 0) ? 0 : ((deg > Traits::rangeDeg) ? Traits::rangeDeg : deg)) *
+       (Traits::maxUs - Traits::minUs)) / Traits::rangeDeg);
+  }
+  static uint16_t angleToUs(int deg) { return servoCalAngleToUs(Slot, deg); }
+  static uint16_t outUs()    { return Base::cal().minUs; }
+  static uint16_t backUs()   { return Base::cal().maxUs; }
+  static uint16_t restUs()   { return Base::cal().neutralUs; }
+  static uint16_t openUs()   { return Base::cal().openUs; }
+  static uint16_t closedUs() { return Base::cal().closedUs; }
+
+  static void writeAngle(int deg) { Base::writeUs(angleToUs(deg)); }
+  static bool moveAngle(int deg, uint16_t holdMs, motion_done_cb cb = NULL, void* arg = NULL) {
+    return Base::moveUs(angleToUs(deg), TRAJ_SCURVE, holdMs, cb, arg);
+  }
+};
+
+// -----------------------------
+// Continuous: fixed speed either way, bounce runs out and back for a number of frames
+// -----------------------------
+template <typename Traits, uint8_t Pin, uint8_t Slot>
+class ContinuousServo : public ServoDriver<ContinuousServo<Traits, Pin, Slot>, Traits, Pin, Slot> {
+  static_assert(Traits::continuous, "ContinuousServo needs a continuous model");
+  using Base = ServoDriver<ContinuousServo<Traits, Pin, Slot>, Traits, Pin, Slot>;
+
+ public:
+  static constexpr traj_profile bounceProfile = TRAJ_STEP;
+
+  // Speeds keep the model's offset from the calibrated neutral
+  static uint16_t outUs()  { return Base::cal().neutralUs + Traits::forwardUs - Traits::neutralUs; }
+  static uint16_t backUs() { return Base::cal().neutralUs + Traits::reverseUs - Traits::neutralUs; }
+  static uint16_t restUs() { return Base::cal().neutralUs; }
+
+  static void forward() { Base::writeUs(outUs()); }
+  static void reverse() { Base::writeUs(backUs()); }
+  static void halt()    { Base::writeUs(restUs()); }
+  static bool bounceFrames(uint16_t frames, motion_done_cb cb = NULL, void* arg = NULL) {
+    return Base::bounce(frames * SERVO_FRAME_MS, 0, cb, arg);
+  }
+};
+
+#endif // SERVO_DRIVER_H
@@ -0,0 +1,65 @@
+/* Servo Feedback Loop Header */
+#ifndef SERVO_FEEDBACK_H
+#define SERVO_FEEDBACK_H
+
+/* Includes */
+#include <Arduino.h>
+#include "servo_util.h"
+#include "servo_motion.h"
+#include "servo_cal.h"
+
+/* Constants */
+// -----------------------------
+// Feedback capture (Parallax Feedback 360: ~910 Hz PWM, duty 2.9..97.1 % = 0..359 deg)
+// -----------------------------
+constexpr uint8_t  FB1_PIN                = 32;     // Parallax yellow feedback wire
+constexpr uint32_t FB_DUTY_MIN_Q16        = 1900;   // 2.9 %
+constexpr uint32_t FB_DUTY_MAX_Q16        = 63635;  // 97.1 %
+constexpr uint32_t FB_STALE_US            = 5000;   // No edge for this long: sensor lost
+
+// -----------------------------
+// Angle loop (angles in 0.1 deg, multi-turn)
+// -----------------------------
+constexpr uint16_t FB_LOOP_MS             = SERVO_FRAME_MS;  // One correction per pulse frame
+constexpr int8_t   FB_DIRECTION           = -1;     // Pulse below neutral (forward) raises the angle, flip if the loop runs away
+constexpr int32_t  FB_KP_Q8               = 384;    // 1.5 us per deg
+constexpr int32_t  FB_KI_Q8               = 26;     // 0.1 us per deg per frame
+constexpr int32_t  FB_KD_Q8               = 128;    // 0.5 us per deg/frame
+constexpr int32_t  FB_TOLERANCE_DEG10     = 20;     // Settled within +-2 deg ...
+constexpr uint8_t  FB_SETTLE_FRAMES       = 3;      // ... for this many frames
+constexpr uint32_t FB_MOVE_TIMEOUT_MS     = 3000;
+
+/* Typedefs */
+// Output side of the loop; neutral, dead band and limits come from the slot's calibration
+typedef struct feedback_servo {
+  uint8_t pin;
+  uint8_t slot;
+} feedback_servo;
+
+typedef struct feedback_stats {
+  uint32_t moves;
+  uint32_t timeouts;
+  uint32_t sensorFaults;     // Feedback signal went stale, loop released
+  uint32_t lastSettleMs;     // Command to inside tolerance for FB_SETTLE_FRAMES
+  uint32_t maxSettleMs;
+  int32_t  lastOvershootDeg10;
+  int32_t  angleDeg10;
+} feedback_stats;
+
+/* Public Function Definitions */
+bool    feedbackBegin(uint8_t fbPin, const feedback_servo* servo);
+bool    feedbackMoveTo(int32_t targetDeg10, motion_done_cb cb = NULL, void* arg = NULL);
+bool    feedbackMoveBy(int32_t deltaDeg10, motion_done_cb cb = NULL, void* arg = NULL);
+void    feedbackRelease();   // Stop the loop and return the servo to the motion manager
+bool    feedbackActive();
+int32_t feedbackAngle();     // 0.1 deg, multi-turn
+void    feedbackStats(feedback_stats* out);
+
+// Bind the loop to a ContinuousServo<> type
+template <typename Servo>
+bool feedbackBegin(uint8_t fbPin) {
+  static const feedback_servo servo = { Servo::pin, (uint8_t)(Servo::channel - SERVO_LEDC_FIRST_CHANNEL) };
+  return feedbackBegin(fbPin, &servo);
+}
+
+#endif // SERVO_FEEDBACK_H
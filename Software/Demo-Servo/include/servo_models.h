@@ -0,0 +1,58 @@
+/* Servo Model Traits Header */
+#ifndef SERVO_MODELS_H
+#define SERVO_MODELS_H
+
+/* Includes */
+#include <Arduino.h>
+#include "servo_util.h"
+#include "servo_trajectory.h"
+
+/* Typedefs */
+// -----------------------------
+// Per-model traits, all compile-time. Positional models map 0..rangeDeg onto
+// minUs..maxUs, continuous models run forwardUs/reverseUs and stop at neutralUs.
+// These are the defaults; the per-pin calibration (servo_cal.h) overrides them.
+// -----------------------------
+struct DsServoTraits {
+  static constexpr bool        continuous = false;
+  static constexpr uint16_t    minUs      = SERVO_MIN_US;
+  static constexpr uint16_t    maxUs      = SERVO_MAX_US;
+  static constexpr uint16_t    neutralUs  = SERVO_NEUTRAL_US;
+  static constexpr uint16_t    deadbandUs = 0;
+  static constexpr uint16_t    rangeDeg   = 180;
+  static constexpr traj_limits limits     = { 4000, 40000 };  // us/s, us/s^2 (~1000 us in 400 ms)
+};
+
+struct TowerProTraits {   // MG995
+  static constexpr bool        continuous = false;
+  static constexpr uint16_t    minUs      = SERVO_MIN_US;
+  static constexpr uint16_t    maxUs      = SERVO_MAX_US;
+  static constexpr uint16_t    neutralUs  = SERVO_NEUTRAL_US;
+  static constexpr uint16_t    deadbandUs = 0;
+  static constexpr uint16_t    rangeDeg   = 180;
+  static constexpr traj_limits limits     = { 3000, 30000 };  // ~0.2 s / 60 deg unloaded
+};
+
+struct DsContinuousTraits {
+  static constexpr bool        continuous = true;
+  static constexpr uint16_t    minUs      = 1000;
+  static constexpr uint16_t    maxUs      = 2000;
+  static constexpr uint16_t    neutralUs  = SERVO_NEUTRAL_US;
+  static constexpr uint16_t    forwardUs  = 1300;   // Right
+  static constexpr uint16_t    reverseUs  = 1700;   // Left
+  static constexpr uint16_t    deadbandUs = 10;     // +- around neutral without motion
+  static constexpr traj_limits limits     = { 8000, 80000 };
+};
+
+struct ParallaxTraits {   // Feedback 360, 1480..1520 is its dead band
+  static constexpr bool        continuous = true;
+  static constexpr uint16_t    minUs      = 1280;
+  static constexpr uint16_t    maxUs      = 1720;
+  static constexpr uint16_t    neutralUs  = SERVO_NEUTRAL_US;
+  static constexpr uint16_t    forwardUs  = 1300;   // Right
+  static constexpr uint16_t    reverseUs  = 1700;   // Left
+  static constexpr uint16_t    deadbandUs = 20;
+  static constexpr traj_limits limits     = { 8000, 80000 };
+};
+
+#endif // SERVO_MODELS_H
@@ -0,0 +1,43 @@
+/* Servo Motion Manager Header */
+#ifndef SERVO_MOTION_H
+#define SERVO_MOTION_H
+
+/* Includes */
+#include <Arduino.h>
+#include "servo_util.h"
+#include "servo_trajectory.h"
+
+/* Constants */
+// -----------------------------
+// Motion manager
+// -----------------------------
+constexpr uint8_t  MOTION_MAX_CHANNELS = SERVO_MAX_CHANNELS;
+constexpr uint8_t  MOTION_QUEUE_DEPTH  = 8;               // Pending moves per channel
+constexpr uint16_t MOTION_TICK_MS      = SERVO_FRAME_MS;  // One setpoint per servo frame
+
+/* Typedefs */
+// Runs in the motion tick context once a move has finished
+typedef void (*motion_done_cb)(uint8_t pin, void* arg);
+
+/* Public Function Definitions */
+bool motionBegin();
+bool motionAddChannel(uint8_t pin, uint16_t startUs);
+bool motionMoveUs(uint8_t pin, uint16_t targetUs, uint16_t durationMs,
+                  motion_done_cb cb = NULL, void* arg = NULL);
+bool motionMoveAngle(uint8_t pin, int angleDeg, uint16_t durationMs,
+                     motion_done_cb cb = NULL, void* arg = NULL);
+// Profiled move as fast as the channel limits allow, then hold for holdMs
+bool motionMoveProfile(uint8_t pin, uint16_t targetUs, traj_profile profile, uint16_t holdMs,
+                       motion_done_cb cb = NULL, void* arg = NULL);
+bool motionMoveProfileAngle(uint8_t pin, int angleDeg, traj_profile profile, uint16_t holdMs,
+                            motion_done_cb cb = NULL, void* arg = NULL);
+void motionSetLimits(uint8_t pin, const traj_limits* limits);
+uint32_t motionEtaMs(uint8_t pin);   // Predicted time until the channel's queue is done
+void motionStop(uint8_t pin);   // Drop queued moves, hold the current pulse
+void motionJump(uint8_t pin, uint16_t us);   // Stop, resync to a pulse written directly
+void motionWriteSlot(uint8_t slot, uint16_t us);   // Stop, resync and write the pulse, one critical section
+bool motionBusy(uint8_t pin);
+bool motionKick(uint8_t pin);   // Start a waiting move now instead of at the next tick
+void motionTick(uint32_t nowMs);
+
+#endif // SERVO_MOTION_H
@@ -4,6 +4,7 @@
 
 /* Includes */
 #include <Arduino.h>
+#include "servo_map.h"   // Pulse timing, LEDC duty and angle math
 
 /* Defines */
 
@@ -13,16 +14,16 @@
 constexpr uint8_t LED_PIN  = 2;
 constexpr uint8_t OUT1_PIN = 13;   // Primary servo output
 constexpr uint8_t OUT2_PIN = 14;   // Secondary (DS dual-servo use)
-
-// -----------------------------
-// Servo timing constants
-// -----------------------------
-constexpr uint16_t SERVO_FRAME_MS   = 20;    // Typical RC servo frame
-constexpr uint16_t SERVO_NEUTRAL_US = 1500;  // Neutral for continuous
-constexpr uint16_t SERVO_MIN_US     = 500;   // Positional min pulse
-constexpr uint16_t SERVO_MAX_US     = 2500;  // Positional max pulse
+constexpr uint8_t OUT3_PIN = 25;   // Station extras (mixed models)
+constexpr uint8_t OUT4_PIN = 26;
+constexpr uint8_t OUT5_PIN = 27;
 
 /* Public Function Definitions */
+bool servoAttach(uint8_t pin);
+bool servoAttachSlot(uint8_t pin, uint8_t slot);   // Fixed channel: SERVO_LEDC_FIRST_CHANNEL + slot
+int  servoChannel(uint8_t pin);                    // LEDC channel, -1 if not attached
+void servoDetach(uint8_t pin);
+void servoWriteUs(uint8_t pin, uint16_t highUs);
 void servoOneFrameWriteUs(uint8_t pin, uint16_t highUs);
 
-#endif // SERVO_UTILS_H
\ No newline at end of file
+#endif // SERVO_UTILS_H
@@ -6,6 +6,7 @@
 /* Includes */
 #include <WiFi.h>
 #include <esp_now.h>
+#include "servo_remote.h"
 
 /* Defines */
 #define WIFI_SLAVE_TASK (1U)
@@ -18,8 +19,10 @@ typedef struct struct_message {
   int value;
 } struct_message;
 
+/* Globals */
+extern servo_remote stationRemote;    // Chef commands, run from the remote task
+
 /* Public Functions Declarations */
-void enqueuePrint(const char* fmt, ...);
 void startSlave();
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,50 @@
+/* Command Shell Header */
+#ifndef CMD_SHELL_H
+#define CMD_SHELL_H
+
+/* Includes */
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+/* Constants */
+// -----------------------------
+// Line assembly (UART event task) and dispatch (caller's task), no heap
+// -----------------------------
+constexpr uint8_t SHELL_LINE_MAX    = 64;   // Including the terminator
+constexpr uint8_t SHELL_QUEUE_DEPTH = 4;    // Completed lines waiting for shellPoll()
+constexpr uint8_t SHELL_MAX_ARGS    = 6;
+
+/* Typedefs */
+// argv[0] is the command word, tokens point into the shell's line buffer
+typedef void (*shell_handler)(int argc, char** argv);
+
+typedef struct shell_cmd {
+  const char*   name;     // Matched case-insensitively
+  const char*   usage;
+  shell_handler fn;
+} shell_cmd;
+
+typedef struct shell_stats {
+  uint32_t lines;
+  uint32_t overflows;     // Lines longer than SHELL_LINE_MAX, dropped
+  uint32_t queueFull;     // Lines dropped because shellPoll() fell behind
+} shell_stats;
+
+/* Public Function Definitions */
+#ifdef ARDUINO
+bool  shellBegin(HardwareSerial& port);
+char* shellGetLine();     // Next completed line (trimmed) or NULL, valid until the next call
+bool  shellPoll(const shell_cmd* table, uint8_t count, shell_handler fallback = NULL);
+void  shellHelp(const shell_cmd* table, uint8_t count);
+void  shellStats(shell_stats* out);
+#endif
+
+// Parsing helpers, in place (cmd_shell_parse.cpp, no Arduino needed)
+bool  shellDispatch(char* line, const shell_cmd* table, uint8_t count, shell_handler fallback);   // False: unknown, no fallback
+int   shellTokenize(char* line, char** argv, uint8_t maxArgs);
+char* shellJoin(int argc, char** argv);   // Undo tokenizing: argv[0..] back to one string
+bool  shellParseInt(const char* s, long* out);
+
+#endif // CMD_SHELL_H
@@ -0,0 +1,117 @@
+/* HAL ESP32 Driver */
+#ifdef ARDUINO
+
+/* Includes */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_heap_caps.h>
+#include "hal.h"
+
+/* Statics */
+static uint32_t heapAllocs = 0;
+static uint32_t heapMark = 0;
+static size_t heapMarkBlocks = 0;
+
+/* Private Function Definitions */
+// FUNCTION: Linker wraps (-Wl,--wrap=malloc etc.), every caller in the image that
+// links against newlib's allocator comes through here. Any task or core, any time.
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t size);
+
+void* __wrap_malloc(size_t size) {
+  __atomic_fetch_add(&heapAllocs, 1, __ATOMIC_RELAXED);
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+  __atomic_fetch_add(&heapAllocs, 1, __ATOMIC_RELAXED);
+  return __real_calloc(n, size);
+}
+
+void* __wrap_realloc(void* p, size_t size) {
+  __atomic_fetch_add(&heapAllocs, 1, __ATOMIC_RELAXED);
+  return __real_realloc(p, size);
+}
+}
+
+// FUNCTION: Blocks held in every heap a plain malloc can land in, whoever allocated them
+static size_t heapBlocks() {
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_DEFAULT);
+  return info.allocated_blocks;
+}
+
+/* Public Function Definitions */
+bool halTimerCreate(hal_timer_fn fn, void* arg, const char* name, hal_timer* out) {
+  esp_timer_create_args_t args = {};
+  args.callback = fn;
+  args.arg = arg;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = name;
+  return esp_timer_create(&args, out) == ESP_OK;
+}
+
+// FUNCTION: Station mode, no access point, ESP-NOW on the current channel
+bool halRadioBegin(hal_radio_rx_fn rx) {
+  WiFi.mode(WIFI_STA);
+  WiFi.disconnect();
+  if (esp_now_init() != ESP_OK) return false;
+  return esp_now_register_recv_cb(rx) == ESP_OK;
+}
+
+bool halRadioSend(const uint8_t* mac, const uint8_t* data, int len) {
+  if (!esp_now_is_peer_exist(mac)) {
+    esp_now_peer_info_t peerInfo = {};
+    memcpy(peerInfo.peer_addr, mac, 6);
+    peerInfo.channel = 0;
+    peerInfo.encrypt = false;
+    if (esp_now_add_peer(&peerInfo) != ESP_OK) return false;
+  }
+  return esp_now_send(mac, data, len) == ESP_OK;
+}
+
+void halRadioMac(uint8_t* mac) {
+  WiFi.macAddress(mac);
+}
+
+bool halTaskStart(hal_task_fn fn, void* arg, const char* name, hal_task_mem* mem, uint8_t priority, int8_t core, hal_task* out) {
+  BaseType_t coreId = (core < 0) ? tskNO_AFFINITY : core;
+  *out = xTaskCreateStaticPinnedToCore(fn, name, mem->stackBytes, arg, priority, mem->stack, &mem->tcb, coreId);
+  return *out != NULL;
+}
+
+void IRAM_ATTR halTaskNotifyFromIsr(hal_task task) {
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(task, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+bool halQueueInit(hal_queue* q, void* storage, uint16_t itemSize, uint16_t depth) {
+  q->handle = xQueueCreateStatic(depth, itemSize, (uint8_t*)storage, &q->buf);
+  return q->handle != NULL;
+}
+
+void halPrintf(const char* fmt, ...) {
+  char line[HAL_PRINTF_MAX];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+  Serial.print(line);
+}
+
+uint32_t halHeapAllocs()      { return __atomic_load_n(&heapAllocs, __ATOMIC_RELAXED); }
+uint32_t halHeapSinceMark()   { return halHeapAllocs() - heapMark; }
+int32_t  halHeapBlocksSinceMark() { return (int32_t)(heapBlocks() - heapMarkBlocks); }
+
+void halHeapMark() {
+  heapMark = halHeapAllocs();
+  heapMarkBlocks = heapBlocks();
+}
+
+#endif // ARDUINO
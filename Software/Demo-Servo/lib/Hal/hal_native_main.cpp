@@ -0,0 +1,33 @@
+/* HAL Native Runner */
+#ifndef ARDUINO
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include "hal.h"
+
+void setup();
+void loop();
+
+/* Statics */
+static char stdoutBuf[BUFSIZ];
+
+// FUNCTION: setup() once, then loop() on the virtual clock. Only linked when the
+// program brings no main() of its own. Argument: simulated run time in ms.
+// Ends with the heap check: loop() and everything it drives should not allocate.
+int main(int argc, char** argv) {
+  uint64_t runUs = (uint64_t)((argc > 1) ? strtoul(argv[1], NULL, 10) : HAL_NATIVE_RUN_MS) * 1000;
+  setvbuf(stdout, stdoutBuf, _IOLBF, sizeof(stdoutBuf));   // Else libc mallocs one on the first print
+  setup();
+  halHeapMark();
+  while (!halFakeStopped() && halFakeNowUs() < runUs) {
+    uint64_t before = halFakeNowUs();
+    loop();
+    if (halFakeNowUs() == before) halFakeAdvanceUs(HAL_NATIVE_LOOP_US);
+  }
+  fprintf(stderr, "Heap check: %lu allocations, %ld blocks held after setup()\n",
+          (unsigned long)halHeapSinceMark(), (long)halHeapBlocksSinceMark());
+  return 0;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,101 @@
+/* Micro Bench Driver */
+
+/* Includes */
+#include <stdio.h>
+#include <string.h>
+#include "hal.h"
+#include "micro_bench.h"
+
+/* Private Function Definitions */
+static void emptyCall(uint32_t i) { }
+
+// FUNCTION: Best of BENCH_REPEATS, each the average over calls. Never inlined, so
+// every kernel pays the same call overhead the empty one measured.
+static __attribute__((noinline)) uint32_t measure(bench_fn fn, uint32_t calls) {
+  uint32_t best = UINT32_MAX;
+  for (uint8_t r = 0; r < BENCH_REPEATS; ++r) {
+    uint32_t start = halCycles();
+    for (uint32_t i = 0; i < calls; ++i) fn(i);
+    uint32_t perCall = (halCycles() - start) / calls;
+    if (perCall < best) best = perCall;
+  }
+  return best;
+}
+
+static void printLine(const char* fmt, const char* a, uint32_t b, uint32_t c, const char* d) {
+  char line[96];
+  snprintf(line, sizeof(line), fmt, a, (unsigned long)b, (unsigned long)c, d);
+  halPrint(line);
+}
+
+/* Public Function Definitions */
+void benchInit(bench_suite* s, const char* name) {
+  *s = bench_suite();
+  s->name = name;
+  s->mhz = halCpuMHz();
+  s->overhead = measure(emptyCall, 1000);
+}
+
+uint32_t benchRun(bench_suite* s, const char* name, bench_fn fn, uint32_t calls) {
+  uint32_t cycles = measure(fn, calls ? calls : 1);
+  cycles = (cycles > s->overhead) ? cycles - s->overhead : 0;
+  benchAdd(s, name, cycles, calls);
+  return cycles;
+}
+
+void benchAdd(bench_suite* s, const char* name, uint32_t cycles, uint32_t calls) {
+  if (s->count >= BENCH_MAX_RESULTS) return;
+  bench_result* r = &s->results[s->count++];
+  snprintf(r->name, sizeof(r->name), "%s", name);
+  r->cycles = cycles;
+  r->calls = calls;
+}
+
+const bench_result* benchFind(const bench_suite* s, const char* name) {
+  for (uint8_t i = 0; i < s->count; ++i) {
+    if (strcmp(s->results[i].name, name) == 0) return &s->results[i];
+  }
+  return NULL;
+}
+
+void benchPrintJson(const bench_suite* s) {
+#ifdef ARDUINO
+  const char* platform = "esp32";
+#else
+  const char* platform = "native";
+#endif
+  printLine("{\"suite\": \"%s\", \"mhz\": %lu, \"overhead\": %lu, \"platform\": \"%s\", \"results\": [\n",
+            s->name, s->mhz, s->overhead, platform);
+  for (uint8_t i = 0; i < s->count; ++i) {
+    const bench_result* r = &s->results[i];
+    printLine("  {\"name\": \"%s\", \"cycles\": %lu, \"calls\": %lu}%s\n",
+              r->name, r->cycles, r->calls, (i + 1 < s->count) ? "," : "");
+  }
+  halPrint("]}\n");
+}
+
+// FUNCTION: Small results move a few cycles either way, they need 2 more than the
+// percentage before they count as slower
+uint8_t benchCompare(const bench_suite* now, const bench_suite* base, uint8_t tolerancePct) {
+  uint8_t slower = 0;
+  char line[96];
+  snprintf(line, sizeof(line), "%-24s %10s %10s %8s\n", "kernel", "baseline", "now", "change");
+  halPrint(line);
+  for (uint8_t i = 0; i < now->count; ++i) {
+    const bench_result* r = &now->results[i];
+    const bench_result* b = benchFind(base, r->name);
+    if (!b) {
+      snprintf(line, sizeof(line), "%-24s %10s %10lu %8s\n", r->name, "-", (unsigned long)r->cycles, "new");
+      halPrint(line);
+      continue;
+    }
+    uint32_t limit = b->cycles + b->cycles * tolerancePct / 100 + 2;
+    bool bad = r->cycles > limit;
+    if (bad) slower++;
+    float change = b->cycles ? 100.0f * ((float)r->cycles - b->cycles) / b->cycles : 0.0f;
+    snprintf(line, sizeof(line), "%-24s %10lu %10lu %+7.1f%%%s\n", r->name, (unsigned long)b->cycles,
+             (unsigned long)r->cycles, change, bad ? "  SLOWER" : "");
+    halPrint(line);
+  }
+  return slower;
+}
@@ -0,0 +1,49 @@
+/* Micro Bench Native Files */
+#ifndef ARDUINO
+
+/* Includes */
+#include <stdio.h>
+#include <string.h>
+#include "micro_bench.h"
+
+/* Public Function Definitions */
+bool benchWriteJson(const bench_suite* s, const char* path) {
+  FILE* f = fopen(path, "w");
+  if (!f) return false;
+  fprintf(f, "{\"suite\": \"%s\", \"mhz\": %lu, \"overhead\": %lu, \"platform\": \"native\", \"results\": [\n",
+          s->name, (unsigned long)s->mhz, (unsigned long)s->overhead);
+  for (uint8_t i = 0; i < s->count; ++i) {
+    const bench_result* r = &s->results[i];
+    fprintf(f, "  {\"name\": \"%s\", \"cycles\": %lu, \"calls\": %lu}%s\n",
+            r->name, (unsigned long)r->cycles, (unsigned long)r->calls, (i + 1 < s->count) ? "," : "");
+  }
+  fprintf(f, "]}\n");
+  return fclose(f) == 0;
+}
+
+// FUNCTION: Picks the result lines out of whatever surrounds them, so a serial
+// monitor log from the board loads as it is
+bool benchLoadJson(bench_suite* s, const char* path) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  *s = bench_suite();
+  s->name = path;
+  char line[256];
+  while (fgets(line, sizeof(line), f)) {
+    unsigned long mhz;
+    const char* p = strstr(line, "\"mhz\": ");
+    if (p && sscanf(p, "\"mhz\": %lu", &mhz) == 1) s->mhz = (uint32_t)mhz;
+
+    p = strstr(line, "{\"name\": \"");
+    if (!p) continue;
+    char name[BENCH_NAME_MAX];
+    unsigned long cycles, calls;
+    if (sscanf(p, "{\"name\": \"%31[^\"]\", \"cycles\": %lu, \"calls\": %lu", name, &cycles, &calls) == 3) {
+      benchAdd(s, name, (uint32_t)cycles, (uint32_t)calls);
+    }
+  }
+  fclose(f);
+  return s->count > 0;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,77 @@
+/* Print Queue Driver */
+
+/* Includes */
+#include <stdio.h>
+#include <stdarg.h>
+#include "hal.h"
+#include "print_queue.h"
+
+/* Statics */
+static hal_queue queue;
+static uint8_t queueStorage[PRINT_QUEUE_DEPTH * PRINT_LINE_MAX];
+static bool queueReady = false;
+static hal_task printTask = NULL;
+static uint8_t printStack[PRINT_TASK_STACK];
+static hal_task_mem printTaskMem = HAL_TASK_MEM(printStack);
+
+static hal_lock statsLock = HAL_LOCK_INIT;
+static print_queue_stats stats;
+
+/* Private Function Definitions */
+// FUNCTION: Sleeps until a line is queued, prints everything waiting
+static void printTaskFn(void* arg) {
+  while (true) {
+    halTaskWait(HAL_WAIT_FOREVER);
+    printQueueService();
+  }
+}
+
+/* Public Function Definitions */
+bool printQueueInit() {
+  if (!queueReady) queueReady = halQueueInit(&queue, queueStorage, PRINT_LINE_MAX, PRINT_QUEUE_DEPTH);
+  return queueReady;
+}
+
+bool printQueueBegin(int8_t core) {
+  if (!printQueueInit()) return false;
+  if (printTask) return true;
+  return halTaskStart(printTaskFn, NULL, "Print Task", &printTaskMem, PRINT_TASK_PRIORITY, core, &printTask);
+}
+
+// FUNCTION: Format on the caller's stack, queue without waiting
+void enqueuePrint(const char* fmt, ...) {
+  char line[PRINT_LINE_MAX];
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+
+  bool queued = queueReady && halQueueSend(&queue, line);
+  halLock(&statsLock);
+  if (queued) stats.lines++;
+  else        stats.dropped++;
+  if (len >= (int)sizeof(line)) stats.truncated++;
+  halUnlock(&statsLock);
+  if (queued && printTask) halTaskNotify(printTask);
+}
+
+uint8_t printQueueService() {
+  char line[PRINT_LINE_MAX];
+  uint8_t count = 0;
+  while (queueReady && halQueueReceive(&queue, line)) {
+    halPrint(line);
+    count++;
+  }
+  return count;
+}
+
+void printQueueFlush() {
+  char line[PRINT_LINE_MAX];
+  while (queueReady && halQueueReceive(&queue, line)) { }
+}
+
+void printQueueStats(print_queue_stats* out) {
+  halLock(&statsLock);
+  *out = stats;
+  halUnlock(&statsLock);
+}
@@ -0,0 +1,85 @@
+/* Servo Link Header */
+#ifndef SERVO_LINK_H
+#define SERVO_LINK_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// ESP-NOW servo commands, Chef -> Demo-Servo station and reports back.
+// Shared by both projects, keep the copies identical.
+// -----------------------------
+constexpr uint8_t  LINK_MAGIC           = 0xA5;  // First byte, never a printable struct_message
+constexpr uint8_t  LINK_MAX_PENDING     = 8;     // Commands in flight per side
+constexpr uint16_t LINK_ACK_TIMEOUT_MS  = 40;    // Resend when the ACK is this late ...
+constexpr uint8_t  LINK_MAX_TRIES       = 3;     // ... up to this many sends
+constexpr uint16_t LINK_DONE_TIMEOUT_MS = 5000;  // Give up waiting for DONE
+
+// Servo selector bits, one per station output
+constexpr uint8_t LINK_SERVO_TOP        = 0x01;  // DS dropper, OUT1
+constexpr uint8_t LINK_SERVO_BOTTOM     = 0x02;  // DS dropper, OUT2
+constexpr uint8_t LINK_SERVO_TOWERPRO   = 0x04;  // OUT3
+constexpr uint8_t LINK_SERVO_CONTINUOUS = 0x08;  // OUT4
+constexpr uint8_t LINK_SERVO_PARALLAX   = 0x10;  // OUT5, closed loop
+constexpr uint8_t LINK_SERVO_ALL        = 0x1F;
+
+/* Typedefs */
+enum link_op : uint8_t {
+  LINK_OP_PING = 0,     // ACK only
+  LINK_OP_ANGLE,        // arg: degrees (Parallax: multi-turn absolute)
+  LINK_OP_OPEN,         // Calibrated open preset
+  LINK_OP_CLOSE,        // Calibrated closed preset
+  LINK_OP_BOUNCE,       // arg: pause in ms (continuous servos: frames)
+  LINK_OP_STOP,         // Drop queued moves, ACK only
+  LINK_OP_ACK  = 0x80,  // Station: command received, moves started
+  LINK_OP_DONE = 0x81,  // Station: one servo finished
+};
+
+enum link_status : uint8_t {
+  LINK_OK = 0,
+  LINK_BUSY,            // Motion queue full
+  LINK_BAD_SERVO,       // Not on this station, or the op makes no sense for it
+  LINK_BAD_OP,
+  LINK_NO_SIGNAL,       // Closed loop without feedback
+  LINK_STOPPED,         // DONE: move stopped or superseded before it finished
+};
+
+typedef struct __attribute__((packed)) link_cmd {
+  uint8_t  magic;
+  uint8_t  op;          // link_op
+  uint16_t seq;         // Resends keep the seq, the station runs it once
+  uint8_t  servos;      // LINK_SERVO_* mask
+  uint8_t  reserved;
+  int16_t  arg;
+  uint32_t sentUs;      // Sender clock, echoed back for the round trip
+} link_cmd;
+
+typedef struct __attribute__((packed)) link_report {
+  uint8_t  magic;
+  uint8_t  op;          // LINK_OP_ACK or LINK_OP_DONE
+  uint16_t seq;
+  uint8_t  servos;      // ACK: servos that started, DONE: the one that finished
+  uint8_t  status;      // ACK: first failure, if any
+  uint16_t reserved;
+  uint32_t sentUs;      // link_cmd::sentUs of the send being answered
+  uint32_t rxToStartUs; // Station: receive to first pulse change
+  uint32_t rxToDoneUs;  // Station: receive to finish (DONE only)
+  uint32_t stationMs;   // Station clock when the report left
+} link_report;
+
+/* Public Function Definitions */
+// Ops that move something answer with one DONE per started servo
+inline bool linkOpMoves(uint8_t op) {
+  return op == LINK_OP_ANGLE || op == LINK_OP_OPEN || op == LINK_OP_CLOSE || op == LINK_OP_BOUNCE;
+}
+
+inline bool linkIsCmd(const uint8_t* data, int len) {
+  return len == (int)sizeof(link_cmd) && data[0] == LINK_MAGIC;
+}
+
+inline bool linkIsReport(const uint8_t* data, int len) {
+  return len == (int)sizeof(link_report) && data[0] == LINK_MAGIC;
+}
+
+#endif // SERVO_LINK_H
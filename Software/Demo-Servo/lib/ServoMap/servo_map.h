@@ -0,0 +1,42 @@
+/* Servo Pulse Map Header */
+#ifndef SERVO_MAP_H
+#define SERVO_MAP_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Constants */
+// -----------------------------
+// Servo timing constants
+// -----------------------------
+constexpr uint16_t SERVO_FRAME_MS   = 20;    // Typical RC servo frame
+constexpr uint16_t SERVO_NEUTRAL_US = 1500;  // Neutral for continuous
+constexpr uint16_t SERVO_MIN_US     = 500;   // Positional min pulse
+constexpr uint16_t SERVO_MAX_US     = 2500;  // Positional max pulse
+constexpr uint16_t SERVO_CLAMP_MIN_US = 400;   // Hard pulse limits
+constexpr uint16_t SERVO_CLAMP_MAX_US = 2700;
+
+// -----------------------------
+// LEDC backend (hardware 50 Hz pulses)
+// -----------------------------
+constexpr uint8_t  SERVO_LEDC_FIRST_CHANNEL = 8;   // Low-speed group, clear of channel 0/1 users
+constexpr uint8_t  SERVO_MAX_CHANNELS       = 6;
+constexpr uint8_t  SERVO_LEDC_BITS          = 16;  // 20 ms / 65536 = 0.31 us per count
+constexpr uint32_t SERVO_LEDC_FREQ_HZ       = 1000 / SERVO_FRAME_MS;
+
+/* Public Function Definitions */
+// -----------------------------
+// The output path's math, no Arduino: the motion manager, the calibration table and
+// the native bench (src/Bench/) share it
+// -----------------------------
+// Pulse width to LEDC duty, constant-folds for compile-time pulses
+constexpr uint32_t servoUsToDuty(uint16_t highUs) {
+  return ((uint32_t)highUs << SERVO_LEDC_BITS) / (SERVO_FRAME_MS * 1000U);
+}
+
+// Angle, clamped to 0..180, onto a pulse range
+constexpr uint16_t servoMapAngle(int deg, uint16_t minUs, uint16_t maxUs) {
+  return minUs + (uint16_t)(((uint32_t)((deg < 0) ? 0 : ((deg > 180) ? 180 : deg)) * (maxUs - minUs)) / 180U);
+}
+
+#endif // SERVO_MAP_H
@@ -0,0 +1,249 @@
+/* Servo Remote Driver */
+
+/* Includes */
+#include <string.h>
+#include "hal.h"
+#include "servo_remote.h"
+
+/* Statics */
+static servo_remote* remotes[REMOTE_MAX_INSTANCES];
+static uint8_t remoteCount = 0;
+
+static_assert(LINK_MAX_PENDING <= 32, "doneMask holds one bit per pending slot");
+
+/* Private Function Definitions */
+static inline uint32_t nowUs() {
+  return halMicros();
+}
+
+static void sendReport(const uint8_t* mac, link_report* report) {
+  report->magic = LINK_MAGIC;
+  report->stationMs = halMillis();
+  halRadioSend(mac, (const uint8_t*)report, sizeof(*report));
+}
+
+// Callback argument: instance, pending slot and its generation
+static inline void* doneArg(servo_remote* r, uint8_t slot) {
+  return (void*)(uintptr_t)(slot | (r->pending[slot].gen << 8) | (r->id << 16));
+}
+
+// FUNCTION: Motion or feedback tick context, flag the slot and wake the remote task
+static void onRemoteDone(uint8_t pin, void* arg) {
+  servo_remote* r = remotes[((uintptr_t)arg >> 16) & 0xFF];
+  uint8_t slot = (uint8_t)((uintptr_t)arg & 0xFF);
+  halLock(&r->doneMux);
+  r->doneAtUs[slot] = nowUs();
+  r->doneGen[slot] = (uint8_t)((uintptr_t)arg >> 8);
+  r->doneMask |= (1UL << slot);
+  halUnlock(&r->doneMux);
+  halTaskNotify(r->task);
+}
+
+static void reportDone(servo_remote* r, uint8_t slot, uint32_t atUs, link_status status);
+
+// FUNCTION: Stored ACK for this sender's seq, NULL if the command hasn't run
+static remote_ack* findAck(servo_remote* r, const uint8_t* mac, uint16_t seq) {
+  for (uint8_t i = 0; i < r->ackCount; ++i) {
+    remote_ack* a = &r->acks[i];
+    if (a->report.seq == seq && memcmp(a->mac, mac, 6) == 0) return a;
+  }
+  return NULL;
+}
+
+static void storeAck(servo_remote* r, const uint8_t* mac, const link_report& ack) {
+  remote_ack* a = &r->acks[r->ackNext];
+  memcpy(a->mac, mac, 6);
+  a->report = ack;
+  r->ackNext = (r->ackNext + 1) % LINK_MAX_PENDING;
+  if (r->ackCount < LINK_MAX_PENDING) r->ackCount++;
+}
+
+// FUNCTION: Free slot, else reclaim one the sender has given up on (a move that was
+// stopped or superseded never calls back)
+static int allocPending(servo_remote* r, uint32_t rxUs) {
+  int oldest = -1;
+  for (uint8_t i = 0; i < LINK_MAX_PENDING; ++i) {
+    if (!r->pending[i].used) return i;
+    if (rxUs - r->pending[i].rxUs >= LINK_DONE_TIMEOUT_MS * 1000UL &&
+        (oldest < 0 || r->pending[i].rxUs - r->pending[oldest].rxUs > 0x80000000UL)) {
+      oldest = i;
+    }
+  }
+  if (oldest >= 0) reportDone(r, oldest, rxUs, LINK_STOPPED);
+  return oldest;
+}
+
+// FUNCTION: Queue every selected servo, kick its motion channel so the pulse changes
+// now rather than on the next tick, then ACK with the receive-to-start time
+static void runCommand(servo_remote* r, const remote_rx& rx) {
+  const link_cmd& cmd = rx.cmd;
+
+  // Resend of a command already run (our ACK got lost): answer again, don't move twice.
+  // Any of the sender's in-flight commands can be resent, not only the latest.
+  remote_ack* prev = findAck(r, rx.mac, cmd.seq);
+  if (prev) {
+    prev->report.sentUs = cmd.sentUs;
+    sendReport(rx.mac, &prev->report);
+    halLock(&r->statsMux);
+    r->stats.duplicates++;
+    halUnlock(&r->statsMux);
+    return;
+  }
+
+  link_report ack = {};
+  ack.op = LINK_OP_ACK;
+  ack.seq = cmd.seq;
+  ack.sentUs = cmd.sentUs;
+  uint32_t rejected = 0, dropped = 0;
+
+  for (uint8_t bit = 1; bit & LINK_SERVO_ALL; bit <<= 1) {
+    if (!(cmd.servos & bit)) continue;
+
+    int slot = -1;
+    if (linkOpMoves(cmd.op)) {
+      slot = allocPending(r, rx.rxUs);
+      if (slot < 0) {
+        if (ack.status == LINK_OK) ack.status = LINK_BUSY;
+        dropped++;
+        continue;
+      }
+      remote_pending& p = r->pending[slot];
+      p.used = true;
+      p.gen++;
+      memcpy(p.mac, rx.mac, 6);
+      p.seq = cmd.seq;
+      p.servo = bit;
+      p.sentUs = cmd.sentUs;
+      p.rxUs = rx.rxUs;
+      p.rxToStartUs = 0;
+    }
+
+    uint8_t pin = 0xFF;
+    link_status st = r->exec(cmd.op, bit, cmd.arg, (slot < 0) ? NULL : onRemoteDone,
+                             (slot < 0) ? NULL : doneArg(r, slot), &pin);
+    if (st != LINK_OK) {
+      if (slot >= 0) r->pending[slot].used = false;
+      if (ack.status == LINK_OK) ack.status = st;
+      rejected++;
+      continue;
+    }
+
+    // Stopped servos won't call back, close out what the sender is waiting on
+    if (cmd.op == LINK_OP_STOP) {
+      for (uint8_t i = 0; i < LINK_MAX_PENDING; ++i) {
+        if (r->pending[i].used && r->pending[i].servo == bit) reportDone(r, i, rx.rxUs, LINK_STOPPED);
+      }
+    }
+
+    if (pin != 0xFF && r->kick) r->kick(pin);
+    uint32_t rxToStart = nowUs() - rx.rxUs;
+    if (slot >= 0) r->pending[slot].rxToStartUs = rxToStart;
+    ack.servos |= bit;
+    if (rxToStart > ack.rxToStartUs) ack.rxToStartUs = rxToStart;
+
+    halLock(&r->statsMux);
+    r->stats.started++;
+    r->stats.lastRxToStartUs = rxToStart;
+    if (rxToStart > r->stats.maxRxToStartUs) r->stats.maxRxToStartUs = rxToStart;
+    r->sumRxToStartUs += rxToStart;
+    halUnlock(&r->statsMux);
+  }
+
+  sendReport(rx.mac, &ack);
+  storeAck(r, rx.mac, ack);
+
+  halLock(&r->statsMux);
+  r->stats.commands++;
+  r->stats.rejected += rejected;
+  r->stats.dropped += dropped;
+  halUnlock(&r->statsMux);
+}
+
+static void reportDone(servo_remote* r, uint8_t slot, uint32_t atUs, link_status status) {
+  remote_pending& p = r->pending[slot];
+  link_report done = {};
+  done.op = LINK_OP_DONE;
+  done.seq = p.seq;
+  done.servos = p.servo;
+  done.status = status;
+  done.sentUs = p.sentUs;
+  done.rxToStartUs = p.rxToStartUs;
+  done.rxToDoneUs = atUs - p.rxUs;
+  sendReport(p.mac, &done);
+  p.used = false;
+}
+
+// FUNCTION: Woken by the receive callback and by finished moves
+static void remoteTask(void* parameter) {
+  servo_remote* r = (servo_remote*)parameter;
+  while (true) {
+    halTaskWait(HAL_WAIT_FOREVER);
+    remoteService(r);
+  }
+}
+
+/* Public Function Definitions */
+bool remoteBegin(servo_remote* r, remote_exec_fn exec, remote_kick_fn kick) {
+  if (r->task) return true;
+  if (remoteCount >= REMOTE_MAX_INSTANCES) return false;
+  *r = servo_remote();
+  halLockInit(&r->doneMux);
+  halLockInit(&r->statsMux);
+  r->exec = exec;
+  r->kick = kick;
+  if (!halQueueInit(&r->rxQueue, r->rxQueueStorage, sizeof(remote_rx), REMOTE_QUEUE_DEPTH)) return false;
+  r->id = remoteCount;
+  remotes[remoteCount++] = r;
+  halTaskMemInit(&r->taskMem, r->taskStack, sizeof(r->taskStack));
+  return halTaskStart(remoteTask, r, "Remote Task", &r->taskMem, REMOTE_TASK_PRIORITY,
+                      REMOTE_TASK_CORE, &r->task);
+}
+
+void remoteService(servo_remote* r) {
+  // 1. Finished moves first, they free pending slots
+  uint32_t mask;
+  uint32_t atUs[LINK_MAX_PENDING];
+  uint8_t gen[LINK_MAX_PENDING];
+  halLock(&r->doneMux);
+  mask = r->doneMask;
+  r->doneMask = 0;
+  memcpy(atUs, r->doneAtUs, sizeof(atUs));
+  memcpy(gen, r->doneGen, sizeof(gen));
+  halUnlock(&r->doneMux);
+  for (uint8_t i = 0; i < LINK_MAX_PENDING; ++i) {
+    if ((mask & (1UL << i)) && r->pending[i].used && r->pending[i].gen == gen[i]) {
+      reportDone(r, i, atUs[i], LINK_OK);
+    }
+  }
+
+  // 2. New commands
+  remote_rx rx;
+  while (halQueueReceive(&r->rxQueue, &rx)) runCommand(r, rx);
+}
+
+// FUNCTION: Called from the ESP-NOW receive callback (WiFi task). Stamps the
+// receive time and hands the command over, returns false if it isn't a link packet.
+bool remoteOnRecv(servo_remote* r, const uint8_t* mac, const uint8_t* data, int len) {
+  if (!linkIsCmd(data, len)) return false;
+  if (!r->task) return true;
+
+  remote_rx rx;
+  rx.rxUs = nowUs();
+  memcpy(rx.mac, mac, 6);
+  memcpy(&rx.cmd, data, sizeof(rx.cmd));
+  if (halQueueSend(&r->rxQueue, &rx)) {
+    halTaskNotify(r->task);
+  } else {
+    halLock(&r->statsMux);
+    r->stats.dropped++;
+    halUnlock(&r->statsMux);
+  }
+  return true;
+}
+
+void remoteStats(servo_remote* r, remote_stats* out) {
+  halLock(&r->statsMux);
+  *out = r->stats;
+  out->avgRxToStartUs = r->stats.started ? (uint32_t)(r->sumRxToStartUs / r->stats.started) : 0;
+  halUnlock(&r->statsMux);
+}
@@ -0,0 +1,98 @@
+/* Servo Remote Header */
+#ifndef SERVO_REMOTE_H
+#define SERVO_REMOTE_H
+
+/* Includes */
+#include <stdint.h>
+#include "hal.h"
+#include "servo_link.h"
+
+/* Constants */
+// -----------------------------
+// Remote command task, runs the Chef's ESP-NOW commands on the motion queues.
+// Shared with Demo-Heater's line simulator, keep the copies identical.
+// -----------------------------
+constexpr uint8_t  REMOTE_QUEUE_DEPTH   = 8;
+constexpr uint8_t  REMOTE_TASK_PRIORITY = 3;     // Above loop() and the print task
+constexpr uint8_t  REMOTE_TASK_CORE     = 1;     // WiFi stack lives on core 0
+constexpr uint16_t REMOTE_TASK_STACK    = 3072;
+constexpr uint8_t  REMOTE_MAX_INSTANCES = 32;    // One on a station, a whole line in the simulator
+
+/* Typedefs */
+// Same shape as the motion layer's done callback, the station passes motion_done_cb here
+typedef void (*remote_done_fn)(uint8_t pin, void* arg);
+
+// Queue one servo's part of a command (never block). Fill *pin for the servo that
+// moves and pass cb/cbArg to the motion call so the station can report DONE.
+typedef link_status (*remote_exec_fn)(uint8_t op, uint8_t servo, int16_t arg,
+                                      remote_done_fn cb, void* cbArg, uint8_t* pin);
+// Start the move queued on pin now rather than on the next motion tick
+typedef bool (*remote_kick_fn)(uint8_t pin);
+
+typedef struct remote_stats {
+  uint32_t commands;
+  uint32_t duplicates;      // Resends of a command already run
+  uint32_t rejected;        // Servos refused by the exec function
+  uint32_t dropped;         // Queue or pending table full
+  uint32_t started;         // Servos started, rxToStart below is over these
+  uint32_t lastRxToStartUs;
+  uint32_t maxRxToStartUs;
+  uint32_t avgRxToStartUs;
+} remote_stats;
+
+typedef struct remote_rx {
+  uint8_t mac[6];
+  uint32_t rxUs;
+  link_cmd cmd;
+} remote_rx;
+
+// ACK of a command already run, answers its resends
+typedef struct remote_ack {
+  uint8_t mac[6];
+  link_report report;
+} remote_ack;
+
+// One started servo waiting for its DONE
+typedef struct remote_pending {
+  bool used;
+  uint8_t gen;              // Bumped on reuse, a late callback for the old move is ignored
+  uint8_t mac[6];
+  uint16_t seq;
+  uint8_t servo;
+  uint32_t sentUs;
+  uint32_t rxUs;
+  uint32_t rxToStartUs;
+} remote_pending;
+
+typedef struct servo_remote {
+  uint8_t id;               // Index in the done callback's instance table
+  remote_exec_fn exec;
+  remote_kick_fn kick;
+  hal_task task;
+  hal_task_mem taskMem;
+  uint8_t taskStack[REMOTE_TASK_STACK];
+  hal_queue rxQueue;
+  uint8_t rxQueueStorage[REMOTE_QUEUE_DEPTH * sizeof(remote_rx)];
+  // Owned by the remote task
+  remote_pending pending[LINK_MAX_PENDING];
+  remote_ack acks[LINK_MAX_PENDING];    // Ring of the last commands run, as many as can be in flight
+  uint8_t ackNext;
+  uint8_t ackCount;
+  // Set from the motion/feedback tick, never lost: one bit per pending slot
+  hal_lock doneMux;
+  uint32_t doneMask;
+  uint32_t doneAtUs[LINK_MAX_PENDING];
+  uint8_t doneGen[LINK_MAX_PENDING];
+  hal_lock statsMux;
+  remote_stats stats;
+  uint64_t sumRxToStartUs;
+} servo_remote;
+
+/* Public Function Definitions */
+bool remoteBegin(servo_remote* r, remote_exec_fn exec, remote_kick_fn kick);
+// One wake of the remote task: finished moves, then new commands. Natively the host calls it.
+void remoteService(servo_remote* r);
+bool remoteOnRecv(servo_remote* r, const uint8_t* mac, const uint8_t* data, int len);   // ESP-NOW receive callback
+void remoteStats(servo_remote* r, remote_stats* out);
+
+#endif // SERVO_REMOTE_H
@@ -0,0 +1,109 @@
+/* Servo Trajectory Driver */
+
+/* Includes */
+#include "servo_trajectory.h"
+
+/* Private Function Definitions */
+static uint32_t isqrt64(uint64_t v) {
+  uint64_t res = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > v) bit >>= 2;
+  while (bit) {
+    if (v >= res + bit) {
+      v -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint32_t>(res);
+}
+
+// Fraction of the ramp distance x2 covered at u (Q16), result Q16, f(1) = 0.5
+static uint32_t rampFractionQ16(traj_profile profile, uint32_t uQ16) {
+  uint64_t u2 = (static_cast<uint64_t>(uQ16) * uQ16) >> 16;
+  if (profile == TRAJ_SCURVE) {
+    // integral of 3u^2 - 2u^3 = u^3 - u^4 / 2
+    uint64_t u3 = (u2 * uQ16) >> 16;
+    uint64_t u4 = (u3 * uQ16) >> 16;
+    return static_cast<uint32_t>(u3 - u4 / 2);
+  }
+  // integral of u = u^2 / 2
+  return static_cast<uint32_t>(u2 / 2);
+}
+
+/* Public Function Definitions */
+
+// FUNCTION: Plan a move; linearMs is only used by TRAJ_LINEAR
+void trajPlan(traj_state* s, traj_profile profile, uint16_t fromUs, uint16_t toUs,
+              const traj_limits* lim, uint32_t linearMs) {
+  s->fromUs = fromUs;
+  s->distUs = static_cast<int32_t>(toUs) - static_cast<int32_t>(fromUs);
+  s->profile = profile;
+  s->rampMs = 0;
+  s->cruiseMs = 0;
+  s->rampDistUs = 0;
+
+  const uint32_t dist = (s->distUs < 0) ? -s->distUs : s->distUs;
+  if (dist == 0 || profile == TRAJ_STEP || !lim || !lim->maxVelUsPerS || !lim->maxAccUsPerS2) {
+    s->profile = (profile == TRAJ_LINEAR) ? TRAJ_LINEAR : TRAJ_STEP;
+    s->totalMs = (profile == TRAJ_LINEAR) ? linearMs : 0;
+    return;
+  }
+  if (profile == TRAJ_LINEAR) {
+    s->totalMs = linearMs;
+    return;
+  }
+
+  // Ramp time ta = k * V / A, k = 1 (trapezoid) or 3/2 (smoothstep peak accel is 1.5x)
+  const uint32_t kNum = (profile == TRAJ_SCURVE) ? 3 : 1;
+  const uint32_t kDen = (profile == TRAJ_SCURVE) ? 2 : 1;
+  uint64_t vel = lim->maxVelUsPerS;
+  const uint64_t acc = lim->maxAccUsPerS2;
+
+  // Both ramps cover V * ta = k V^2 / A; without room to cruise, lower the peak velocity
+  if (kNum * vel * vel > static_cast<uint64_t>(dist) * acc * kDen) {
+    vel = isqrt64((static_cast<uint64_t>(dist) * acc * kDen) / kNum);
+    if (vel == 0) vel = 1;
+  }
+
+  uint32_t rampMs = static_cast<uint32_t>((kNum * vel * 1000ULL + kDen * acc - 1) / (kDen * acc));
+  if (rampMs == 0) rampMs = 1;
+  uint32_t rampDist = static_cast<uint32_t>((vel * rampMs) / 2000ULL);
+  if (rampDist * 2 > dist) rampDist = dist / 2;
+  const uint32_t cruiseDist = dist - 2 * rampDist;
+
+  s->rampMs = rampMs;
+  s->rampDistUs = static_cast<int32_t>(rampDist);
+  s->cruiseMs = static_cast<uint32_t>((cruiseDist * 1000ULL + vel - 1) / vel);
+  s->totalMs = 2 * rampMs + s->cruiseMs;
+}
+
+// FUNCTION: Pulse width setpoint at tMs after the move started
+uint16_t trajSample(const traj_state* s, uint32_t tMs) {
+  if (tMs >= s->totalMs || s->profile == TRAJ_STEP) {
+    return static_cast<uint16_t>(s->fromUs + s->distUs);
+  }
+
+  int32_t done;   // Unsigned distance covered
+  const int32_t dist = (s->distUs < 0) ? -s->distUs : s->distUs;
+  if (s->profile == TRAJ_LINEAR) {
+    done = static_cast<int32_t>((static_cast<int64_t>(dist) * tMs) / s->totalMs);
+  } else if (tMs < s->rampMs) {
+    uint32_t u = static_cast<uint32_t>((static_cast<uint64_t>(tMs) << 16) / s->rampMs);
+    done = static_cast<int32_t>((2ULL * s->rampDistUs * rampFractionQ16(s->profile, u)) >> 16);
+  } else if (tMs < s->rampMs + s->cruiseMs) {
+    const int32_t cruiseDist = dist - 2 * s->rampDistUs;
+    done = s->rampDistUs + static_cast<int32_t>((static_cast<int64_t>(cruiseDist) * (tMs - s->rampMs)) / s->cruiseMs);
+  } else {
+    uint32_t u = static_cast<uint32_t>((static_cast<uint64_t>(s->totalMs - tMs) << 16) / s->rampMs);
+    done = dist - static_cast<int32_t>((2ULL * s->rampDistUs * rampFractionQ16(s->profile, u)) >> 16);
+  }
+
+  return static_cast<uint16_t>(s->fromUs + ((s->distUs < 0) ? -done : done));
+}
+
+uint32_t trajDurationMs(const traj_state* s) {
+  return s->totalMs;
+}
@@ -0,0 +1,39 @@
+/* Servo Trajectory Header */
+#ifndef SERVO_TRAJECTORY_H
+#define SERVO_TRAJECTORY_H
+
+/* Includes */
+#include <stdint.h>
+
+/* Typedefs */
+// Shared with Demo-Heater's line simulator, keep the copies identical.
+enum traj_profile : uint8_t {
+  TRAJ_STEP,        // Jump to the target
+  TRAJ_LINEAR,      // Constant velocity over a given duration
+  TRAJ_TRAPEZOID,   // Velocity and acceleration limited
+  TRAJ_SCURVE,      // As trapezoid, smoothstep velocity ramps (finite jerk)
+};
+
+typedef struct traj_limits {
+  uint32_t maxVelUsPerS;    // Pulse width slew, us per second
+  uint32_t maxAccUsPerS2;   // Pulse width acceleration, us per second^2
+} traj_limits;
+
+// Planned move, sampled with integer math only
+typedef struct traj_state {
+  int32_t  fromUs;
+  int32_t  distUs;          // Signed distance
+  uint32_t rampMs;          // Duration of each ramp (0 for step/linear)
+  uint32_t cruiseMs;
+  uint32_t totalMs;
+  int32_t  rampDistUs;      // Unsigned distance covered by one ramp
+  traj_profile profile;
+} traj_state;
+
+/* Public Function Definitions */
+void     trajPlan(traj_state* s, traj_profile profile, uint16_t fromUs, uint16_t toUs,
+                  const traj_limits* lim, uint32_t linearMs);
+uint16_t trajSample(const traj_state* s, uint32_t tMs);
+uint32_t trajDurationMs(const traj_state* s);
+
+#endif // SERVO_TRAJECTORY_H
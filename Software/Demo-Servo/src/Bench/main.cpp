@@ -0,0 +1,185 @@
+/* Station Bench
+ *
+ * Cycles per call of the station's output path, angle to pulse to duty register, and
+ * of the motion manager's per-channel tick, plus what one 20 ms motion tick costs in
+ * all. On the board (pio run -e bench) setup() runs the suite once and prints the
+ * results as JSON; capture the serial monitor to a file. Natively (pio run -e
+ * native_bench) it runs the same suite and writes the results file itself:
+ *
+ *   station_bench                           bench_results.json
+ *   station_bench -b bench_baseline.json    ... and compare, exit 1 if anything got slower
+ *   station_bench -c board.log -b base.json compare a board capture, run nothing
+ *
+ *   -o <file>   Results file
+ *   -t <pct>    Tolerance before a kernel counts as slower (BENCH_TOLERANCE_PCT)
+ *
+ * Baselines are per platform: keep one per board build and one per build machine.
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#ifndef ARDUINO
+#include <unistd.h>
+#endif
+#include "hal.h"
+#include "micro_bench.h"
+#include "servo_map.h"
+#include "servo_trajectory.h"
+
+/* Constants */
+constexpr uint32_t BENCH_CALLS          = 1000;
+constexpr uint8_t  BENCH_SERVOS         = 5;        // As the station: two droppers, MG995, two continuous
+constexpr uint8_t  BENCH_SLOT           = 1;        // Bottom dropper
+constexpr uint8_t  BENCH_CHANNEL        = SERVO_LEDC_FIRST_CHANNEL + BENCH_SLOT;
+
+// As DsServoTraits (servo_models.h)
+constexpr traj_limits BENCH_TRAJ_LIMITS = { 4000, 40000 };
+
+/* Typedefs */
+// The part of servo_cal the output path reads, flat and indexed by slot as servoCalTable
+typedef struct bench_cal {
+  uint16_t minUs;
+  uint16_t maxUs;
+} bench_cal;
+
+/* Statics */
+static bench_suite suite;
+static bench_cal calTable[SERVO_MAX_CHANNELS];
+static traj_state traj;
+static volatile uint16_t pulseIn = 1500;   // Runtime pulse, keeps servoUsToDuty from folding
+static volatile uint32_t sink;
+
+#ifndef ARDUINO
+static const char* outPath = "bench_results.json";
+static const char* basePath = NULL;
+static const char* capturePath = NULL;
+static uint8_t tolerancePct = BENCH_TOLERANCE_PCT;
+#endif
+
+/* Private Function Definitions */
+// -----------------------------
+// Kernels, i is the call number. Angles run -10..189 so the clamp is taken both ways.
+// -----------------------------
+// motionMoveAngle(): nominal range
+static void benchAngleToUs(uint32_t i) {
+  sink += servoMapAngle((int)(i % 200) - 10, SERVO_MIN_US, SERVO_MAX_US);
+}
+
+// PositionalServo::angleToUs(), servoCalAngleToUs(): the slot's calibrated range
+static void benchCalAngleToUs(uint32_t i) {
+  const bench_cal& c = calTable[BENCH_SLOT];
+  sink += servoMapAngle((int)(i % 200) - 10, c.minUs, c.maxUs);
+}
+
+static void benchUsToDuty(uint32_t i) {
+  sink += servoUsToDuty((uint16_t)(pulseIn + (i & 0x3FF)));
+}
+
+// PositionalServo::writeAngle() up to the register: calibrated pulse, duty, LEDC write
+static void benchWriteAngle(uint32_t i) {
+  const bench_cal& c = calTable[BENCH_SLOT];
+  halPwmWrite(BENCH_CHANNEL, servoUsToDuty(servoMapAngle((int)(i % 181), c.minUs, c.maxUs)));
+}
+
+static void benchTrajPlan(uint32_t i) {
+  trajPlan(&traj, TRAJ_SCURVE, 1000, (uint16_t)(1500 + (i & 0x3FF)), &BENCH_TRAJ_LIMITS, 0);
+}
+
+static void benchTrajSample(uint32_t i) {
+  sink += trajSample(&traj, i % (trajDurationMs(&traj) + 1));
+}
+
+// motionTick() for one moving channel: sample, duty, LEDC write
+static void benchMotionChannel(uint32_t i) {
+  uint16_t us = trajSample(&traj, (i * SERVO_FRAME_MS) % (trajDurationMs(&traj) + 1));
+  halPwmWrite(BENCH_CHANNEL, servoUsToDuty(us));
+}
+
+static uint32_t resultCycles(const char* name) {
+  const bench_result* r = benchFind(&suite, name);
+  return r ? r->cycles : 0;
+}
+
+// FUNCTION: One motion tick with every servo moving and one of them starting a move
+static void addTick() {
+  uint32_t tick = resultCycles("motion_channel") * BENCH_SERVOS + resultCycles("traj_plan");
+  benchAdd(&suite, "tick_20ms", tick, 1);
+  uint32_t pct100 = (uint32_t)((uint64_t)tick * 10000 / ((uint64_t)suite.mhz * SERVO_FRAME_MS * 1000U));
+  char line[96];
+  snprintf(line, sizeof(line), "tick_20ms %lu cycles, %lu us at %lu MHz, %lu.%02lu%% of the tick\n",
+           (unsigned long)tick, (unsigned long)(tick / suite.mhz), (unsigned long)suite.mhz,
+           (unsigned long)(pct100 / 100), (unsigned long)(pct100 % 100));
+  halPrint(line);
+}
+
+static void runSuite() {
+  // Output state as the running station would have it: a calibrated slot, its channel set up
+  for (uint8_t s = 0; s < SERVO_MAX_CHANNELS; ++s) calTable[s] = { SERVO_MIN_US, SERVO_MAX_US };
+  calTable[BENCH_SLOT] = { 620, 2380 };
+  halPwmSetup(BENCH_CHANNEL, SERVO_LEDC_FREQ_HZ, SERVO_LEDC_BITS);
+  benchTrajPlan(0);
+
+  benchInit(&suite, "station");
+  benchRun(&suite, "angle_to_us", benchAngleToUs, BENCH_CALLS);
+  benchRun(&suite, "cal_angle_to_us", benchCalAngleToUs, BENCH_CALLS);
+  benchRun(&suite, "us_to_duty", benchUsToDuty, BENCH_CALLS);
+  benchRun(&suite, "write_angle", benchWriteAngle, BENCH_CALLS);
+  benchRun(&suite, "traj_plan", benchTrajPlan, BENCH_CALLS);
+  benchRun(&suite, "traj_sample", benchTrajSample, BENCH_CALLS);
+  benchRun(&suite, "motion_channel", benchMotionChannel, BENCH_CALLS);
+  addTick();
+}
+
+/* Public Function Definitions */
+#ifdef ARDUINO
+void setup() {
+  halConsoleBegin(115200);
+  halDelayMs(2000);   // Time to open the monitor
+  runSuite();
+  benchPrintJson(&suite);
+}
+
+void loop() {
+  halDelayMs(1000);
+}
+#else
+int main(int argc, char** argv) {
+  int opt;
+  while ((opt = getopt(argc, argv, "o:b:c:t:")) != -1) {
+    switch (opt) {
+      case 'o': outPath = optarg; break;
+      case 'b': basePath = optarg; break;
+      case 'c': capturePath = optarg; break;
+      case 't': tolerancePct = (uint8_t)atoi(optarg); break;
+      default:
+        fprintf(stderr, "station_bench [-o results.json] [-b baseline.json] [-c board.log] [-t pct]\n");
+        return 2;
+    }
+  }
+
+  if (capturePath) {
+    if (!basePath || !benchLoadJson(&suite, capturePath)) {
+      fprintf(stderr, "-c needs a capture with results and a baseline (-b)\n");
+      return 2;
+    }
+  } else {
+    runSuite();
+    if (!benchWriteJson(&suite, outPath)) {
+      fprintf(stderr, "Cannot write %s\n", outPath);
+      return 2;
+    }
+    printf("%u results in %s\n", suite.count, outPath);
+  }
+
+  if (!basePath) return 0;
+  bench_suite base;
+  if (!benchLoadJson(&base, basePath)) {
+    fprintf(stderr, "No results in %s\n", basePath);
+    return 2;
+  }
+  uint8_t slower = benchCompare(&suite, &base, tolerancePct);
+  printf("%u of %u slower than %s by more than %u%%\n", slower, suite.count, basePath, tolerancePct);
+  return slower ? 1 : 0;
+}
+#endif
@@ -0,0 +1,139 @@
+/* Station Host Build
+ *
+ * Host build (pio run -e native): the station's remote command path against the fakes
+ * in lib/Hal, on the virtual clock. A stand-in Chef opens and closes both droppers,
+ * the stand-in servos take as long as their planned S-curve and report back.
+ *
+ *   station_host          10 s simulated
+ *   station_host <ms>     that long
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal.h"
+#include "servo_link.h"
+#include "servo_remote.h"
+#include "servo_trajectory.h"
+
+/* Constants */
+constexpr uint32_t HOST_CMD_MS        = 500;     // A command this often ...
+constexpr uint8_t  HOST_RESEND_EVERY  = 10;      // ... and every 10th sent twice, as after a lost ACK
+constexpr uint8_t  HOST_SERVOS        = 2;       // Top and bottom dropper
+constexpr uint16_t HOST_OPEN_US       = 2000;
+constexpr uint16_t HOST_CLOSE_US      = 1000;
+constexpr traj_limits HOST_LIMITS     = { 4000, 40000 };
+
+const uint8_t chefMac[6]    = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+const uint8_t stationMac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+/* Typedefs */
+typedef struct host_servo {
+  uint8_t pin;
+  uint16_t us;
+  hal_timer timer;
+  remote_done_fn cb;
+  void* cbArg;
+} host_servo;
+
+/* Statics */
+static servo_remote remote;
+static host_servo servos[HOST_SERVOS] = { { 25, HOST_CLOSE_US, NULL, NULL, NULL }, { 26, HOST_CLOSE_US, NULL, NULL, NULL } };
+static uint16_t seq = 0;
+static uint32_t acks = 0, dones = 0, rttSumUs = 0, maxDoneUs = 0;
+
+/* Private Function Definitions */
+// FUNCTION: Stand-in servo reached its target
+static void onServoDone(void* arg) {
+  host_servo* s = (host_servo*)arg;
+  if (s->cb) s->cb(s->pin, s->cbArg);
+}
+
+// FUNCTION: Stand-in motion layer, the move takes its planned S-curve duration
+static link_status hostExec(uint8_t op, uint8_t servo, int16_t arg,
+                            remote_done_fn cb, void* cbArg, uint8_t* pin) {
+  if (servo != LINK_SERVO_TOP && servo != LINK_SERVO_BOTTOM) return LINK_BAD_SERVO;
+  host_servo* s = &servos[servo == LINK_SERVO_TOP ? 0 : 1];
+  if (op == LINK_OP_PING) return LINK_OK;
+  if (op != LINK_OP_OPEN && op != LINK_OP_CLOSE) return LINK_BAD_OP;
+
+  uint16_t toUs = (op == LINK_OP_OPEN) ? HOST_OPEN_US : HOST_CLOSE_US;
+  traj_state traj;
+  trajPlan(&traj, TRAJ_SCURVE, s->us, toUs, &HOST_LIMITS, 0);
+  s->us = toUs;
+  s->cb = cb;
+  s->cbArg = cbArg;
+  halTimerStop(s->timer);
+  halTimerStartOnce(s->timer, trajDurationMs(&traj) * 1000 + 1);
+  *pin = s->pin;
+  return LINK_OK;
+}
+
+static bool hostKick(uint8_t pin) { return true; }
+
+// FUNCTION: Whatever the station puts on the air, the Chef's side of it
+static void onAir(const uint8_t* dst, const uint8_t* data, int len) {
+  if (memcmp(dst, chefMac, 6) != 0 || !linkIsReport(data, len)) return;
+  link_report report;
+  memcpy(&report, data, sizeof(report));
+  if (report.op == LINK_OP_ACK) {
+    acks++;
+    rttSumUs += halMicros() - report.sentUs;
+  } else if (report.op == LINK_OP_DONE) {
+    dones++;
+    if (report.rxToDoneUs > maxDoneUs) maxDoneUs = report.rxToDoneUs;
+  }
+}
+
+static void onRecv(const uint8_t* mac, const uint8_t* data, int len) {
+  remoteOnRecv(&remote, mac, data, len);
+}
+
+static void sendCmd(uint8_t op) {
+  link_cmd cmd = {};
+  cmd.magic = LINK_MAGIC;
+  cmd.op = op;
+  cmd.seq = ++seq;
+  cmd.servos = LINK_SERVO_TOP | LINK_SERVO_BOTTOM;
+  cmd.sentUs = halMicros();
+  halFakeRadioRx(chefMac, (const uint8_t*)&cmd, sizeof(cmd));
+  if (seq % HOST_RESEND_EVERY == 0) halFakeRadioRx(chefMac, (const uint8_t*)&cmd, sizeof(cmd));
+}
+
+static void printSummary() {
+  remote_stats st;
+  remoteStats(&remote, &st);
+  printf("%lu ms simulated\n", (unsigned long)halMillis());
+  printf("Station: %lu commands, %lu duplicates, %lu started, %lu rejected, %lu dropped, rx to start %lu us max\n",
+         (unsigned long)st.commands, (unsigned long)st.duplicates, (unsigned long)st.started,
+         (unsigned long)st.rejected, (unsigned long)st.dropped, (unsigned long)st.maxRxToStartUs);
+  printf("Chef: %lu acks, %lu dones, RTT %lu us, rx to done %lu us max\n",
+         (unsigned long)acks, (unsigned long)dones,
+         (unsigned long)(acks ? rttSumUs / acks : 0), (unsigned long)maxDoneUs);
+}
+
+/* Public Function Definitions */
+void setup() {
+  halFakeSetMac(stationMac);
+  halFakeRadioSetTx(onAir);
+  halRadioBegin(onRecv);
+  for (uint8_t i = 0; i < HOST_SERVOS; ++i) halTimerCreate(onServoDone, &servos[i], "servo", &servos[i].timer);
+  remoteBegin(&remote, hostExec, hostKick);
+  atexit(printSummary);
+}
+
+// The remote task does not run natively: service it every simulated millisecond
+void loop() {
+  static uint32_t lastCmdMs = 0;
+  static bool open = false;
+  uint32_t nowMs = halMillis();
+
+  if (nowMs - lastCmdMs >= HOST_CMD_MS) {
+    lastCmdMs = nowMs;
+    open = !open;
+    sendCmd(open ? LINK_OP_OPEN : LINK_OP_CLOSE);
+  }
+  remoteService(&remote);
+  halDelayMs(1);
+}
@@ -4,48 +4,43 @@
 #include <Arduino.h>
 #include "ds_motor.h"
 #include "servo_util.h"
+#include "servo_motion.h"
+#include "servo_cal.h"
 
 /* Defines */
 #define DEBUG (0U)
 
-/* Private Fnction Definitions */
-static inline uint16_t angleToUs(uint8_t deg) {
-  return static_cast<uint16_t>(SERVO_MIN_US + ((static_cast<uint32_t>(deg) * 2000U) / 180U));
-}
-
 /* Public Function Definitions */
 
 // -----------------------------
-// DS positional (manual pulse)
+// DS positional, presets and angles from the pin's calibration
 // -----------------------------
-uint8_t dsClosedAngleForPin(uint8_t pin) {
-  return (pin == OUT2_PIN) ? BOTTOM_BUN_CLOSED : TOP_BUN_CLOSED;
+uint16_t dsClosedUsForPin(uint8_t pin) {
+  int slot = servoCalSlotForPin(pin);
+  return (slot < 0) ? SERVO_NEUTRAL_US : servoCalTable[slot].closedUs;
 }
 
-uint8_t dsOpenAngleForPin(uint8_t pin) {
-  return (pin == OUT2_PIN) ? BOTTOM_BUN_OPEN : TOP_BUN_OPEN;
+uint16_t dsOpenUsForPin(uint8_t pin) {
+  int slot = servoCalSlotForPin(pin);
+  return (slot < 0) ? SERVO_NEUTRAL_US : servoCalTable[slot].openUs;
 }
 
-void driveDsServoAngle(uint8_t pin, int angleDeg) {
-  angleDeg = constrain(angleDeg, 0, 180);
-  uint16_t us = angleToUs(static_cast<uint8_t>(angleDeg));
-  // if (DEBUG) { enqueuePrint("DS angle="); enqueuePrint(angleDeg); enqueuePrint(" us="); enqueuePrint("%d\n", us); }
-  servoOneFrameWriteUs(pin, us);
+// S-curve to a pulse, then hold it for holdMs (queued, returns immediately)
+bool dsHoldUs(uint8_t pin, uint16_t us, uint16_t holdMs, motion_done_cb cb, void* arg) {
+  int slot = servoCalSlotForPin(pin);
+  if (slot < 0) return false;
+  us = constrain(us, servoCalTable[slot].minUs, servoCalTable[slot].maxUs);
+  return motionMoveProfile(pin, us, TRAJ_SCURVE, holdMs, cb, arg);
 }
 
-// Hold a position for holdMs by refreshing every frame
-void dsHoldAngle(uint8_t pin, int angleDeg, uint16_t holdMs) {
-  uint32_t start = millis();
-  while (millis() - start < holdMs) {
-    driveDsServoAngle(pin, angleDeg);
-  }
+bool dsHoldAngle(uint8_t pin, int angleDeg, uint16_t holdMs, motion_done_cb cb, void* arg) {
+  int slot = servoCalSlotForPin(pin);
+  if (slot < 0) return false;
+  return dsHoldUs(pin, servoCalAngleToUs(slot, angleDeg), holdMs, cb, arg);
 }
 
-// CLOSED->OPEN, pause, OPEN->CLOSED
-void dsBounce(uint8_t pin, uint16_t pauseMs) {
-  uint8_t openA   = dsOpenAngleForPin(pin);
-  uint8_t closedA = dsClosedAngleForPin(pin);
-  dsHoldAngle(pin, openA,   DS_BOUNCE_MOVE_MS);
-  delay(pauseMs);
-  dsHoldAngle(pin, closedA, DS_BOUNCE_MOVE_MS);
-}
\ No newline at end of file
+// CLOSED->OPEN, pause, OPEN->CLOSED (queued, returns immediately)
+bool dsBounce(uint8_t pin, uint16_t pauseMs, motion_done_cb cb, void* arg) {
+  return dsHoldUs(pin, dsOpenUsForPin(pin),   DS_SETTLE_MS + pauseMs, NULL) &&
+         dsHoldUs(pin, dsClosedUsForPin(pin), DS_SETTLE_MS, cb, arg);
+}
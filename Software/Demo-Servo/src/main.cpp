@@ -3,6 +3,13 @@
 #include <Arduino.h>
 #include "slave_config.h"
 #include "servo_util.h"
+#include "servo_driver.h"
+#include "ds_motor.h"
+#include "servo_feedback.h"
+#include "servo_remote.h"
+#include "cmd_shell.h"
+#include "print_queue.h"
+#include "hal.h"
 
 // -----------------------------
 // Utils
@@ -10,41 +17,19 @@
 #define MAX(x,y) ((x > y) ? (x) : (y))
 
 // -----------------------------
-// Compile-time target selection
-// Set exactly one to 1
-// -----------------------------
-#define DS_MOTOR              (0U)  // Discrete positional (manual pulse)
-#define DS_CONTINUOUS_MOTOR   (0U)  // Continuous (manual pulse)
-#define TOWER_PRO_MOTOR       (1U)  // TowerPro MG995 via Servo lib (positional)
-#define PARALLAX_MOTOR        (0U)  // Continuous (manual pulse)
-
-// -----------------------------
-// Sanity check: exactly one target
+// Station: every model runs side by side, each on a fixed pin and LEDC slot
 // -----------------------------
-#if (DS_MOTOR + DS_CONTINUOUS_MOTOR + TOWER_PRO_MOTOR + PARALLAX_MOTOR) != 1
-#error "Select exactly one target motor by setting its macro to 1."
-#endif
-
-// -----------------------------
-// Include Motor Headers
-// -----------------------------
-#if DS_MOTOR
-#include "ds_motor.h"
-#endif
-#if DS_CONTINUOUS_MOTOR
-#include "ds_continuous_motor.h"
-#endif
-#if PARALLAX_MOTOR
-#include "parallax_motor.h"
-#endif
-#if TOWER_PRO_MOTOR
-#include "tower_pro_motor.h"
-#endif
+using TopDropper    = PositionalServo<DsServoTraits,      OUT1_PIN, 0>;
+using BottomDropper = PositionalServo<DsServoTraits,      OUT2_PIN, 1>;
+using TowerPro      = PositionalServo<TowerProTraits,     OUT3_PIN, 2>;  // MG995
+using ContServo     = ContinuousServo<DsContinuousTraits, OUT4_PIN, 3>;
+using Parallax      = ContinuousServo<ParallaxTraits,     OUT5_PIN, 4>;
 
 // -----------------------------
 // Feature flags
 // -----------------------------
 #define DEBUG                 (0U)
+#define HEAP_CHECK_MS         (10000U)   // Heap report this long after setup()
 
 // -----------------------------
 // Serial helpers
@@ -53,25 +38,36 @@ static void initSerial() {
   Serial.begin(9600);
   delay(1000);
   while (!Serial) {}
+  shellBegin(Serial);
 }
 
 static void waitForUser() {
   enqueuePrint("Type 'y' then press Enter to start:\n");
-  String input;
   while (true) {
-    if (Serial.available()) {
-      input = Serial.readStringUntil('\n');
-      input.trim();
-      if (input.equalsIgnoreCase("y")) {
+    char* line = shellGetLine();
+    if (line) {
+      if (strcasecmp(line, "y") == 0) {
         enqueuePrint("Starting main loop...\n");
         return;
       } else {
         enqueuePrint("Waiting for 'y'...\n");
       }
     }
+    vTaskDelay(SERVO_FRAME_MS / portTICK_PERIOD_MS);
   }
 }
 
+// Integer argument i, or def when missing or not a number
+static long argInt(int argc, char** argv, int i, long def) {
+  long v;
+  return (i < argc && shellParseInt(argv[i], &v)) ? v : def;
+}
+
+// Runs in the motion tick once a queued command has finished
+static void onMotionDone(uint8_t pin, void* arg) {
+  enqueuePrint("Servo on pin %d done at %lu ms\n", pin, millis());
+}
+
 static void blinkAtBoot(uint8_t pin) {
   digitalWrite(pin, LOW);  delay(250);
   digitalWrite(pin, HIGH); delay(250);
@@ -79,211 +75,310 @@ static void blinkAtBoot(uint8_t pin) {
   digitalWrite(pin, HIGH);
 }
 
-// -----------------------------
-// Tokenize up to three space-separated tokens
-// -----------------------------
-static void tokenize3(const String& s, String& t0, String& t1, String& t2) {
-  int s1 = s.indexOf(' ');
-  if (s1 < 0) { t0 = s; t1=""; t2=""; return; }
-  t0 = s.substring(0, s1);
-  int s2 = s.indexOf(' ', s1 + 1);
-  if (s2 < 0) { t1 = s.substring(s1 + 1); t2=""; return; }
-  t1 = s.substring(s1 + 1, s2);
-  t2 = s.substring(s2 + 1);
+template <typename Servo>
+static bool beginServo(const char* name, uint16_t openUs = Servo::traits::minUs,
+                       uint16_t closedUs = Servo::traits::maxUs) {
+  bool ok = Servo::begin(openUs, closedUs);
+  if (!ok) enqueuePrint("%s on pin %d: no servo channel\n", name, Servo::pin);
+  return ok;
 }
 
 // -----------------------------
-// Arduino setup/loop
+// Per-model command handlers
 // -----------------------------
-void setup() {
-  initSerial();
-  pinMode(LED_PIN, OUTPUT);
-  pinMode(OUT1_PIN, OUTPUT);
-#if DS_MOTOR
-  pinMode(OUT2_PIN, OUTPUT);
-#endif
-  blinkAtBoot(LED_PIN);
-
-#if TOWER_PRO_MOTOR
-  towerProInit(OUT1_PIN);
-#endif
+// DS droppers, selector 1, 2 or 12 (both at once):
+// - "open [sel]", "close [sel]", "b <pause_ms> [sel]", "<angle 0..180> [sel]"
+static void cmdDs(int argc, char** argv) {
+  auto parseServo = [](int argc, char** argv, int i)->int {
+    if (i >= argc) return -1;
+    if (strcmp(argv[i], "1") == 0)  return 1;
+    if (strcmp(argv[i], "2") == 0)  return 2;
+    if (strcmp(argv[i], "12") == 0) return 3;
+    return -1;
+  };
+  bool bounce = strcasecmp(argv[0], "b") == 0 || strcasecmp(argv[0], "bounce") == 0;
+  int sel = parseServo(argc, argv, bounce ? 2 : 1);
+  if (sel < 0) sel = 1;
+  uint8_t targetPins[2];
+  uint8_t pinCount = 0;
+  if (sel & 1) targetPins[pinCount++] = TopDropper::pin;
+  if (sel & 2) targetPins[pinCount++] = BottomDropper::pin;
+
+  // Issued to every selected dropper so they move together
+  for (uint8_t i = 0; i < pinCount; ++i) {
+    uint8_t targetPin = targetPins[i];
+    bool queued = true;
+    if (strcasecmp(argv[0], "open") == 0) {
+      queued = dsHoldUs(targetPin, dsOpenUsForPin(targetPin), DS_SETTLE_MS, onMotionDone);
+    } else if (strcasecmp(argv[0], "close") == 0) {
+      queued = dsHoldUs(targetPin, dsClosedUsForPin(targetPin), DS_SETTLE_MS, onMotionDone);
+    } else if (bounce) {
+      uint16_t pauseMs = (uint16_t)MAX(0, argInt(argc, argv, 1, 1000));
+      queued = dsBounce(targetPin, pauseMs, onMotionDone);
+    } else {
+      queued = dsHoldAngle(targetPin, constrain(argInt(argc, argv, 0, 90), 0, 180), DS_SETTLE_MS, onMotionDone);
+    }
+    if (!queued) enqueuePrint("Servo on pin %d busy, command dropped\n", targetPin);
+    else         enqueuePrint("Servo on pin %d done in ~%lu ms\n", targetPin, (unsigned long)motionEtaMs(targetPin));
+  }
+}
 
-  // side effect: spin up Wifi task (and Print task if DEBUG flag set)
-  // note: must be called before while(!Serial)
-  startSlave();
+// Bare number: DS angle
+static void cmdFallback(int argc, char** argv) {
+  long v;
+  if (shellParseInt(argv[0], &v)) cmdDs(argc, argv);
+  else enqueuePrint("Unknown command '%s', try 'help'\n", argv[0]);
+}
 
-  // BLOCKING!!
-  waitForUser();
+// Positional: "<angle 0..180>" or "b <duration_ms> <pause_ms>"
+template <typename Servo>
+static void positionalCommand(int argc, char** argv) {
+  bool queued;
+  if (argc > 1 && (strcasecmp(argv[1], "b") == 0 || strcasecmp(argv[1], "bounce") == 0)) {
+    uint16_t durationMs = (uint16_t)MAX(0, argInt(argc, argv, 2, 500));
+    uint16_t pauseMs    = (uint16_t)MAX(0, argInt(argc, argv, 3, 1000));
+    queued = Servo::bounce(durationMs, pauseMs, onMotionDone);
+  } else {
+    queued = Servo::moveAngle(argInt(argc, argv, 1, 90), 0, onMotionDone);
+  }
+  if (!queued) enqueuePrint("Servo on pin %d busy, command dropped\n", Servo::pin);
+  else         enqueuePrint("Servo on pin %d done in ~%lu ms\n", Servo::pin, (unsigned long)Servo::etaMs());
 }
 
-void loop() {
-  static int num = 90;             // angle or bounce cycles
-  static int dir = 0;              // -1 left, 0 stop, +1 right (continuous)
-  static bool bounceFlag = false;
-  static uint8_t dsActivePin = OUT1_PIN; // default target for DS_MOTOR
-
-#if DS_MOTOR
-  // Input formats:
-  // - "open [1|2]"
-  // - "close [1|2]"
-  // - "b <pause_ms> [1|2]"
-  // - "<angle 0..180> [1|2]"
-  enqueuePrint("DS: enter 'open [1|2]', 'close [1|2]', 'b <pause_ms> [1|2]', or '<angle> [1|2]':\n");
-  while (true) {
-    // Refresh last commanded angle for active pin if the last cmd was numeric
-    driveDsServoAngle(dsActivePin, num);
-
-    if (Serial.available()) {
-      String input = Serial.readStringUntil('\n'); input.trim();
-      if (input.length() == 0) break;
-
-      String t0, t1, t2; tokenize3(input, t0, t1, t2);
-
-      // Optional per-command servo selector
-      auto parseServo = [](const String& tok)->int {
-        if (tok == "1") return 1;
-        if (tok == "2") return 2;
-        return -1;
-      };
-      int sel = parseServo(t2); if (sel < 0) sel = parseServo(t1);
-      uint8_t targetPin = (sel == 2) ? OUT2_PIN : OUT1_PIN;
-      dsActivePin = targetPin; // remember for refresh
-
-      // Commands
-      if (t0.equalsIgnoreCase("open")) {
-        dsHoldAngle(targetPin, dsOpenAngleForPin(targetPin), DS_BOUNCE_MOVE_MS);
-      } else if (t0.equalsIgnoreCase("close")) {
-        dsHoldAngle(targetPin, dsClosedAngleForPin(targetPin), DS_BOUNCE_MOVE_MS);
-      } else if (t0.equalsIgnoreCase("b") || t0.equalsIgnoreCase("bounce")) {
-        uint16_t pauseMs = 1000;
-        if (t1.length() && isDigit(t1.charAt(0))) {
-          pauseMs = (uint16_t)MAX(0, (int)(t1.toInt()));
-        }
-        dsBounce(targetPin, pauseMs);
-      } else {
-        // numeric angle in t0
-        if (isDigit(t0.charAt(0))) {
-          num = constrain(t0.toInt(), 0, 180);
-          dsHoldAngle(targetPin, num, DS_BOUNCE_MOVE_MS);
-        }
+// Continuous: "r" (right), "l" (left), "s" (stop) or a number of bounce frames
+template <typename Servo>
+static void continuousCommand(int argc, char** argv) {
+  char mode = (argc > 1) ? argv[1][0] : 's';
+  switch (mode) {
+    case 'r': enqueuePrint("Right\n"); Servo::forward(); break;
+    case 'l': enqueuePrint("Left\n");  Servo::reverse(); break;
+    case 's': enqueuePrint("Stop\n");  Servo::halt();    break;
+    default:
+      if (isDigit(mode) && !Servo::bounceFrames((uint16_t)MAX(0, argInt(argc, argv, 1, 0)), onMotionDone)) {
+        enqueuePrint("Servo on pin %d busy, command dropped\n", Servo::pin);
       }
       break;
-    }
   }
+}
 
-#elif TOWER_PRO_MOTOR
-  // Input formats:
-  // - "<angle 0..180>"
-  // - "b <duration_ms> <pause_ms>"
-  enqueuePrint("TP: enter '<angle 0..180>' or 'b <duration_ms> <pause_ms>':\n");
-  while (true) {
-    // Keep last angle commanded
-    MG995_servo.write(constrain(num, 0, 180));
-
-    if (Serial.available()) {
-      String input = Serial.readStringUntil('\n'); input.trim();
-      if (input.length() == 0) break;
-
-      String t0, t1, t2; tokenize3(input, t0, t1, t2);
-
-      if (t0.equalsIgnoreCase("b") || t0.equalsIgnoreCase("bounce")) {
-        uint16_t durationMs = 500;
-        uint16_t pauseMs    = 1000;
-        if (t1.length() && isDigit(t1.charAt(0))) durationMs = (uint16_t)MAX(0, (int)(t1.toInt()));
-        if (t2.length() && isDigit(t2.charAt(0))) pauseMs    = (uint16_t)MAX(0, (int)(t2.toInt()));
-        towerProBounce(durationMs, pauseMs);
-      } else if (isDigit(t0.charAt(0))) {
-        num = constrain(t0.toInt(), 0, 180);
-        MG995_servo.write(num);
-      }
-      break;
-    }
+// Parallax closed loop: "a <deg>" absolute (multi-turn), "d <deg>" relative
+static void onFeedbackDone(uint8_t pin, void* arg) {
+  feedback_stats st;
+  feedbackStats(&st);
+  enqueuePrint("Servo on pin %d at %ld.%ld deg, settle %lu ms (max %lu), overshoot %ld.%ld deg, timeouts %lu, faults %lu\n",
+               pin, (long)(st.angleDeg10 / 10), (long)abs(st.angleDeg10 % 10),
+               (unsigned long)st.lastSettleMs, (unsigned long)st.maxSettleMs,
+               (long)(st.lastOvershootDeg10 / 10), (long)abs(st.lastOvershootDeg10 % 10),
+               (unsigned long)st.timeouts, (unsigned long)st.sensorFaults);
+}
+
+static void cmdTowerPro(int argc, char** argv) { positionalCommand<TowerPro>(argc, argv); }
+static void cmdContinuous(int argc, char** argv) { continuousCommand<ContServo>(argc, argv); }
+
+static void cmdParallax(int argc, char** argv) {
+  if (argc > 1 && (strcasecmp(argv[1], "a") == 0 || strcasecmp(argv[1], "d") == 0)) {
+    int32_t deg10 = (int32_t)argInt(argc, argv, 2, 0) * 10;
+    bool ok = (strcasecmp(argv[1], "a") == 0) ? feedbackMoveTo(deg10, onFeedbackDone)
+                                              : feedbackMoveBy(deg10, onFeedbackDone);
+    if (!ok) enqueuePrint("Parallax: no feedback signal on pin %d\n", FB1_PIN);
+  } else {
+    feedbackRelease();
+    continuousCommand<Parallax>(argc, argv);
   }
+}
 
+// -----------------------------
+// Remote commands (ESP-NOW from the Chef), run in the remote task, must not block
+// -----------------------------
+static link_status dsRemote(uint8_t pin, uint8_t op, int16_t arg, motion_done_cb cb, void* cbArg) {
+  bool queued;
+  switch (op) {
+    case LINK_OP_PING:   return LINK_OK;
+    case LINK_OP_ANGLE:  queued = dsHoldAngle(pin, constrain(arg, 0, 180), DS_SETTLE_MS, cb, cbArg); break;
+    case LINK_OP_OPEN:   queued = dsHoldUs(pin, dsOpenUsForPin(pin), DS_SETTLE_MS, cb, cbArg); break;
+    case LINK_OP_CLOSE:  queued = dsHoldUs(pin, dsClosedUsForPin(pin), DS_SETTLE_MS, cb, cbArg); break;
+    case LINK_OP_BOUNCE: queued = dsBounce(pin, (uint16_t)MAX(0, arg), cb, cbArg); break;
+    case LINK_OP_STOP:   motionStop(pin); return LINK_OK;
+    default:             return LINK_BAD_OP;
+  }
+  return queued ? LINK_OK : LINK_BUSY;
+}
 
-#elif SMRAZA_MOTOR
-  // Input formats:
-  // - "<angle 0..180>"
-  // - "b <duration_ms> <pause_ms>"
-  enqueuePrint("TP: enter '<angle 0..180>' or 'b <duration_ms> <pause_ms>':\n");
-  while (true) {
-    // Keep last angle commanded
-    SMRAZA_servo.write(constrain(num, 0, 180));
-
-    if (Serial.available()) {
-      String input = Serial.readStringUntil('\n'); input.trim();
-      if (input.length() == 0) break;
-
-      String t0, t1, t2; tokenize3(input, t0, t1, t2);
-
-      if (t0.equalsIgnoreCase("b") || t0.equalsIgnoreCase("bounce")) {
-        uint16_t durationMs = 500;
-        uint16_t pauseMs    = 1000;
-        if (t1.length() && isDigit(t1.charAt(0))) durationMs = (uint16_t)x(0, t1.toInt());
-        if (t2.length() && isDigit(t2.charAt(0))) pauseMs    = (uint16_t)MAX(0, (int)(t2.toInt()));
-        smrazaS51Bounce(durationMs, pauseMs);
-      } else if (isDigit(t0.charAt(0))) {
-        num = constrain(t0.toInt(), 0, 180);
-        smrazaS51.write(num);
-      }
-      break;
-    }
+template <typename Servo>
+static link_status positionalRemote(uint8_t op, int16_t arg, motion_done_cb cb, void* cbArg) {
+  bool queued;
+  switch (op) {
+    case LINK_OP_PING:   return LINK_OK;
+    case LINK_OP_ANGLE:  queued = Servo::moveAngle(arg, 0, cb, cbArg); break;
+    case LINK_OP_OPEN:   queued = Servo::moveUs(Servo::openUs(), TRAJ_SCURVE, 0, cb, cbArg); break;
+    case LINK_OP_CLOSE:  queued = Servo::moveUs(Servo::closedUs(), TRAJ_SCURVE, 0, cb, cbArg); break;
+    case LINK_OP_BOUNCE: queued = Servo::bounce(500, (uint16_t)MAX(0, arg), cb, cbArg); break;
+    case LINK_OP_STOP:   Servo::stop(); return LINK_OK;
+    default:             return LINK_BAD_OP;
   }
+  return queued ? LINK_OK : LINK_BUSY;
+}
 
-#elif DS_CONTINUOUS_MOTOR
-  enqueuePrint("CR: enter 'r' (right), 'l' (left), 's' (stop), or a number for bounce cycles:\n");
-  while (true) {
-    if (dir < 0)      contServoLeft(OUT1_PIN);
-    else if (dir > 0) contServoRight(OUT1_PIN);
-    else if (bounceFlag) {
-      contServoBounce(OUT1_PIN, num);
-      dir = 0; bounceFlag = false;
-    } else           contServoHalt(OUT1_PIN);
-
-    if (Serial.available()) {
-      String input = Serial.readStringUntil('\n'); input.trim();
-      if (input.length() == 0) break;
-
-      char mode = input.charAt(0);
-      switch (mode) {
-        case 'r': enqueuePrint("Right\n"); dir = 1;  bounceFlag = false; break;
-        case 'l': enqueuePrint("Left\n");  dir = -1; bounceFlag = false; break;
-        case 's': enqueuePrint("Stop\n");  dir = 0;  bounceFlag = false; break;
-        default:
-          if (isDigit(mode)) { num = MAX(0, (int)(input.toInt())); bounceFlag = true; }
-          break;
-      }
-      break;
-    }
+// Continuous servos only bounce (arg in frames) and stop
+template <typename Servo>
+static link_status continuousRemote(uint8_t op, int16_t arg, motion_done_cb cb, void* cbArg) {
+  switch (op) {
+    case LINK_OP_PING:   return LINK_OK;
+    case LINK_OP_BOUNCE: return Servo::bounceFrames((uint16_t)MAX(0, arg), cb, cbArg) ? LINK_OK : LINK_BUSY;
+    case LINK_OP_STOP:   Servo::stop(); Servo::halt(); return LINK_OK;
+    default:             return LINK_BAD_OP;
   }
-#endif // DS_MOTOR
+}
 
-#if PARALLAX_MOTOR
-  enqueuePrint("CR: enter 'r' (right), 'l' (left), 's' (stop), or a number for bounce cycles:\n");
-  while (true) {
-    if (dir < 0)      parallaxServoLeft(OUT1_PIN);
-    else if (dir > 0) parallaxServoRight(OUT1_PIN);
-    else if (bounceFlag) {
-      parallaxServoBounce(OUT1_PIN, num);
-      dir = 0; bounceFlag = false;
-    } else           parallaxServoHalt(OUT1_PIN);
-
-    if (Serial.available()) {
-      String input = Serial.readStringUntil('\n'); input.trim();
-      if (input.length() == 0) break;
-
-      char mode = input.charAt(0);
-      switch (mode) {
-        case 'r': enqueuePrint("Right\n"); dir = 1;  bounceFlag = false; break;
-        case 'l': enqueuePrint("Left\n");  dir = -1; bounceFlag = false; break;
-        case 's': enqueuePrint("Stop\n");  dir = 0;  bounceFlag = false; break;
-        default:
-          if (isDigit(mode)) { num = MAX(0, (int)(input.toInt())); bounceFlag = true; }
-          break;
+// Called once per selected servo. Parallax angles go to the closed loop, which
+// starts on its own next control tick, so *pin stays unset for those.
+static link_status remoteExec(uint8_t op, uint8_t servo, int16_t arg,
+                              motion_done_cb cb, void* cbArg, uint8_t* pin) {
+  switch (servo) {
+    case LINK_SERVO_TOP:
+      *pin = TopDropper::pin;
+      return dsRemote(TopDropper::pin, op, arg, cb, cbArg);
+    case LINK_SERVO_BOTTOM:
+      *pin = BottomDropper::pin;
+      return dsRemote(BottomDropper::pin, op, arg, cb, cbArg);
+    case LINK_SERVO_TOWERPRO:
+      *pin = TowerPro::pin;
+      return positionalRemote<TowerPro>(op, arg, cb, cbArg);
+    case LINK_SERVO_CONTINUOUS:
+      *pin = ContServo::pin;
+      return continuousRemote<ContServo>(op, arg, cb, cbArg);
+    case LINK_SERVO_PARALLAX:
+      if (op == LINK_OP_ANGLE) {
+        return feedbackMoveTo((int32_t)arg * 10, cb, cbArg) ? LINK_OK : LINK_NO_SIGNAL;
       }
-      break;
+      feedbackRelease();
+      *pin = Parallax::pin;
+      return continuousRemote<Parallax>(op, arg, cb, cbArg);
+    default:
+      return LINK_BAD_SERVO;
+  }
+}
+
+// Calibration: "cal" lists, "cal <pin> auto|save|reset", "cal <pin> <field> <us>"
+// with field min|max|neutral|deadband|open|close. Edits apply at once, 'save' persists.
+static void printCal() {
+  for (uint8_t i = 0; i < SERVO_MAX_CHANNELS; ++i) {
+    const servo_cal& c = servoCalTable[i];
+    if (!c.version) continue;
+    enqueuePrint("pin %d: min %u max %u neutral %u deadband %u open %u close %u\n",
+                 c.pin, c.minUs, c.maxUs, c.neutralUs, c.deadbandUs, c.openUs, c.closedUs);
+  }
+}
+
+static void cmdCal(int argc, char** argv) {
+  if (argc < 3) { printCal(); return; }
+  int slot = servoCalSlotForPin((uint8_t)argInt(argc, argv, 1, -1));
+  if (slot < 0) { enqueuePrint("cal: no servo on pin %s\n", argv[1]); return; }
+  servo_cal& c = servoCalTable[slot];
+
+  const char* field = argv[2];
+  uint16_t us = (uint16_t)constrain(argInt(argc, argv, 3, 0), (long)SERVO_CLAMP_MIN_US, (long)SERVO_CLAMP_MAX_US);
+  if (strcasecmp(field, "auto") == 0) {
+    feedbackRelease();
+    if (c.pin == Parallax::pin) {
+      enqueuePrint("cal: searching neutral on pin %d...\n", c.pin);
+      if (!servoCalAutoNeutral(slot, feedbackAngle)) enqueuePrint("cal: no dead band found\n");
+    } else {
+      bool lo = false, hi = false;
+      enqueuePrint("cal: searching endpoints on pin %d...\n", c.pin);
+      servoCalAutoEndpoints(slot, &lo, &hi);
+      enqueuePrint("cal: low stop %s, high stop %s\n", lo ? "found" : "not found", hi ? "found" : "not found");
     }
+  } else if (strcasecmp(field, "save") == 0) {
+    enqueuePrint("cal: %s\n", servoCalSave(slot) ? "saved" : "invalid, not saved");
+  } else if (strcasecmp(field, "reset") == 0) {
+    servoCalReset(slot);
+  } else if (argc < 4) {
+    enqueuePrint("cal: missing value\n");
+    return;
+  } else if (strcasecmp(field, "min") == 0)      c.minUs = us;
+  else if (strcasecmp(field, "max") == 0)        c.maxUs = us;
+  else if (strcasecmp(field, "neutral") == 0)    c.neutralUs = us;
+  else if (strcasecmp(field, "deadband") == 0)   c.deadbandUs = (uint16_t)MAX(0, argInt(argc, argv, 3, 0));
+  else if (strcasecmp(field, "open") == 0)       c.openUs = us;
+  else if (strcasecmp(field, "close") == 0)      c.closedUs = us;
+  printCal();
+}
+
+// Remote command stats: "link"
+static void cmdLink(int argc, char** argv) {
+  remote_stats st;
+  remoteStats(&stationRemote, &st);
+  enqueuePrint("link: %lu commands, %lu servos started, %lu resends, %lu rejected, %lu dropped\n",
+               (unsigned long)st.commands, (unsigned long)st.started, (unsigned long)st.duplicates,
+               (unsigned long)st.rejected, (unsigned long)st.dropped);
+  enqueuePrint("link: receive to pulse change %lu us (avg %lu, max %lu)\n",
+               (unsigned long)st.lastRxToStartUs, (unsigned long)st.avgRxToStartUs,
+               (unsigned long)st.maxRxToStartUs);
+}
+
+static void cmdHelp(int argc, char** argv);
+
+// -----------------------------
+// Command table, the first token picks the servo
+// -----------------------------
+static const shell_cmd commands[] = {
+  { "open",   "[1|2|12]  DS droppers, also '<angle> [1|2|12]'",   cmdDs },
+  { "close",  "[1|2|12]",                                         cmdDs },
+  { "b",      "<pause_ms> [1|2|12]  DS bounce",                   cmdDs },
+  { "bounce", "<pause_ms> [1|2|12]",                              cmdDs },
+  { "tp",     "<angle> | b <dur_ms> <pause_ms>  TowerPro",        cmdTowerPro },
+  { "cr",     "r|l|s|<frames>  DS continuous",                    cmdContinuous },
+  { "px",     "r|l|s|<frames> | a|d <deg>  Parallax",             cmdParallax },
+  { "cal",    "[<pin> auto|save|reset|<field> <us>]",             cmdCal },
+  { "link",   "Remote command stats",                             cmdLink },
+  { "help",   "This list",                                        cmdHelp },
+};
+constexpr uint8_t NUM_COMMANDS = sizeof(commands) / sizeof(commands[0]);
+
+static void cmdHelp(int argc, char** argv) { shellHelp(commands, NUM_COMMANDS); }
+
+// -----------------------------
+// Arduino setup/loop
+// -----------------------------
+void setup() {
+  initSerial();
+  printQueueBegin(0);
+  pinMode(LED_PIN, OUTPUT);
+  blinkAtBoot(LED_PIN);
+
+  if (!servoCalBegin()) enqueuePrint("Calibration store unavailable, using model defaults\n");
+  beginServo<TopDropper>("DS top", TopDropper::modelAngleToUs(TOP_BUN_OPEN),
+                         TopDropper::modelAngleToUs(TOP_BUN_CLOSED));
+  beginServo<BottomDropper>("DS bottom", BottomDropper::modelAngleToUs(BOTTOM_BUN_OPEN),
+                            BottomDropper::modelAngleToUs(BOTTOM_BUN_CLOSED));
+  beginServo<TowerPro>("TowerPro");
+  beginServo<ContServo>("DS continuous");
+  beginServo<Parallax>("Parallax");
+  if (!feedbackBegin<Parallax>(FB1_PIN)) enqueuePrint("Parallax: feedback capture unavailable\n");
+  motionBegin();
+  if (!remoteBegin(&stationRemote, remoteExec, motionKick)) enqueuePrint("Remote command task unavailable\n");
+
+  // side effect: spin up Wifi task
+  // note: must be called before while(!Serial)
+  startSlave();
+
+  // BLOCKING!!
+  waitForUser();
+  shellHelp(commands, NUM_COMMANDS);
+  halHeapMark();    // The motion, remote and shell paths run without the heap from here
+}
+
+void loop() {
+  // Motion manager keeps the pulses going, just poll the shell once per frame
+  shellPoll(commands, NUM_COMMANDS, cmdFallback);
+
+  // One look at the heap once everything has run for a while
+  static uint32_t heapCheckMs = millis() + HEAP_CHECK_MS;
+  if (heapCheckMs && (int32_t)(millis() - heapCheckMs) >= 0) {
+    heapCheckMs = 0;
+    enqueuePrint("Heap: %lu allocations, %ld blocks held since setup()\n", (unsigned long)halHeapSinceMark(),
+                 (long)halHeapBlocksSinceMark());
   }
-#endif // PARALLAX_MOTOR
-  // TODO: add vTaskDelay()
+  vTaskDelay(SERVO_FRAME_MS / portTICK_PERIOD_MS);
 }
@@ -0,0 +1,184 @@
+/* Servo Calibration Store Driver */
+
+/* Includes */
+#include <Preferences.h>
+#include "servo_cal.h"
+#include "servo_motion.h"
+
+/* Externs */
+servo_cal servoCalTable[SERVO_MAX_CHANNELS];
+
+/* Statics */
+static Preferences calPrefs;
+static bool calReady = false;
+static servo_cal calDefaults[SERVO_MAX_CHANNELS];
+
+/* Private Function Definitions */
+static void calKey(uint8_t pin, char* key, size_t len) {
+  snprintf(key, len, "pin%u", pin);
+}
+
+static bool calValid(const servo_cal& c, uint8_t pin) {
+  return c.version == SERVO_CAL_VERSION && c.pin == pin &&
+         c.minUs >= SERVO_CLAMP_MIN_US && c.maxUs <= SERVO_CLAMP_MAX_US &&
+         c.minUs < c.neutralUs && c.neutralUs < c.maxUs &&
+         c.openUs >= c.minUs && c.openUs <= c.maxUs &&
+         c.closedUs >= c.minUs && c.closedUs <= c.maxUs;
+}
+
+static inline void calWriteUs(uint8_t slot, uint16_t us) {
+  ledcWrite(SERVO_LEDC_FIRST_CHANNEL + slot, servoUsToDuty(us));
+}
+
+static uint32_t senseMv() {
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < CAL_SENSE_SAMPLES; ++i) sum += analogReadMilliVolts(CAL_SENSE_PIN);
+  return sum / CAL_SENSE_SAMPLES;
+}
+
+// FUNCTION: Step away from neutral until the supply current stays up (stalled on the stop),
+// returns the endpoint backed off by the margin, or limitUs if no stall was seen
+static uint16_t sweepToStall(uint8_t slot, uint16_t fromUs, int16_t stepUs, uint16_t limitUs,
+                             uint32_t idleMv, bool* found) {
+  uint8_t hits = 0;
+  int32_t firstUs = fromUs;
+  for (int32_t us = fromUs; (stepUs < 0) ? us >= limitUs : us <= limitUs; us += stepUs) {
+    calWriteUs(slot, (uint16_t)us);
+    delay(CAL_STEP_MS);
+    if (senseMv() > idleMv + CAL_STALL_MV) {
+      if (!hits++) firstUs = us;
+      if (hits >= CAL_STALL_STEPS) {
+        *found = true;
+        return (uint16_t)(firstUs - ((stepUs < 0) ? -(int32_t)CAL_MARGIN_US : (int32_t)CAL_MARGIN_US));
+      }
+    } else {
+      hits = 0;
+    }
+  }
+  *found = false;
+  return limitUs;
+}
+
+/* Public Function Definitions */
+bool servoCalBegin() {
+  if (!calReady) calReady = calPrefs.begin(SERVO_CAL_NAMESPACE, false);
+  return calReady;
+}
+
+// FUNCTION: Fill a slot from NVS, falling back to (and remembering) the model defaults
+void servoCalLoad(uint8_t slot, const servo_cal* defaults) {
+  if (slot >= SERVO_MAX_CHANNELS) return;
+  calDefaults[slot] = *defaults;
+  calDefaults[slot].version = SERVO_CAL_VERSION;
+  servoCalTable[slot] = calDefaults[slot];
+
+  if (!servoCalBegin()) return;
+  char key[8];
+  calKey(defaults->pin, key, sizeof(key));
+  servo_cal stored;
+  if (calPrefs.getBytesLength(key) == sizeof(stored) &&
+      calPrefs.getBytes(key, &stored, sizeof(stored)) == sizeof(stored) &&
+      calValid(stored, defaults->pin)) {
+    servoCalTable[slot] = stored;
+  }
+}
+
+bool servoCalSave(uint8_t slot) {
+  if (slot >= SERVO_MAX_CHANNELS || !servoCalBegin()) return false;
+  const servo_cal& c = servoCalTable[slot];
+  if (!calValid(c, c.pin)) return false;
+  char key[8];
+  calKey(c.pin, key, sizeof(key));
+  return calPrefs.putBytes(key, &c, sizeof(c)) == sizeof(c);
+}
+
+void servoCalReset(uint8_t slot) {
+  if (slot >= SERVO_MAX_CHANNELS) return;
+  servoCalTable[slot] = calDefaults[slot];
+  if (!servoCalBegin()) return;
+  char key[8];
+  calKey(calDefaults[slot].pin, key, sizeof(key));
+  calPrefs.remove(key);
+}
+
+int servoCalSlotForPin(uint8_t pin) {
+  for (uint8_t i = 0; i < SERVO_MAX_CHANNELS; ++i) {
+    if (servoCalTable[i].version && servoCalTable[i].pin == pin) return i;
+  }
+  return -1;
+}
+
+uint16_t servoCalAngleToUs(uint8_t slot, int angleDeg) {
+  const servo_cal& c = servoCalTable[slot];
+  return servoMapAngle(angleDeg, c.minUs, c.maxUs);
+}
+
+// FUNCTION: Drive a positional servo into both mechanical stops and keep the endpoints
+// just inside them. Blocking (~15 s), takes the channel from the motion manager.
+bool servoCalAutoEndpoints(uint8_t slot, bool* lowFound, bool* highFound) {
+  if (slot >= SERVO_MAX_CHANNELS) return false;
+  servo_cal c = servoCalTable[slot];
+  motionStop(c.pin);
+
+  // 1. Idle current at rest
+  calWriteUs(slot, c.neutralUs);
+  delay(CAL_REST_MS);
+  uint32_t idleMv = senseMv();
+
+  // 2. Sweep out both ways from rest
+  uint16_t lowUs = sweepToStall(slot, c.neutralUs, -(int16_t)CAL_STEP_US, SERVO_CLAMP_MIN_US, idleMv, lowFound);
+  calWriteUs(slot, c.neutralUs);
+  delay(CAL_REST_MS);
+  uint16_t highUs = sweepToStall(slot, c.neutralUs, CAL_STEP_US, SERVO_CLAMP_MAX_US, idleMv, highFound);
+  calWriteUs(slot, c.neutralUs);
+  delay(CAL_REST_MS);
+  motionJump(c.pin, c.neutralUs);
+
+  // 3. Only stops that were actually found move the range, presets stay inside it
+  if (*lowFound)  c.minUs = lowUs;
+  if (*highFound) c.maxUs = highUs;
+  c.openUs   = constrain(c.openUs,   c.minUs, c.maxUs);
+  c.closedUs = constrain(c.closedUs, c.minUs, c.maxUs);
+  if (!calValid(c, c.pin)) return false;
+  servoCalTable[slot] = c;
+  return *lowFound || *highFound;
+}
+
+// FUNCTION: Step a continuous servo through its dead band, watching the feedback angle,
+// and centre neutral on the widest run of pulses that do not move it. Blocking (~8 s).
+bool servoCalAutoNeutral(uint8_t slot, int32_t (*readAngleDeg10)()) {
+  if (slot >= SERVO_MAX_CHANNELS || !readAngleDeg10) return false;
+  servo_cal c = servoCalTable[slot];
+  motionStop(c.pin);
+
+  uint16_t runStart = 0, bestLo = 0, bestHi = 0;
+  bool inRun = false;
+  const uint16_t fromUs = c.neutralUs - CAL_NEUTRAL_SPAN_US;
+  const uint16_t toUs   = c.neutralUs + CAL_NEUTRAL_SPAN_US;
+  for (uint16_t us = fromUs; us <= toUs; us += CAL_NEUTRAL_STEP_US) {
+    calWriteUs(slot, us);
+    delay(CAL_NEUTRAL_STEP_MS);
+    int32_t a0 = readAngleDeg10();
+    delay(CAL_NEUTRAL_STEP_MS);
+    int32_t moved = readAngleDeg10() - a0;
+    bool still = (moved <= CAL_STILL_DEG10) && (moved >= -CAL_STILL_DEG10);
+
+    if (still && !inRun) { runStart = us; inRun = true; }
+    if (inRun && (!still || us + CAL_NEUTRAL_STEP_US > toUs)) {
+      uint16_t runEnd = still ? us : us - CAL_NEUTRAL_STEP_US;
+      if (runEnd - runStart > bestHi - bestLo) { bestLo = runStart; bestHi = runEnd; }
+      inRun = false;
+    }
+  }
+
+  bool found = bestHi > bestLo;
+  if (found) {
+    c.neutralUs  = (bestLo + bestHi) / 2;
+    c.deadbandUs = (bestHi - bestLo) / 2 + CAL_NEUTRAL_STEP_US;
+    if (!calValid(c, c.pin)) found = false;
+    else servoCalTable[slot] = c;
+  }
+  calWriteUs(slot, servoCalTable[slot].neutralUs);
+  motionJump(c.pin, servoCalTable[slot].neutralUs);
+  return found;
+}
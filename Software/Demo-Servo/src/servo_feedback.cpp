@@ -0,0 +1,249 @@
+/* Servo Feedback Loop Driver */
+
+/* Includes */
+#include <esp_timer.h>
+#include <driver/mcpwm.h>
+#include "servo_feedback.h"
+
+/* Statics */
+// Capture ISR -> loop (APB ticks)
+static portMUX_TYPE capMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t capRise;
+static uint32_t capHigh;
+static uint32_t capPeriod;
+static uint32_t capEdgeUs;      // esp_timer time of the last falling edge
+
+// Angle loop, owned by the esp_timer task
+static portMUX_TYPE fbMux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t fbTimer = NULL;
+static feedback_servo fbServo;
+static int32_t lastRaw = -1;
+static int32_t turns;
+static int32_t angleDeg10;
+
+static bool active;
+static int32_t target;
+static int32_t integral;        // Q8 us * 10
+static int32_t lastErr;
+static uint32_t moveStartMs;
+static uint32_t inTolSinceMs;
+static int32_t moveDir;
+static int32_t overshoot;
+static bool settling;
+static uint8_t inTolFrames;
+static motion_done_cb doneCb;
+static void* doneArg;
+static feedback_stats stats;
+
+/* Private Function Definitions */
+static bool IRAM_ATTR onCapture(mcpwm_unit_t unit, mcpwm_capture_channel_id_t channel,
+                                const cap_event_data_t* edata, void* arg) {
+  portENTER_CRITICAL_ISR(&capMux);
+  if (edata->cap_edge == MCPWM_POS_EDGE) {
+    capPeriod = edata->cap_value - capRise;
+    capRise = edata->cap_value;
+  } else {
+    capHigh = edata->cap_value - capRise;
+    capEdgeUs = (uint32_t)esp_timer_get_time();
+  }
+  portEXIT_CRITICAL_ISR(&capMux);
+  return false;
+}
+
+// FUNCTION: Latest duty cycle as a single-turn angle (0..3599), false if the signal is lost
+static bool readRawAngle(int32_t* raw) {
+  portENTER_CRITICAL(&capMux);
+  uint32_t high = capHigh;
+  uint32_t period = capPeriod;
+  uint32_t edgeUs = capEdgeUs;
+  portEXIT_CRITICAL(&capMux);
+
+  if ((uint32_t)esp_timer_get_time() - edgeUs > FB_STALE_US) return false;
+  if (!period || high >= period) return false;
+
+  uint32_t duty = (uint32_t)(((uint64_t)high << 16) / period);
+  duty = constrain(duty, FB_DUTY_MIN_Q16, FB_DUTY_MAX_Q16);
+  *raw = (int32_t)(((duty - FB_DUTY_MIN_Q16) * 3600ULL) / (FB_DUTY_MAX_Q16 - FB_DUTY_MIN_Q16 + 1));
+  return true;
+}
+
+// FUNCTION: Signed correction (us from neutral) to a pulse, stepping over the dead band.
+// Call under fbMux: a release on the other core then cannot land between the tick's
+// check of active and its write.
+static void writeCorrection(int32_t u) {
+  const servo_cal& c = servoCalTable[fbServo.slot];
+  if (u > 0)      u += c.deadbandUs;
+  else if (u < 0) u -= c.deadbandUs;
+  int32_t us = constrain((int32_t)c.neutralUs + FB_DIRECTION * u, (int32_t)c.minUs, (int32_t)c.maxUs);
+  ledcWrite(SERVO_LEDC_FIRST_CHANNEL + fbServo.slot, servoUsToDuty((uint16_t)us));
+}
+
+static void finishMove(bool timedOut, motion_done_cb* cb, void** arg) {
+  if (timedOut) {
+    stats.timeouts++;
+  } else {
+    stats.lastSettleMs = inTolSinceMs - moveStartMs;
+    if (stats.lastSettleMs > stats.maxSettleMs) stats.maxSettleMs = stats.lastSettleMs;
+  }
+  stats.lastOvershootDeg10 = overshoot;
+  settling = false;
+  *cb = doneCb;
+  *arg = doneArg;
+  doneCb = NULL;
+}
+
+static void onFeedbackTick(void* arg) {
+  uint32_t nowMs = millis();
+  motion_done_cb cb = NULL;
+  void* cbArg = NULL;
+  int32_t raw;
+
+  // 1. Track the multi-turn angle, also while the loop is released
+  if (!readRawAngle(&raw)) {
+    portENTER_CRITICAL(&fbMux);
+    bool wasActive = active;
+    active = false;
+    if (wasActive) {
+      stats.sensorFaults++;
+      settling = false;
+      cb = doneCb;
+      cbArg = doneArg;
+      doneCb = NULL;
+      writeCorrection(0);
+    }
+    portEXIT_CRITICAL(&fbMux);
+    if (cb) cb(fbServo.pin, cbArg);
+    lastRaw = -1;
+    return;
+  }
+  if (lastRaw >= 0) {
+    int32_t d = raw - lastRaw;
+    if (d > 1800)       turns--;
+    else if (d < -1800) turns++;
+  }
+  lastRaw = raw;
+
+  // 2. PID on the angle error, integral frozen while saturated or inside tolerance
+  portENTER_CRITICAL(&fbMux);
+  angleDeg10 = turns * 3600 + raw;
+  int32_t u = 0;
+  if (active) {
+    int32_t err = target - angleDeg10;
+    int32_t absErr = (err < 0) ? -err : err;
+    const servo_cal& c = servoCalTable[fbServo.slot];
+    const int32_t uMax = (int32_t)min(c.maxUs - c.neutralUs, c.neutralUs - c.minUs) - c.deadbandUs;
+
+    if (absErr > FB_TOLERANCE_DEG10 / 2) {
+      int32_t p = FB_KP_Q8 * err;
+      int32_t d = FB_KD_Q8 * (err - lastErr);
+      u = (p + integral + d) / 2560;
+      if (u > uMax)       u = uMax;
+      else if (u < -uMax) u = -uMax;
+      else                integral += FB_KI_Q8 * err;
+    }
+    lastErr = err;
+
+    // 3. Settling metrics: overshoot past the target, time to stay inside tolerance
+    int32_t past = (angleDeg10 - target) * moveDir;
+    if (past > overshoot) overshoot = past;
+    if (settling) {
+      if (absErr <= FB_TOLERANCE_DEG10) {
+        if (!inTolFrames++) inTolSinceMs = nowMs;
+      } else {
+        inTolFrames = 0;
+      }
+      if (inTolFrames >= FB_SETTLE_FRAMES) {
+        finishMove(false, &cb, &cbArg);
+      } else if (nowMs - moveStartMs > FB_MOVE_TIMEOUT_MS) {
+        finishMove(true, &cb, &cbArg);   // Report once, keep trying to hold
+      }
+    }
+
+    // 4. Register write while still active, then notify outside the lock
+    writeCorrection(u);
+  }
+  portEXIT_CRITICAL(&fbMux);
+
+  if (cb) cb(fbServo.pin, cbArg);
+}
+
+/* Public Function Definitions */
+
+// FUNCTION: Capture the feedback duty on MCPWM0 CAP0 (both edges, 12.5 ns stamps)
+// and start the fixed-rate loop. The servo stays with the motion manager until a move.
+bool feedbackBegin(uint8_t fbPin, const feedback_servo* servo) {
+  if (fbTimer) return true;
+  fbServo = *servo;
+
+  if (mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM_CAP_0, fbPin) != ESP_OK) return false;
+  mcpwm_capture_config_t conf = {};
+  conf.cap_edge = MCPWM_BOTH_EDGE;
+  conf.cap_prescale = 1;
+  conf.capture_cb = onCapture;
+  conf.user_data = NULL;
+  if (mcpwm_capture_enable_channel(MCPWM_UNIT_0, MCPWM_SELECT_CAP0, &conf) != ESP_OK) return false;
+
+  esp_timer_create_args_t args = {};
+  args.callback = onFeedbackTick;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "servo_feedback";
+  if (esp_timer_create(&args, &fbTimer) != ESP_OK) return false;
+  return esp_timer_start_periodic(fbTimer, FB_LOOP_MS * 1000ULL) == ESP_OK;
+}
+
+bool feedbackMoveTo(int32_t targetDeg10, motion_done_cb cb, void* arg) {
+  if (!fbTimer || lastRaw < 0) return false;   // No signal, nothing to close the loop on
+  motionStop(fbServo.pin);
+
+  portENTER_CRITICAL(&fbMux);
+  target = targetDeg10;
+  integral = 0;
+  lastErr = target - angleDeg10;
+  moveDir = (lastErr < 0) ? -1 : 1;
+  overshoot = 0;
+  settling = true;
+  inTolFrames = 0;
+  moveStartMs = millis();
+  doneCb = cb;
+  doneArg = arg;
+  active = true;
+  stats.moves++;
+  portEXIT_CRITICAL(&fbMux);
+  return true;
+}
+
+bool feedbackMoveBy(int32_t deltaDeg10, motion_done_cb cb, void* arg) {
+  return feedbackMoveTo(feedbackAngle() + deltaDeg10, cb, arg);
+}
+
+void feedbackRelease() {
+  portENTER_CRITICAL(&fbMux);
+  bool wasActive = active;
+  active = false;
+  settling = false;
+  doneCb = NULL;
+  if (wasActive) writeCorrection(0);
+  portEXIT_CRITICAL(&fbMux);
+  if (wasActive) motionJump(fbServo.pin, servoCalTable[fbServo.slot].neutralUs);
+}
+
+bool feedbackActive() {
+  portENTER_CRITICAL(&fbMux);
+  bool a = active;
+  portEXIT_CRITICAL(&fbMux);
+  return a;
+}
+
+int32_t feedbackAngle() {
+  portENTER_CRITICAL(&fbMux);
+  int32_t a = angleDeg10;
+  portEXIT_CRITICAL(&fbMux);
+  return a;
+}
+
+void feedbackStats(feedback_stats* out) {
+  portENTER_CRITICAL(&fbMux);
+  *out = stats;
+  out->angleDeg10 = angleDeg10;
+  portEXIT_CRITICAL(&fbMux);
+}
@@ -0,0 +1,288 @@
+/* Servo Motion Manager Driver */
+
+/* Includes */
+#include <esp_timer.h>
+#include "servo_motion.h"
+
+/* Typedefs */
+typedef struct motion_cmd {
+  uint16_t targetUs;
+  uint16_t durationMs;    // TRAJ_LINEAR: move time, others: hold after arrival
+  traj_profile profile;
+  motion_done_cb cb;
+  void* arg;
+} motion_cmd;
+
+typedef struct motion_channel {
+  bool used;
+  uint8_t pin;
+  uint8_t ledcChannel;
+  uint16_t currentUs;
+  traj_limits limits;
+  // Active move
+  bool active;
+  bool dirty;             // Pulse changed since the last register write
+  uint32_t startMs;
+  uint32_t endMs;         // Relative to startMs: trajectory + hold
+  traj_state traj;
+  motion_cmd cmd;
+  // Pending moves (ring)
+  motion_cmd queue[MOTION_QUEUE_DEPTH];
+  uint8_t head;
+  uint8_t count;
+} motion_channel;
+
+/* Statics */
+static_assert(MOTION_MAX_CHANNELS == SERVO_MAX_CHANNELS, "One motion channel per LEDC slot");
+static motion_channel channels[MOTION_MAX_CHANNELS];
+static portMUX_TYPE motionMux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t motionTimer = NULL;
+
+/* Private Function Definitions */
+static motion_channel* channelForPin(uint8_t pin) {
+  for (uint8_t i = 0; i < MOTION_MAX_CHANNELS; ++i) {
+    if (channels[i].used && channels[i].pin == pin) return &channels[i];
+  }
+  return NULL;
+}
+
+static inline uint16_t angleToUs(int deg) {
+  return servoMapAngle(deg, SERVO_MIN_US, SERVO_MAX_US);
+}
+
+static uint32_t cmdDurationMs(const motion_cmd& cmd, uint16_t fromUs, const traj_limits* limits, traj_state* traj) {
+  trajPlan(traj, cmd.profile, fromUs, cmd.targetUs, limits, cmd.durationMs);
+  return trajDurationMs(traj) + ((cmd.profile == TRAJ_LINEAR) ? 0 : cmd.durationMs);
+}
+
+static bool enqueue(uint8_t pin, uint16_t targetUs, traj_profile profile, uint16_t durationMs,
+                    motion_done_cb cb, void* arg) {
+  motion_channel* ch = channelForPin(pin);
+  if (!ch) return false;
+
+  bool ok = false;
+  portENTER_CRITICAL(&motionMux);
+  if (ch->count < MOTION_QUEUE_DEPTH) {
+    motion_cmd& slot = ch->queue[(ch->head + ch->count) % MOTION_QUEUE_DEPTH];
+    slot.targetUs = constrain(targetUs, SERVO_CLAMP_MIN_US, SERVO_CLAMP_MAX_US);
+    slot.durationMs = durationMs;
+    slot.profile = profile;
+    slot.cb = cb;
+    slot.arg = arg;
+    ch->count++;
+    ok = true;
+  }
+  portEXIT_CRITICAL(&motionMux);
+  return ok;
+}
+
+static void onMotionTick(void* arg) {
+  motionTick(millis());
+}
+
+/* Public Function Definitions */
+
+// FUNCTION: Start the periodic motion tick (esp_timer task)
+bool motionBegin() {
+  esp_timer_create_args_t args = {};
+  args.callback = onMotionTick;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "servo_motion";
+  if (esp_timer_create(&args, &motionTimer) != ESP_OK) return false;
+  return esp_timer_start_periodic(motionTimer, MOTION_TICK_MS * 1000ULL) == ESP_OK;
+}
+
+// FUNCTION: Channels sit at their LEDC slot, so drivers that know the slot at compile
+// time reach theirs without a lookup (motionWriteSlot())
+bool motionAddChannel(uint8_t pin, uint16_t startUs) {
+  if (channelForPin(pin)) return true;
+  if (!servoAttach(pin)) return false;
+  uint8_t ledcChannel = servoChannel(pin);
+  motion_channel* ch = &channels[ledcChannel - SERVO_LEDC_FIRST_CHANNEL];
+  servoWriteUs(pin, startUs);
+  portENTER_CRITICAL(&motionMux);
+  *ch = motion_channel();
+  ch->pin = pin;
+  ch->ledcChannel = ledcChannel;
+  ch->currentUs = startUs;
+  ch->used = true;
+  portEXIT_CRITICAL(&motionMux);
+  return true;
+}
+
+// FUNCTION: Queue a move, returns false if the channel is unknown or its queue is full.
+// A move to the current position acts as a timed hold.
+bool motionMoveUs(uint8_t pin, uint16_t targetUs, uint16_t durationMs, motion_done_cb cb, void* arg) {
+  return enqueue(pin, targetUs, TRAJ_LINEAR, durationMs, cb, arg);
+}
+
+bool motionMoveAngle(uint8_t pin, int angleDeg, uint16_t durationMs, motion_done_cb cb, void* arg) {
+  return enqueue(pin, angleToUs(angleDeg), TRAJ_LINEAR, durationMs, cb, arg);
+}
+
+bool motionMoveProfile(uint8_t pin, uint16_t targetUs, traj_profile profile, uint16_t holdMs,
+                       motion_done_cb cb, void* arg) {
+  return enqueue(pin, targetUs, profile, holdMs, cb, arg);
+}
+
+bool motionMoveProfileAngle(uint8_t pin, int angleDeg, traj_profile profile, uint16_t holdMs,
+                            motion_done_cb cb, void* arg) {
+  return enqueue(pin, angleToUs(angleDeg), profile, holdMs, cb, arg);
+}
+
+void motionSetLimits(uint8_t pin, const traj_limits* limits) {
+  motion_channel* ch = channelForPin(pin);
+  if (!ch) return;
+  portENTER_CRITICAL(&motionMux);
+  ch->limits = *limits;
+  portEXIT_CRITICAL(&motionMux);
+}
+
+// FUNCTION: Remaining time of the active move plus every queued move, planned from
+// the previous move's target, so callers can schedule on it instead of fixed holds
+uint32_t motionEtaMs(uint8_t pin) {
+  motion_channel* ch = channelForPin(pin);
+  if (!ch) return 0;
+
+  uint32_t eta = 0;
+  traj_state traj;
+  portENTER_CRITICAL(&motionMux);
+  uint16_t fromUs = ch->currentUs;
+  if (ch->active) {
+    uint32_t elapsed = millis() - ch->startMs;
+    eta = (elapsed < ch->endMs) ? ch->endMs - elapsed : 0;
+    fromUs = ch->cmd.targetUs;
+  }
+  for (uint8_t i = 0; i < ch->count; ++i) {
+    const motion_cmd& cmd = ch->queue[(ch->head + i) % MOTION_QUEUE_DEPTH];
+    eta += cmdDurationMs(cmd, fromUs, &ch->limits, &traj);
+    fromUs = cmd.targetUs;
+  }
+  portEXIT_CRITICAL(&motionMux);
+  return eta;
+}
+
+void motionStop(uint8_t pin) {
+  motion_channel* ch = channelForPin(pin);
+  if (!ch) return;
+  portENTER_CRITICAL(&motionMux);
+  ch->active = false;
+  ch->count = 0;
+  portEXIT_CRITICAL(&motionMux);
+}
+
+// FUNCTION: Drop queued moves and take over a pulse the caller has already written,
+// so the next planned move starts from it
+void motionJump(uint8_t pin, uint16_t us) {
+  motion_channel* ch = channelForPin(pin);
+  if (!ch) return;
+  portENTER_CRITICAL(&motionMux);
+  ch->active = false;
+  ch->count = 0;
+  ch->currentUs = us;
+  ch->dirty = false;
+  portEXIT_CRITICAL(&motionMux);
+}
+
+// FUNCTION: Immediate pulse on a slot known at compile time. Drops queued moves and
+// writes the register under the lock the tick writes under, so no tick can land an
+// older sample after it.
+void motionWriteSlot(uint8_t slot, uint16_t us) {
+  if (slot >= MOTION_MAX_CHANNELS) return;
+  motion_channel* ch = &channels[slot];
+  uint32_t duty = servoUsToDuty(us);
+  portENTER_CRITICAL(&motionMux);
+  if (ch->used) {
+    ch->active = false;
+    ch->count = 0;
+    ch->currentUs = us;
+    ch->dirty = false;
+  }
+  ledcWrite(SERVO_LEDC_FIRST_CHANNEL + slot, duty);
+  portEXIT_CRITICAL(&motionMux);
+}
+
+bool motionBusy(uint8_t pin) {
+  motion_channel* ch = channelForPin(pin);
+  if (!ch) return false;
+  portENTER_CRITICAL(&motionMux);
+  bool busy = ch->active || ch->count;
+  portEXIT_CRITICAL(&motionMux);
+  return busy;
+}
+
+// FUNCTION: For latency sensitive callers (remote commands). If the channel is idle
+// with a move waiting, start it one tick in so the pulse changes right away, the
+// regular tick carries on from there. Returns true if the pulse was written.
+bool motionKick(uint8_t pin) {
+  motion_channel* ch = channelForPin(pin);
+  if (!ch) return false;
+
+  uint32_t nowMs = millis();
+  bool write = false;
+  uint16_t us = 0;
+  portENTER_CRITICAL(&motionMux);
+  if (!ch->active && ch->count) {
+    ch->cmd = ch->queue[ch->head];
+    ch->head = (ch->head + 1) % MOTION_QUEUE_DEPTH;
+    ch->count--;
+    ch->endMs = cmdDurationMs(ch->cmd, ch->currentUs, &ch->limits, &ch->traj);
+    ch->startMs = nowMs - MOTION_TICK_MS;
+    ch->active = true;
+    us = trajSample(&ch->traj, MOTION_TICK_MS);
+    write = (us != ch->currentUs);
+    ch->currentUs = us;
+    ch->dirty = false;
+    if (write) ledcWrite(ch->ledcChannel, servoUsToDuty(us));
+  }
+  portEXIT_CRITICAL(&motionMux);
+  return write;
+}
+
+// FUNCTION: Advance every channel by one tick, all from the same time base
+void motionTick(uint32_t nowMs) {
+  for (uint8_t i = 0; i < MOTION_MAX_CHANNELS; ++i) {
+    motion_channel* ch = &channels[i];
+    motion_done_cb doneCb = NULL;
+    void* doneArg = NULL;
+    uint16_t us;
+
+    portENTER_CRITICAL(&motionMux);
+    if (!ch->used) {
+      portEXIT_CRITICAL(&motionMux);
+      continue;
+    }
+
+    // 1. Start the next queued move
+    if (!ch->active && ch->count) {
+      ch->cmd = ch->queue[ch->head];
+      ch->head = (ch->head + 1) % MOTION_QUEUE_DEPTH;
+      ch->count--;
+      ch->endMs = cmdDurationMs(ch->cmd, ch->currentUs, &ch->limits, &ch->traj);
+      ch->startMs = nowMs;
+      ch->active = true;
+    }
+
+    // 2. Sample the trajectory, then hold until the move is done
+    if (ch->active) {
+      uint32_t elapsed = nowMs - ch->startMs;
+      uint16_t sample = trajSample(&ch->traj, elapsed);
+      ch->dirty = (sample != ch->currentUs);
+      ch->currentUs = sample;
+      if (elapsed >= ch->endMs) {
+        ch->active = false;
+        doneCb = ch->cmd.cb;
+        doneArg = ch->cmd.arg;
+      }
+    }
+    // 3. Register write only when the pulse changed (LEDC repeats it on its own), under
+    // the lock so it stays in order with motionWriteSlot(). Notify outside it.
+    us = ch->currentUs;
+    if (ch->dirty) ledcWrite(ch->ledcChannel, servoUsToDuty(us));
+    ch->dirty = false;
+    uint8_t pin = ch->pin;
+    portEXIT_CRITICAL(&motionMux);
+
+    if (doneCb) doneCb(pin, doneArg);
+  }
+}
@@ -3,15 +3,81 @@
 /* Includes */
 #include "servo_util.h"
 
+/* Statics */
+static uint8_t servoPins[SERVO_MAX_CHANNELS];
+static bool servoUsed[SERVO_MAX_CHANNELS];
+
+/* Private Function Definitions */
+static int servoChannelForPin(uint8_t pin) {
+  for (uint8_t i = 0; i < SERVO_MAX_CHANNELS; ++i) {
+    if (servoUsed[i] && servoPins[i] == pin) return i;
+  }
+  return -1;
+}
+
+static void servoSetupSlot(uint8_t pin, uint8_t i) {
+  uint8_t channel = SERVO_LEDC_FIRST_CHANNEL + i;
+  ledcSetup(channel, SERVO_LEDC_FREQ_HZ, SERVO_LEDC_BITS);
+  ledcAttachPin(pin, channel);
+  ledcWrite(channel, 0);   // No pulse until the first write
+  servoPins[i] = pin;
+  servoUsed[i] = true;
+}
+
 /* Public Function Definitions */
 // -----------------------------
-// Generic single-frame pulse (manual PWM)
+// LEDC backend: the peripheral repeats the pulse every frame,
+// a pulse width change is a single duty register write
+// -----------------------------
+bool servoAttach(uint8_t pin) {
+  if (servoChannelForPin(pin) >= 0) return true;
+  for (uint8_t i = 0; i < SERVO_MAX_CHANNELS; ++i) {
+    if (!servoUsed[i]) {
+      servoSetupSlot(pin, i);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Drivers that know their channel at compile time claim it up front,
+// so their output path is a write to a constant channel
+bool servoAttachSlot(uint8_t pin, uint8_t slot) {
+  if (slot >= SERVO_MAX_CHANNELS) return false;
+  if (servoUsed[slot]) return servoPins[slot] == pin;
+  if (servoChannelForPin(pin) >= 0) return false;
+  servoSetupSlot(pin, slot);
+  return true;
+}
+
+int servoChannel(uint8_t pin) {
+  int i = servoChannelForPin(pin);
+  return (i < 0) ? -1 : SERVO_LEDC_FIRST_CHANNEL + i;
+}
+
+void servoDetach(uint8_t pin) {
+  int i = servoChannelForPin(pin);
+  if (i < 0) return;
+  ledcWrite(SERVO_LEDC_FIRST_CHANNEL + i, 0);
+  ledcDetachPin(pin);
+  servoUsed[i] = false;
+}
+
+void servoWriteUs(uint8_t pin, uint16_t highUs) {
+  if (highUs < SERVO_CLAMP_MIN_US) highUs = SERVO_CLAMP_MIN_US;
+  if (highUs > SERVO_CLAMP_MAX_US) highUs = SERVO_CLAMP_MAX_US;
+  int i = servoChannelForPin(pin);
+  if (i < 0) {
+    if (!servoAttach(pin)) return;
+    i = servoChannelForPin(pin);
+  }
+  ledcWrite(SERVO_LEDC_FIRST_CHANNEL + i, servoUsToDuty(highUs));
+}
+
+// -----------------------------
+// Set the pulse and let one frame go out (yields, no busy wait)
 // -----------------------------
 void servoOneFrameWriteUs(uint8_t pin, uint16_t highUs) {
-  if (highUs < 400)  highUs = 400;
-  if (highUs > 2700) highUs = 2700;
+  servoWriteUs(pin, highUs);
   delay(SERVO_FRAME_MS);
-  digitalWrite(pin, HIGH);
-  delayMicroseconds(highUs);
-  digitalWrite(pin, LOW);
 }
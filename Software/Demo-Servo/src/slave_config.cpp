@@ -1,7 +1,10 @@
 /* Slave Config Driver */
 
 /* Includes */
+#include "hal.h"
 #include "slave_config.h"
+#include "servo_remote.h"
+#include "print_queue.h"
 
 
 /* Statics */
@@ -12,9 +15,6 @@ char outgoingMsg[32] = "Hello ESP-NOW";  // Default message - Modify with new me
 // Master's MAC address
 uint8_t masterMAC[] = {0x88, 0x13, 0xBF, 0x0B, 0xC4, 0x58};
 
-QueueHandle_t printQueue;
-const int PRINT_BUFFER_SIZE = 128;
-
 /**
  * @brief WIFI MESSAGE PROTOCOL
  * 
@@ -25,19 +25,19 @@ const int PRINT_BUFFER_SIZE = 128;
  * 
  */
 
+servo_remote stationRemote;
+
 // Task handles
 TaskHandle_t TaskWiFiHandle = NULL;
-TaskHandle_t TaskPrintHandle = NULL;
-
-// Print queue and buffer
-#define PRINT_BUFFER_SIZE   (128)
-#define PRINT_BUFFER_COUNT  (10)
 
 /* Private Function Definitions */
 
 
 // Callback when data is received
 void OnDataRecv(const uint8_t* mac, const uint8_t* incomingDataPtr, int len) {
+  // Servo commands go to the remote task, acked from there
+  if (remoteOnRecv(&stationRemote, mac, incomingDataPtr, len)) return;
+
   memcpy(&incomingData, incomingDataPtr, sizeof(incomingData));
 
   char macStr[18];
@@ -66,16 +66,6 @@ void OnDataSent(const uint8_t* mac_addr, esp_now_send_status_t status) {
   //              status == ESP_NOW_SEND_SUCCESS ? "Success" : "Fail");
 }
 
-// FUNCTION: Prints strings from global queue
-void printTask(void* parameter) {
-  char localBuffer[PRINT_BUFFER_SIZE];
-  while (true) {
-    if (xQueueReceive(printQueue, localBuffer, portMAX_DELAY)) {
-      Serial.print(localBuffer);
-    }
-  }
-}
-
 // FUNCTION: ESP-NOW WiFi task
 void wifiTask(void* parameter) {
   enqueuePrint("WiFi Task started on core: %d\n", xPortGetCoreID());
@@ -121,28 +111,7 @@ void wifiTask(void* parameter) {
 
 /* Public Function Definitions */
 
-// FUNCTION: Sends strings to global queue
-void enqueuePrint(const char* fmt, ...) {
-  char tempBuf[PRINT_BUFFER_SIZE];
-  va_list args;
-  va_start(args, fmt);
-  vsnprintf(tempBuf, PRINT_BUFFER_SIZE, fmt, args);
-  va_end(args);
-  xQueueSend(printQueue, tempBuf, 10 / portTICK_PERIOD_MS);
-}
-
 void startSlave() {
-  
-  // Create a print queue
-  printQueue = xQueueCreate(10, PRINT_BUFFER_SIZE);
-  if (printQueue == NULL) {
-    Serial.println("Failed to create print queue");
-    while (1);
-  }
-
-  // Start printing task
-  xTaskCreatePinnedToCore(printTask, "Print Task", 4096, NULL, 1, NULL, 0);
-
   WiFi.mode(WIFI_STA);
   WiFi.disconnect();
 
@@ -166,5 +135,8 @@ void startSlave() {
     }
   }
 
-  enqueuePrint("Slave ready. Waiting for data...");
+  uint8_t mac[6];
+  halRadioMac(mac);
+  enqueuePrint("Slave ready (MAC %02X:%02X:%02X:%02X:%02X:%02X). Waiting for data...\n",
+               mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 }
\ No newline at end of file
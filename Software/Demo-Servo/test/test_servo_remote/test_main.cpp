@@ -0,0 +1,127 @@
+/* Servo Remote Tests
+ *
+ * Native (pio test -e native): the station's remote command path against the lib/Hal
+ * fakes. The remote task does not run natively, the tests call remoteService().
+ */
+
+/* Includes */
+#include <string.h>
+#include <unity.h>
+#include "hal.h"
+#include "servo_link.h"
+#include "servo_remote.h"
+
+/* Constants */
+const uint8_t chefMac[6]    = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+const uint8_t stationMac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+/* Statics */
+static servo_remote remote;
+static uint32_t execs = 0;
+static remote_done_fn doneCb = NULL;
+static void* doneArg = NULL;
+static uint32_t acks = 0, dones = 0;
+static link_report lastReport;
+static uint16_t seq = 0;
+
+/* Private Function Definitions */
+// FUNCTION: Stand-in motion layer, TOP and BOTTOM only, the test finishes the move
+static link_status testExec(uint8_t op, uint8_t servo, int16_t arg,
+                            remote_done_fn cb, void* cbArg, uint8_t* pin) {
+  if (servo != LINK_SERVO_TOP && servo != LINK_SERVO_BOTTOM) return LINK_BAD_SERVO;
+  execs++;
+  doneCb = cb;
+  doneArg = cbArg;
+  *pin = (servo == LINK_SERVO_TOP) ? 25 : 26;
+  return LINK_OK;
+}
+
+static void onAir(const uint8_t* dst, const uint8_t* data, int len) {
+  if (memcmp(dst, chefMac, 6) != 0 || !linkIsReport(data, len)) return;
+  memcpy(&lastReport, data, sizeof(lastReport));
+  if (lastReport.op == LINK_OP_ACK) acks++;
+  else if (lastReport.op == LINK_OP_DONE) dones++;
+}
+
+static link_cmd makeCmd(uint8_t op, uint8_t servos) {
+  link_cmd cmd = {};
+  cmd.magic = LINK_MAGIC;
+  cmd.op = op;
+  cmd.seq = ++seq;
+  cmd.servos = servos;
+  return cmd;
+}
+
+static void deliver(const link_cmd& cmd) {
+  TEST_ASSERT_TRUE(remoteOnRecv(&remote, chefMac, (const uint8_t*)&cmd, sizeof(cmd)));
+  remoteService(&remote);
+}
+
+/* Public Function Definitions */
+void setUp() {
+  execs = acks = dones = 0;
+  doneCb = NULL;
+}
+
+void tearDown() { }
+
+void test_command_runs_and_acks() {
+  link_cmd cmd = makeCmd(LINK_OP_OPEN, LINK_SERVO_TOP);
+  deliver(cmd);
+  TEST_ASSERT_EQUAL_UINT32(1, execs);
+  TEST_ASSERT_EQUAL_UINT32(1, acks);
+  TEST_ASSERT_EQUAL_UINT16(cmd.seq, lastReport.seq);
+  TEST_ASSERT_EQUAL_UINT8(LINK_SERVO_TOP, lastReport.servos);
+  TEST_ASSERT_EQUAL_UINT8(LINK_OK, lastReport.status);
+
+  TEST_ASSERT_NOT_NULL(doneCb);
+  doneCb(25, doneArg);
+  remoteService(&remote);
+  TEST_ASSERT_EQUAL_UINT32(1, dones);
+  TEST_ASSERT_EQUAL_UINT8(LINK_OP_DONE, lastReport.op);
+  TEST_ASSERT_EQUAL_UINT16(cmd.seq, lastReport.seq);
+}
+
+void test_resend_answered_not_run() {
+  link_cmd cmd = makeCmd(LINK_OP_CLOSE, LINK_SERVO_TOP | LINK_SERVO_BOTTOM);
+  deliver(cmd);
+  deliver(cmd);
+  TEST_ASSERT_EQUAL_UINT32(2, execs);     // Once per servo, not again
+  TEST_ASSERT_EQUAL_UINT32(2, acks);
+  TEST_ASSERT_EQUAL_UINT8(LINK_SERVO_TOP | LINK_SERVO_BOTTOM, lastReport.servos);
+}
+
+// Several in flight: the ACK of an older one was lost, its resend must not run again
+void test_older_resend_answered_not_run() {
+  link_cmd first = makeCmd(LINK_OP_BOUNCE, LINK_SERVO_TOP);
+  deliver(first);
+  for (uint8_t i = 1; i < LINK_MAX_PENDING; ++i) deliver(makeCmd(LINK_OP_PING, LINK_SERVO_TOP));
+  uint32_t ran = execs;
+  deliver(first);
+  TEST_ASSERT_EQUAL_UINT32(ran, execs);
+  TEST_ASSERT_EQUAL_UINT16(first.seq, lastReport.seq);
+
+  remote_stats st;
+  remoteStats(&remote, &st);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, st.duplicates);
+}
+
+void test_unknown_servo_rejected() {
+  deliver(makeCmd(LINK_OP_OPEN, LINK_SERVO_PARALLAX));
+  TEST_ASSERT_EQUAL_UINT32(0, execs);
+  TEST_ASSERT_EQUAL_UINT8(LINK_BAD_SERVO, lastReport.status);
+  TEST_ASSERT_EQUAL_UINT8(0, lastReport.servos);
+}
+
+int main(int argc, char** argv) {
+  halFakeSetMac(stationMac);
+  halFakeRadioSetTx(onAir);
+  remoteBegin(&remote, testExec, NULL);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_command_runs_and_acks);
+  RUN_TEST(test_resend_answered_not_run);
+  RUN_TEST(test_older_resend_answered_not_run);
+  RUN_TEST(test_unknown_servo_rejected);
+  return UNITY_END();
+}
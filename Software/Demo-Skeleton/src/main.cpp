@@ -1,4 +1,4 @@
-#include <Arduino.h>
+#include "hal.h"
 
 // put function declarations here:
 int myFunction(int, int);
@@ -6,21 +6,22 @@ int myFunction(int, int);
 void setup() {
   // put your setup code here, to run once:
   int result = myFunction(2, 3);
-  pinMode(4, INPUT); // D2
-  Serial.begin(9600);
-  while(!Serial);
+  halPinInput(4, false); // D2
+  halPinOutput(18);
+  halConsoleBegin(9600);
+  halHeapMark();   // loop() should not allocate, halHeapSinceMark() says if it does
 }
 
 void loop() {
   // put your main code here, to run repeatedly:
-  digitalWrite(18, LOW);
-  delay(1000);
-  digitalWrite(18, HIGH);
-  delay(1000);
-  Serial.println("Hello!");
+  halPinWrite(18, false);
+  halDelayMs(1000);
+  halPinWrite(18, true);
+  halDelayMs(1000);
+  halPrint("Hello!\n");
 }
 
 // put function definitions here:
 int myFunction(int x, int y) {
   return x + y;
-}
\ No newline at end of file
+}
@@ -0,0 +1,108 @@
+/* HAL Fake Tests
+ *
+ * Native (pio test -e native): the lib/Hal fakes every host build and test stands on.
+ * Virtual clock, timers in deadline order, queues, pins and the heap counter.
+ */
+
+/* Includes */
+#include <stdlib.h>
+#include <unity.h>
+#include "hal.h"
+
+/* Statics */
+static hal_timer periodic, once;
+static uint32_t firedAtUs[8];
+static uint8_t fired = 0;
+static char firedName[8];
+
+/* Private Function Definitions */
+static void onTimer(void* arg) {
+  if (fired < sizeof(firedAtUs) / sizeof(firedAtUs[0])) {
+    firedAtUs[fired] = halMicros();
+    firedName[fired] = *(const char*)arg;
+    fired++;
+  }
+}
+
+/* Public Function Definitions */
+void setUp() {
+  fired = 0;
+}
+
+void tearDown() {
+  halTimerStop(periodic);
+  halTimerStop(once);
+}
+
+void test_clock_moves_only_when_told() {
+  uint32_t t0 = halMicros();
+  TEST_ASSERT_EQUAL_UINT32(t0, halMicros());
+  halDelayMs(5);
+  TEST_ASSERT_EQUAL_UINT32(t0 + 5000, halMicros());
+  halFakeAdvanceUs(250);
+  TEST_ASSERT_EQUAL_UINT32(t0 + 5250, halMicros());
+}
+
+void test_timers_fire_in_deadline_order() {
+  uint32_t t0 = halMicros();
+  TEST_ASSERT_TRUE(halTimerStartPeriodic(periodic, 1000));
+  TEST_ASSERT_TRUE(halTimerStartOnce(once, 1500));
+  halFakeAdvanceUs(3000);
+  TEST_ASSERT_EQUAL(4, fired);
+  TEST_ASSERT_EQUAL('p', firedName[0]);
+  TEST_ASSERT_EQUAL_UINT32(t0 + 1000, firedAtUs[0]);
+  TEST_ASSERT_EQUAL('o', firedName[1]);
+  TEST_ASSERT_EQUAL_UINT32(t0 + 1500, firedAtUs[1]);   // Each sees its own deadline
+  TEST_ASSERT_EQUAL_UINT32(t0 + 2000, firedAtUs[2]);
+  TEST_ASSERT_EQUAL_UINT32(t0 + 3000, firedAtUs[3]);
+  TEST_ASSERT_FALSE(halTimerStartPeriodic(periodic, 1000));   // Already armed
+}
+
+void test_queue_fifo_and_full() {
+  hal_queue q;
+  uint32_t storage[3];
+  TEST_ASSERT_TRUE(halQueueInit(&q, storage, sizeof(uint32_t), 3));
+  for (uint32_t v = 1; v <= 3; ++v) TEST_ASSERT_TRUE(halQueueSend(&q, &v));
+  uint32_t extra = 4;
+  TEST_ASSERT_FALSE(halQueueSend(&q, &extra));
+  uint32_t out;
+  for (uint32_t v = 1; v <= 3; ++v) {
+    TEST_ASSERT_TRUE(halQueueReceive(&q, &out));
+    TEST_ASSERT_EQUAL_UINT32(v, out);
+  }
+  TEST_ASSERT_FALSE(halQueueReceive(&q, &out));
+}
+
+void test_pins_and_pwm() {
+  halPinInput(4, true);
+  TEST_ASSERT_TRUE(halPinRead(4));
+  halFakePinSet(4, false);
+  TEST_ASSERT_FALSE(halPinRead(4));
+  TEST_ASSERT_TRUE(halPwmSetup(2, 5000, 12));
+  halPwmWrite(2, 1234);
+  TEST_ASSERT_EQUAL_UINT32(1234, halPwmRead(2));
+}
+
+void test_heap_counters_see_malloc_and_free() {
+  halHeapMark();
+  TEST_ASSERT_EQUAL_UINT32(0, halHeapSinceMark());
+  void* volatile p = malloc(32);
+  TEST_ASSERT_EQUAL_INT32(1, halHeapBlocksSinceMark());
+  free(p);
+  TEST_ASSERT_EQUAL_UINT32(1, halHeapSinceMark());
+  TEST_ASSERT_EQUAL_INT32(0, halHeapBlocksSinceMark());   // Held blocks are back where they were
+}
+
+int main(int argc, char** argv) {
+  static const char p = 'p', o = 'o';
+  halTimerCreate(onTimer, (void*)&p, "periodic", &periodic);
+  halTimerCreate(onTimer, (void*)&o, "once", &once);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_clock_moves_only_when_told);
+  RUN_TEST(test_timers_fire_in_deadline_order);
+  RUN_TEST(test_queue_fifo_and_full);
+  RUN_TEST(test_pins_and_pwm);
+  RUN_TEST(test_heap_counters_see_malloc_and_free);
+  return UNITY_END();
+}